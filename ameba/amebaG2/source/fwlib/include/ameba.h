@@ -37,6 +37,7 @@
 #include "ameba_spinand.h"
 #include "ameba_data_flash.h"
 #include "ameba_data_nand_flash.h"
+#include "ameba_nand_ftl.h"
 #include "ameba_backup_reg.h"
 #include "ameba_pinmap.h"
 #include "ameba_ipc.h"
@@ -63,7 +64,9 @@
 #include "ameba_ledc_pro.h"
 #include "ameba_phy.h"
 #include "ameba_ethernet.h"
+#include "ameba_eth_link.h"
 #include "ameba_uvc.h"
+#include "ameba_uvc_stream.h"
 #include "ameba_ppe.h"
 
 #ifndef CONFIG_BUILD_ROM
@@ -76,6 +79,9 @@
 #include "ameba_trustzone.h"
 #include "ameba_gdma.h"
 #include "ameba_pwmtimer.h"
+#include "ameba_tim_wheel.h"
+#include "ameba_pwm_seq.h"
+#include "ameba_pseudo_i2c_batch.h"
 #include "ameba_ups.h"
 #include "ameba_gpio.h"
 #include "ameba_spi.h"
@@ -84,12 +90,15 @@
 #include "ameba_sd.h"
 #include "ameba_adc.h"
 #include "ameba_captouch.h"
+#include "ameba_captouch_pipe.h"
 #include "ameba_wdg.h"
 #include "ameba_rtc.h"
 #include "ameba_osc131k.h"
 #include "ameba_delay.h"
 #include "ameba_ir.h"
+#include "ameba_ir_codec.h"
 #include "ameba_lcdc.h"
+#include "ameba_lcdc_fb.h"
 #include "ameba_audio.h"
 #include "ameba_sport.h"
 #include "ameba_debugtimer.h"
@@ -100,6 +109,7 @@
 #include "ameba_a2c.h"
 #include "ameba_pmctimer.h"
 #include "ameba_thermal.h"
+#include "ameba_thermal_gov.h"
 
 #include "ameba_rcc.h"
 #include "ameba_usrcfg.h"
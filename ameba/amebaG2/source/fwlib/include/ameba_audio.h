@@ -835,6 +835,9 @@ typedef struct {
 
 /**
  * @brief AUDIO_CODEC EQ Filter coefficients Structure Definition
+ * @note  Each band is H(z) = (h0 + b1*z^-1 + b2*z^-2) / (1 - a1*z^-1 - a2*z^-2) with
+ *        CONFIG_AMEBA_CODEC_EQ_FEEDBACK_ADD, (1 + a1*z^-1 + a2*z^-2) without. The register
+ *        spec gives only the format: 2's complement in 4.25, as in CODEC_ADC_x_BIQUAD_x.
  */
 typedef struct {
 	u32 H0_Q;
@@ -1038,10 +1041,35 @@ typedef struct {
 								((SEL) == ADCEQBD2) || \
 								((SEL) == ADCEQBD3)|| \
 								((SEL) == ADCEQBD4))
+#define CODEC_EQ_BAND_NUM					5
 /**
 * @}
 */
 
+/** @defgroup AUDIO_CODEC_EQ_Filter_Type
+  * @{
+  */
+#define CODEC_EQ_LOWPASS					((u32)0x00000000)
+#define CODEC_EQ_HIGHPASS					((u32)0x00000001)
+#define CODEC_EQ_BANDPASS					((u32)0x00000002)	/*!< 0dB peak gain */
+#define CODEC_EQ_NOTCH						((u32)0x00000003)
+#define CODEC_EQ_PEAK						((u32)0x00000004)
+#define CODEC_EQ_LOWSHELF					((u32)0x00000005)
+#define CODEC_EQ_HIGHSHELF					((u32)0x00000006)
+/**
+  * @}
+  */
+
+/** @defgroup AUDIO_CODEC_EQ_Load_Mode
+  * @{
+  */
+#define CODEC_EQ_LOAD_BYPASS				((u32)0x00000000)	/*!< each changed band is bypassed while written */
+#define CODEC_EQ_LOAD_MUTE					((u32)0x00000001)	/*!< ADC muted at a zero crossing while all bands are written */
+#define CODEC_EQ_MUTE_SAMPLES				256					/*!< wait for the zero detection mute and unmute */
+/**
+  * @}
+  */
+
 /** @defgroup AUDIO_CODEC_Sample_Rate_Source
   * @{
   */
@@ -1137,6 +1165,34 @@ typedef struct {
   * @}
   */
 
+/* Exported types ------------------------------------------------------------*/
+/** @defgroup AUDIO_CODEC_EQ_Exported_Types AUDIO_CODEC EQ Exported Types
+  * @{
+  */
+/**
+ * @brief AUDIO_CODEC EQ band design parameters
+ */
+typedef struct {
+	u32 Type;							/*!< @ref AUDIO_CODEC_EQ_Filter_Type */
+	u32 Fc;								/*!< corner or center frequency in Hz, below half the sample rate */
+	float Q;
+	float GainDb;						/*!< peak and shelf types only */
+} CODEC_EQBandParam;
+
+/**
+ * @brief AUDIO_CODEC EQ preset, the designed coefficients are cached in the preset
+ */
+typedef struct {
+	u32 SampleRate;						/*!< ADC sample rate in Hz */
+	u32 BandMask;						/*!< bit n enables band n */
+	CODEC_EQBandParam Band[CODEC_EQ_BAND_NUM];
+	CODEC_EQFilterCoef Coef[CODEC_EQ_BAND_NUM];	/*!< filled by AUDIO_CODEC_EQPresetBuild() */
+	u32 Built;							/*!< Coef is up to date, clear it after changing Band */
+} CODEC_EQPreset;
+/**
+  * @}
+  */
+
 /* Exported functions ------------------------------------------------------------*/
 /** @defgroup AUDIO_CODEC_Exported_Functions AUDIO_CODEC Exported Functions
   * @{
@@ -1166,6 +1222,9 @@ _LONG_CALL_ void AUDIO_CODEC_SetADCZDETTimeOut(u32 adc_sel, u32 time_out);
 _LONG_CALL_ void AUDIO_CODEC_Record(u32 i2s_sel, u32 type, I2S_InitTypeDef *I2S_InitStruct);
 _LONG_CALL_ void AUDIO_CODEC_EnableADCFifo(u32 ad_chn, u32 newstate);
 _LONG_CALL_ void AUDIO_CODEC_EnableADCFifoForMask(u32 ad_chn_mask);
+int AUDIO_CODEC_EQDesign(CODEC_EQBandParam *Param, u32 SampleRate, CODEC_EQFilterCoef *Coef);
+int AUDIO_CODEC_EQPresetBuild(CODEC_EQPreset *Preset);
+int AUDIO_CODEC_EQPresetLoad(u32 ad_chn, CODEC_EQPreset *Preset, u32 Mode);
 
 /**
   * @}
@@ -80,6 +80,7 @@ typedef struct {
   * @{
   */
 
+bool Audio_Clock_NiMiGet(u32 clock, u32 sr, u32 chn_len, u32 chn_cnt, u32 *ni, u32 *mi);
 bool is_sport_ni_mi_supported(u32 clock, u32 sr, u32 chn_len, u32 chn_cnt);
 void Audio_Clock_Choose(u32 clock_sel, AUDIO_InitParams *initparams, AUDIO_ClockParams *params);
 /**
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _AMEBA_CAPTOUCH_PIPE_H_
+#define _AMEBA_CAPTOUCH_PIPE_H_
+
+/** @addtogroup Ameba_Periph_Driver
+  * @{
+  */
+
+/** @defgroup CT_PIPE
+  * @brief CT_PIPE driver modules
+  * @verbatim
+  *****************************************************************************************
+  * Introduction
+  *****************************************************************************************
+  * Interrupt driven acquisition and software processing on top of the CAPTOUCH driver:
+  *		- the scan end interrupt snapshots the average data of all enabled channels into a
+  *		  caller provided ring, so no channel is polled from a task
+  *		- per channel baseline tracking in Q8 fixed point: the baseline follows slow drift
+  *		  while the channel is released, and is re-seeded when the data stays above it
+  *		  (touched at power on) or a touch is held longer than CT_PipeStuckScans
+  *		- per channel noise estimation (mean absolute deviation of released data), used to
+  *		  retune the hardware difference and environmental noise thresholds
+  *		- slider or wheel position by centroid interpolation of the strongest channel and
+  *		  its neighbours, with swipe detection on release
+  *
+  * Touch signal is baseline - average data, the data drops when a finger is present.
+  *
+  *****************************************************************************************
+  * How to use
+  *****************************************************************************************
+  *		1. Initialize the CAPTOUCH by CapTouch_Init() and enable it by CapTouch_Cmd().
+  *		2. Fill a CT_PIPE_InitTypeDef by CT_PIPE_StructInit(), set the ring buffer,
+  *		   channel mask and slider channels, and call CT_PIPE_Init().
+  *		3. Call CT_PIPE_IRQHandler() from the CAPTOUCH interrupt handler.
+  *		4. Call CT_PIPE_Process() from a task, events are reported by CT_PipeEventCb.
+  *		5. Call CT_PIPE_AutoTune() once the noise estimate settled (e.g. after a few
+  *		   hundred scans) and after the environment changed.
+  *
+  *****************************************************************************************
+  * @endverbatim
+  * @{
+  */
+
+/* Exported constants --------------------------------------------------------*/
+/** @defgroup CT_PIPE_Exported_Constants CT_PIPE Exported Constants
+  * @{
+  */
+
+/** @defgroup CT_PIPE_Event
+  * @{
+  */
+#define CT_PIPE_EVT_PRESS			((u8)0x01)	/*!< Arg: channel */
+#define CT_PIPE_EVT_RELEASE			((u8)0x02)	/*!< Arg: channel */
+#define CT_PIPE_EVT_SLIDE			((u8)0x03)	/*!< Arg: slider position */
+#define CT_PIPE_EVT_SWIPE_UP		((u8)0x04)	/*!< Arg: travel, towards the last slider channel */
+#define CT_PIPE_EVT_SWIPE_DOWN		((u8)0x05)	/*!< Arg: travel, towards the first slider channel */
+/** @} */
+
+/** @defgroup CT_PIPE_Slider_Type
+  * @{
+  */
+#define CT_PIPE_SLIDER_LINEAR		(0)
+#define CT_PIPE_SLIDER_WHEEL		(1)
+/** @} */
+
+#define CT_PIPE_SLIDER_MAX			CT_CHANNEL_NUM
+#define CT_PIPE_SLIDER_STEP			256U		/*!< position units between two slider channels */
+#define CT_PIPE_POS_NONE			0xFFFFU
+#define CT_PIPE_Q					8			/*!< fraction bits of baseline and noise */
+
+/** @} */
+
+/* Exported types ------------------------------------------------------------*/
+/** @defgroup CT_PIPE_Exported_Types CT_PIPE Exported Types
+  * @{
+  */
+
+/**
+  * @brief  CT_PIPE scan snapshot
+  */
+typedef struct {
+	u32 TimeUs;					/*!< scan end interrupt timestamp */
+	u16 Data[CT_CHANNEL_NUM];	/*!< average data, only channels in CT_PipeChMask are valid */
+	u16 Rsvd;
+} CT_PIPE_Frame;
+
+/**
+  * @brief  CT_PIPE per channel state
+  */
+typedef struct {
+	u32 Baseline;				/*!< Q8 */
+	u32 Noise;					/*!< Q8 mean absolute deviation */
+	u32 Peak;					/*!< largest signal seen in the last touch */
+	u32 CrossTime;				/*!< timestamp of the scan that first crossed the threshold */
+	s32 Signal;					/*!< baseline - data of the last scan */
+	u16 Thres;					/*!< software touch threshold */
+	u8 Touched;
+	u8 Debounce;				/*!< consecutive scans against the current state */
+	u16 Above;					/*!< consecutive scans with data above the baseline */
+	u16 HeldScans;				/*!< scans since the touch was reported */
+} CT_PIPE_ChState;
+
+/**
+  * @brief  CT_PIPE statistics
+  */
+typedef struct {
+	u32 Scans;					/*!< snapshots taken by the ISR */
+	u32 Overruns;				/*!< snapshots lost because the ring was full */
+	u32 Processed;				/*!< snapshots consumed by CT_PIPE_Process */
+	u32 Presses;
+	u32 Releases;
+	u32 Reseeds;				/*!< baselines re-seeded after an anti-touch or stuck touch */
+	u32 Retunes;				/*!< CT_PIPE_AutoTune runs */
+	u32 LatencyMaxUs;			/*!< scan end to processing, worst case */
+	u32 DetectMaxUs;			/*!< scan end to press event, worst case */
+} CT_PIPE_StatsTypeDef;
+
+/**
+  * @brief  CT_PIPE init structure definition
+  */
+typedef struct {
+	CAPTOUCH_TypeDef *CapTouch;
+	u32 CT_PipeChMask;			/*!< channels to track, bit n for channel n */
+	CT_PIPE_Frame *CT_PipeRing;	/*!< snapshot ring */
+	u32 CT_PipeRingNum;			/*!< ring entries, power of 2 */
+	u32 CT_PipeDriftShift;		/*!< baseline follows 1/2^n of the error per released scan */
+	u32 CT_PipeNoiseShift;		/*!< noise estimate follows 1/2^n of the deviation per scan */
+	u32 CT_PipeDebounce;		/*!< scans a state change must persist */
+	u32 CT_PipeHystPercent;		/*!< release below this percentage of the threshold */
+	u32 CT_PipeStuckScans;		/*!< a touch held this long is taken as drift, 0 to disable */
+	u32 CT_PipeReseedScans;		/*!< data above the baseline this long re-seeds it */
+	u32 CT_PipeSNR;				/*!< minimum threshold as multiple of the noise */
+	u32 CT_PipeThresPercent;	/*!< threshold as percentage of the measured touch peak */
+	u32 CT_PipeEtcNoiseMul;		/*!< hardware environmental noise threshold as multiple of the noise */
+	u8 CT_PipeSliderCh[CT_PIPE_SLIDER_MAX];	/*!< slider channels in physical order */
+	u32 CT_PipeSliderNum;		/*!< 0 if no slider, else 2 ~ CT_PIPE_SLIDER_MAX */
+	u32 CT_PipeSliderType;		/*!< @ref CT_PIPE_Slider_Type */
+	u32 CT_PipeSwipeDist;		/*!< slider travel reported as swipe, in position units */
+	u32 CT_PipeSwipeTimeUs;		/*!< maximum duration of a swipe */
+	void (*CT_PipeEventCb)(void *Data, u8 Event, u32 Arg);	/*!< called in CT_PIPE_Process context */
+	void *CT_PipeCbData;
+} CT_PIPE_InitTypeDef;
+
+/**
+  * @brief  CT_PIPE instance
+  */
+typedef struct {
+	CT_PIPE_InitTypeDef Cfg;
+	volatile u32 Head;			/*!< written by the ISR */
+	volatile u32 Tail;			/*!< written by CT_PIPE_Process */
+	CT_PIPE_ChState Ch[CT_CHANNEL_NUM];
+	u32 TouchMask;
+	u16 SliderPos;				/*!< CT_PIPE_POS_NONE when the slider is released */
+	u16 SwipeStart;
+	u32 SwipeTime;
+	CT_PIPE_StatsTypeDef Stats;
+} CT_PIPE_TypeDef;
+
+/** @} */
+
+/* Exported functions --------------------------------------------------------*/
+/** @defgroup CT_PIPE_Exported_Functions CT_PIPE Exported Functions
+  * @{
+  */
+void CT_PIPE_StructInit(CT_PIPE_InitTypeDef *CT_PipeInitStruct);
+int CT_PIPE_Init(CT_PIPE_TypeDef *pipe, CT_PIPE_InitTypeDef *CT_PipeInitStruct);
+u32 CT_PIPE_IRQHandler(CT_PIPE_TypeDef *pipe);
+u32 CT_PIPE_Process(CT_PIPE_TypeDef *pipe);
+void CT_PIPE_AutoTune(CT_PIPE_TypeDef *pipe);
+u32 CT_PIPE_GetTouchMask(CT_PIPE_TypeDef *pipe);
+u32 CT_PIPE_GetSliderPos(CT_PIPE_TypeDef *pipe);
+u32 CT_PIPE_GetNoise(CT_PIPE_TypeDef *pipe, u8 Channel);
+void CT_PIPE_GetStats(CT_PIPE_TypeDef *pipe, CT_PIPE_StatsTypeDef *Stats);
+/** @} */
+
+/** @} */
+
+/** @} */
+
+#endif
@@ -47,6 +47,19 @@
   *	-Internal 32K: 32K clock from internal 32K source: NCO32K
   *
   *****************************************************************************************
+  * OSC131K/OSC4M tracking
+  *****************************************************************************************
+  *	-OSC131K_Calibration() and OSC4M_Calibration() trim the OSC once at boot, OSC_CAL
+  *	 keeps the 131K RCAL or 4M FREQ_R_SEL trim right while the temperature drifts
+  *	-the temperature is read from the thermal meter (CONFIG_TEMP_AMEBA, otherwise a single
+  *	 band is used), the trim code is cached per temperature band, entering a band with a
+  *	 cached code applies it at once
+  *	-otherwise OSC_CAL_Process() moves the trim code one step per call towards the
+  *	 target, the OSC settles between two calls and the frequency counter is polled, not
+  *	 waited for, so it can run from an idle hook
+  *	-the frequency error of the last measurement is kept in ppm
+  *
+  *****************************************************************************************
   * @endverbatim
   */
 
@@ -99,6 +112,16 @@
   * @}
   */
 
+/** @defgroup OSC_CAL_definitions
+  * @{
+  */
+#define OSC_CAL_BAND_NUM		16
+#define OSC_CAL_CODE_NONE		0xFF	/*!< no cached trim code for the band */
+#define OSC_CAL_SAMPLE_MAX		16
+/**
+  * @}
+  */
+
 /** @defgroup XTAL_MODE_SEL_definitions
   * @{
   */
@@ -324,6 +347,152 @@ _LONG_CALL_ int CPU_Clk_Check(void);
   * @}
   */
 
+/** @defgroup CLK_Tree
+  * @verbatim
+  *****************************************************************************************
+  * Clock tree and rate change notification
+  *****************************************************************************************
+  *	-CLK_RateGet() returns the cached rate of a node, CLK_TreeRefresh() reloads the cache
+  *	-PLL_SetFreqNotify() changes a PLL at runtime, it is built with the PLL driver
+  *	 (CONFIG_I2S_AMEBA): drivers clocked from an affected node
+  *	 quiesce on CLK_EVT_PRE_CHANGE (or veto it), and reprogram their baud or speed divider
+  *	 on CLK_EVT_POST_CHANGE, typically from a CLK_DivEntry table computed at init for every
+  *	 PLL rate the application uses, so nothing is recomputed in the change path
+  *	-CLK_DivSetNotify() changes the CPU and HPERI dividers the same way, the thermal governor
+  *	 throttles through it
+  *	-I2C_ClkBind() and SSI_ClkBind() build these tables for an I2C or SPI master and register
+  *	 its notifier. The UARTs run from XTAL or OSC2M/OSC4M, no PLL change reaches them
+  *
+  *****************************************************************************************
+  * @endverbatim
+  * @{
+  */
+
+/** @defgroup CLK_Tree_Node
+  * @{
+  */
+#define CLK_ID_USB_PLL			0
+#define CLK_ID_SYS_PLL			1
+#define CLK_ID_CPU				2
+#define CLK_ID_SHPERI			3
+#define CLK_ID_HPERI			4
+#define CLK_ID_PSRAMC			5
+#define CLK_ID_VO				6
+#define CLK_ID_NUM				7
+/** @} */
+
+/** @defgroup CLK_Notify_Event
+  * @{
+  */
+#define CLK_EVT_PRE_CHANGE		((u32)0x01)	/*!< clocks still at the old rate, return RTK_FAIL to veto */
+#define CLK_EVT_POST_CHANGE		((u32)0x02)	/*!< clocks at the new rate */
+#define CLK_EVT_ABORT_CHANGE	((u32)0x03)	/*!< vetoed after PRE_CHANGE, clocks at the old rate */
+/** @} */
+
+/**
+  * @brief  clock rate change description passed to notifiers
+  */
+typedef struct {
+	u32 OldRate[CLK_ID_NUM];
+	u32 NewRate[CLK_ID_NUM];
+	u32 ChangedMask;			/*!< BIT(CLK_ID_x) of the nodes whose rate changes */
+} CLK_RateChangeTypeDef;
+
+/**
+  * @brief  clock rate change notifier, storage provided by the driver
+  */
+typedef struct CLK_Notifier {
+	int (*Cb)(void *Data, u32 Event, const CLK_RateChangeTypeDef *Change);	/*!< @ref CLK_Notify_Event */
+	void *Data;
+	u32 ClkMask;				/*!< BIT(CLK_ID_x) of the nodes the driver is clocked from */
+	u32 Prio;					/*!< lower runs first */
+	struct CLK_Notifier *Next;
+} CLK_NotifierTypeDef;
+
+/**
+  * @brief  precomputed divider for one source clock rate
+  */
+typedef struct {
+	u32 SrcHz;
+	u32 Val;					/*!< driver specific divider setting */
+} CLK_DivEntry;
+
+void CLK_TreeRefresh(void);
+u32 CLK_RateGet(u32 ClkId);
+void CLK_NotifierRegister(CLK_NotifierTypeDef *Notifier);
+void CLK_NotifierUnregister(CLK_NotifierTypeDef *Notifier);
+#if defined(CONFIG_I2S_AMEBA)
+int PLL_SetFreqNotify(u8 pll_name, u32 pll_freq);
+#endif
+int CLK_DivSetNotify(u8 CpuCkd, u8 HperiCkd);
+int CLK_DivTableLookup(const CLK_DivEntry *Table, u32 Num, u32 SrcHz, u32 *Val);
+/** @} */
+
+/** @defgroup OSC_CAL_Exported_Types OSC_CAL Exported Types
+  * @{
+  */
+
+/**
+  * @brief  OSC_CAL statistics
+  */
+typedef struct {
+	u32 Measures;				/*!< frequency counter results taken */
+	u32 Steps;					/*!< trim code changes by one step */
+	u32 CacheHits;				/*!< band entered with a cached trim code */
+	u32 CacheMisses;
+	u32 Saturated;				/*!< target out of the trim range */
+	u32 TempInvalid;			/*!< thermal meter results not valid, band kept */
+	s32 PpmMax;					/*!< largest error seen, signed */
+} OSC_CAL_StatsTypeDef;
+
+/**
+  * @brief  OSC_CAL init structure definition
+  */
+typedef struct {
+	u32 OSC_CalClk;				/*!< AON128K_CAL_CLK or OSC4M_CAL_CLK, @ref CAL_CLK_SEL_definitions */
+	u32 OSC_CalTolPpm;			/*!< error accepted without retrim */
+	u32 OSC_CalSamples;			/*!< counter results averaged per decision, 1 ~ OSC_CAL_SAMPLE_MAX */
+	s32 OSC_CalTempMin;			/*!< lower edge of band 0, in degree C */
+	u32 OSC_CalBandWidth;		/*!< degree C per band */
+} OSC_CAL_InitTypeDef;
+
+/**
+  * @brief  OSC_CAL instance
+  */
+typedef struct {
+	OSC_CAL_InitTypeDef Cfg;
+	u8 Code;					/*!< trim code in use */
+	u8 Band;
+	u8 Measuring;				/*!< a counter run was started by OSC_CAL */
+	s8 LastDir;					/*!< direction of the last step, 0 if none */
+	u8 Hold;					/*!< best code found, no retrim until the error grows */
+	u8 Samples;
+	u8 Tracking;				/*!< trim code is moving */
+	u8 Rsvd;
+	u32 CodeMax;
+	u32 Target;					/*!< counter result of the exact frequency */
+	u32 Sum;					/*!< counter results of the current decision */
+	u32 SettleUs;
+	u32 ChangeTime;				/*!< DTimestamp of the last trim code change */
+	s32 Temp;					/*!< last valid thermal meter result, degree C */
+	s32 Ppm;					/*!< error of the last decision, > 0 if the OSC is fast */
+	s32 LastPpm;				/*!< error before the last step */
+	u8 Cache[OSC_CAL_BAND_NUM];	/*!< trim code per band, may be saved and restored by the user */
+	OSC_CAL_StatsTypeDef Stats;
+} OSC_CAL_TypeDef;
+
+/** @} */
+
+/** @defgroup OSC_CAL_Exported_Functions OSC_CAL Exported Functions
+  * @{
+  */
+void OSC_CAL_StructInit(OSC_CAL_InitTypeDef *OSC_CalInitStruct);
+int OSC_CAL_Init(OSC_CAL_TypeDef *cal, OSC_CAL_InitTypeDef *OSC_CalInitStruct);
+bool OSC_CAL_Process(OSC_CAL_TypeDef *cal);
+s32 OSC_CAL_GetPpm(OSC_CAL_TypeDef *cal);
+void OSC_CAL_GetStats(OSC_CAL_TypeDef *cal, OSC_CAL_StatsTypeDef *Stats);
+/** @} */
+
 /* Other definations --------------------------------------------------------*/
 void OSC4M_Init(void);
 void OSC4M_R_Set(u32 setbit, u32 clearbit);
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _AMEBA_ETH_LINK_H_
+#define _AMEBA_ETH_LINK_H_
+
+/** @addtogroup Ameba_Periph_Driver
+  * @{
+  */
+
+/** @defgroup ETH_LINK
+  * @brief ETH_LINK driver modules
+  * @verbatim
+  *****************************************************************************************
+  * Introduction
+  *****************************************************************************************
+  * Event driven link manager on top of the ETHERNET driver:
+  *		- PHY registers are accessed through a queue of MDIO transactions, advanced by
+  *		  ETH_LINK_Process() without busy waiting: each call checks the MIIAR completion
+  *		  flags and issues the next page select or register access
+  *		- the MAC link change interrupt wakes the manager, on link up the autonegotiation
+  *		  result and the link partner EEE advertisement are read through the queue, on link
+  *		  down EEE is turned off
+  *		- EEE policy: when the link partner supports EEE, MAC EEE (LPI) is enabled after the
+  *		  TX and RX descriptor rings were idle for ETH_LinkEeeIdleUs, and disabled again when
+  *		  traffic is seen in ETH_LinkEeeBusyRuns consecutive calls, so sustained traffic
+  *		  does not pay the LPI wake latency
+  *		- LPI residency is sampled from the MAC EEE status on every call
+  *
+  *****************************************************************************************
+  * How to use
+  *****************************************************************************************
+  *		1. Initialize the MAC by Ethernet_init().
+  *		2. Fill an ETH_LINK_InitTypeDef by ETH_LINK_StructInit(), set the ETH_InitTypeDef
+  *		   and call ETH_LINK_Init().
+  *		3. Call ETH_LINK_IRQHandler() from the RMII interrupt handler on BIT_ISR_LINKCHG,
+  *		   it calls ETH_LinkWakeCb to wake the task that calls ETH_LINK_Process().
+  *		4. Call ETH_LINK_Process() from that task, periodically (e.g. every 10ms) and when
+  *		   woken by the interrupt. It returns TRUE while MDIO transactions are pending,
+  *		   call it again after about 100us in that case.
+  *
+  *****************************************************************************************
+  * @endverbatim
+  * @{
+  */
+
+/* Exported constants --------------------------------------------------------*/
+/** @defgroup ETH_LINK_Exported_Constants ETH_LINK Exported Constants
+  * @{
+  */
+
+/** @defgroup ETH_LINK_State
+  * @{
+  */
+#define ETH_LINK_STATE_DOWN			0
+#define ETH_LINK_STATE_AN			1	/*!< link up, reading the autonegotiation result */
+#define ETH_LINK_STATE_UP			2
+/** @} */
+
+/** @defgroup ETH_LINK_Event
+  * @{
+  */
+#define ETH_LINK_EVT_UP				((u32)0x01)
+#define ETH_LINK_EVT_DOWN			((u32)0x02)
+#define ETH_LINK_EVT_EEE_ON			((u32)0x03)
+#define ETH_LINK_EVT_EEE_OFF		((u32)0x04)
+/** @} */
+
+#define ETH_LINK_MDIO_QUEUE			16		/*!< transactions, power of 2 */
+#define ETH_LINK_MDIO_TMO_US		2000
+
+#define PHY_BMSR_AN_COMPLETE		BIT(5)
+#define PHY_ANLPAR_100FULL			BIT(8)
+
+/** @} */
+
+/* Exported types ------------------------------------------------------------*/
+/** @defgroup ETH_LINK_Exported_Types ETH_LINK Exported Types
+  * @{
+  */
+
+/**
+  * @brief  ETH_LINK MDIO transaction
+  */
+typedef struct {
+	u16 Data;					/*!< value to write */
+	u16 *Result;				/*!< read value destination, NULL for a write */
+	u8 Page;
+	u8 Reg;
+} ETH_LINK_MdioXfer;
+
+/**
+  * @brief  ETH_LINK statistics
+  */
+typedef struct {
+	u32 LinkUps;
+	u32 LinkDowns;
+	u32 MdioXfers;
+	u32 MdioTimeouts;
+	u32 EeeEnables;
+	u32 EeeDisables;
+	u64 LinkUpUs;				/*!< time with the link up */
+	u64 EeeOnUs;				/*!< time with MAC EEE enabled */
+	u64 LpiUs;					/*!< time with both TX and RX in LPI, sampled per call */
+} ETH_LINK_StatsTypeDef;
+
+/**
+  * @brief  ETH_LINK init structure definition
+  */
+typedef struct {
+	ETH_InitTypeDef *ETH_Init;
+	u32 ETH_LinkEeeEn;			/*!< advertise EEE and run the EEE policy */
+	u32 ETH_LinkEeeIdleUs;		/*!< descriptor idle time before MAC EEE is enabled */
+	u32 ETH_LinkEeeBusyRuns;	/*!< consecutive calls with traffic before MAC EEE is disabled */
+	void (*ETH_LinkEventCb)(void *Data, u32 Event);	/*!< @ref ETH_LINK_Event, called in ETH_LINK_Process context */
+	void (*ETH_LinkWakeCb)(void *Data);	/*!< wakes the ETH_LINK_Process task, called in interrupt context */
+	void *ETH_LinkCbData;
+} ETH_LINK_InitTypeDef;
+
+/**
+  * @brief  ETH_LINK instance
+  */
+typedef struct {
+	ETH_LINK_InitTypeDef Cfg;
+	u8 State;					/*!< @ref ETH_LINK_State */
+	u8 Speed;					/*!< eth_link_speed_e */
+	u8 Duplex;					/*!< eth_duplex_mode_e */
+	u8 EeeCap;					/*!< both sides advertise 100BASE-TX EEE */
+	u8 EeeOn;
+	u8 MdioPhase;
+	u16 Bmsr;
+	u16 Anlpar;
+	u16 LpEee;
+	u16 BusyRun;
+	u32 TxCount;				/*!< ETH_TxPktCount at the last policy run */
+	u32 RxCount;				/*!< ETH_RxPktCount at the last policy run */
+	u32 IdleUs;
+	u32 LastTime;
+	u32 MdioStart;
+	u32 MdioHead;
+	u32 MdioTail;
+	ETH_LINK_MdioXfer Mdio[ETH_LINK_MDIO_QUEUE];
+	ETH_LINK_StatsTypeDef Stats;
+} ETH_LINK_TypeDef;
+
+/** @} */
+
+/* Exported functions --------------------------------------------------------*/
+/** @defgroup ETH_LINK_Exported_Functions ETH_LINK Exported Functions
+  * @{
+  */
+void ETH_LINK_StructInit(ETH_LINK_InitTypeDef *ETH_LinkInitStruct);
+int ETH_LINK_Init(ETH_LINK_TypeDef *link, ETH_LINK_InitTypeDef *ETH_LinkInitStruct);
+int ETH_LINK_MdioQueue(ETH_LINK_TypeDef *link, u8 Page, u8 Reg, u16 Data, u16 *Result);
+void ETH_LINK_IRQHandler(ETH_LINK_TypeDef *link);
+bool ETH_LINK_Process(ETH_LINK_TypeDef *link);
+u32 ETH_LINK_GetState(ETH_LINK_TypeDef *link);
+void ETH_LINK_GetStats(ETH_LINK_TypeDef *link, ETH_LINK_StatsTypeDef *Stats);
+/** @} */
+
+/** @} */
+
+/** @} */
+
+#endif
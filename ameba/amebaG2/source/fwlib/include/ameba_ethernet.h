@@ -2731,8 +2731,47 @@ typedef struct {
 	u32 	ETH_PHY_EEE_EN;
 	eth_callback_t callback;
 	eth_task_yield task_yield;
+	struct ETH_Napi *ETH_Napi;	/* RX interrupt moderation, NULL to signal every ROK by callback */
+	u32		ETH_TxPktCount;		/* free running, TX descriptors handed to the MAC */
+	u32		ETH_RxPktCount;		/* free running, RX descriptors given back to the MAC */
 } ETH_InitTypeDef, *PETH_InitTypeDef;
 
+/**
+  \brief  Ethernet RX polling statistics.
+*/
+typedef struct {
+	u32 Irqs;			/* RX interrupts taken */
+	u32 Packets;		/* packets delivered by polling */
+	u32 Rounds;			/* poll rounds */
+	u32 BudgetHits;		/* rounds that used the whole budget */
+	u32 Rearms;			/* RX interrupt re-enabled after the ring drained */
+	u32 PktPerIrqQ8;	/* packets per interrupt, moving average in Q8 */
+} ETH_NapiStatsTypeDef;
+
+/**
+  \brief  Ethernet RX interrupt moderation with NAPI style polling.
+  *
+  * The first ROK masks the RX interrupt and schedules the poll context by ScheduleCb, the poll
+  * context calls Ethernet_NapiPoll until it returns FALSE, which re-enables the interrupt once the
+  * ring is drained. The budget of a round doubles when it is used up and halves when a round
+  * finds few packets. At high packet rates (many packets per interrupt) the poll lingers for
+  * some empty rounds before re-enabling the interrupt, so a flood is served by polling only.
+*/
+typedef struct ETH_Napi {
+	ETH_InitTypeDef *Eth;
+	void (*ScheduleCb)(void *Data);						/* called in ISR, wake the poll context */
+	void (*RxCb)(void *Data, u8 *Buf, u32 Len);		/* called in poll context per packet */
+	void *CbData;
+	u32 BudgetMin;
+	u32 BudgetMax;
+	u32 Budget;
+	u32 LingerMax;		/* empty rounds allowed before re-enabling, at the highest rate */
+	u32 Linger;
+	u32 RoundPkts;		/* packets since the last interrupt */
+	volatile u8 Polling;
+	ETH_NapiStatsTypeDef Stats;
+} ETH_NapiTypeDef;
+
 /**
  * @addtogroup hs_hal_ethernet_rom_func ETHERNET HAL ROM APIs.
  * @ingroup hs_hal_ethernet
@@ -2757,9 +2796,14 @@ u8 *Ethernet_GetRXPktInfo(ETH_InitTypeDef *ETH_InitStruct, u32 *rx_len);
 void Ethernet_UpdateRXDESC(ETH_InitTypeDef *ETH_InitStruct);
 u8 *Ethernet_GetTXPktInfo(ETH_InitTypeDef *ETH_InitStruct);
 void Ethernet_UpdateTXDESCAndSend(ETH_InitTypeDef *ETH_InitStruct, u32 size);
+void Ethernet_NapiInit(ETH_NapiTypeDef *napi, ETH_InitTypeDef *ETH_InitStruct);
+void Ethernet_NapiIRQHandler(ETH_NapiTypeDef *napi);
+bool Ethernet_NapiPoll(ETH_NapiTypeDef *napi);
+void Ethernet_NapiGetStats(ETH_NapiTypeDef *napi, ETH_NapiStatsTypeDef *Stats);
 
 extern void ethernet_mii_init(void);
 extern int link_is_up;
+extern u8 phy_id;
 
 //#define  ENABLE_EEE_FUNCTION
 
@@ -116,6 +116,10 @@
   *
   *      4. Enable GDMA using function GDMA_Cmd().
   *
+  *      Channels can also be allocated by QoS class: reserve channels per class by GDMA_QosInit(),
+  *      allocate by GDMA_QosChnlAlloc() and free by GDMA_QosChnlFree(). Bracket each transfer with
+  *      GDMA_QosXferStart() and GDMA_QosXferDone() to account the busy time and bytes per channel.
+  *
   *
   * @endverbatim
   */
@@ -1102,6 +1106,18 @@ struct GDMA_CH_LLI {
   * @}
   */
 
+/** @defgroup GDMA_QoS_Class
+  * @{
+  */
+#define GDMA_QOS_RT                   ((u32)0x00000000)   /*!< real-time, e.g. audio, highest channel priority */
+#define GDMA_QOS_BULK                 ((u32)0x00000001)   /*!< peripheral bulk, may borrow idle reserved channels */
+#define GDMA_QOS_BG                   ((u32)0x00000002)   /*!< background, e.g. memcpy, lowest channel priority */
+#define GDMA_QOS_CLASS_NUM            (3)
+#define IS_GDMA_QOS_CLASS(CLASS)      ((CLASS) < GDMA_QOS_CLASS_NUM)
+/**
+  * @}
+  */
+
 /** @defgroup GDMA_Data_Transfer_Direction
   * @{
   */
@@ -1278,6 +1294,53 @@ struct GDMA_CH_LLI {
 
 /** @} */
 
+/* Exported types --------------------------------------------------------*/
+/** @addtogroup GDMA_Exported_Types GDMA Exported Types
+  * @{
+  */
+
+/**
+  * @brief  GDMA QoS allocation request
+  */
+typedef struct {
+	u32 QosClass;                 /*!< Specifies the QoS class, a value of @ref GDMA_QoS_Class.*/
+
+	IRQ_FUN IrqFun;               /*!< Specifies the GDMA IRQ callback function, NULL for polling mode.*/
+
+	u32 IrqData;                  /*!< Specifies the GDMA IRQ callback data.*/
+
+	u32 IrqPriority;              /*!< Specifies the GDMA IRQ priority.*/
+
+	void (*PreemptCb)(void *Data, u8 GDMA_ChNum);	/*!< Specifies the callback for a GDMA_QOS_BULK channel borrowed from a
+	                                   reservation and taken back. The channel is already aborted and no longer owned.*/
+
+	void *PreemptData;            /*!< Specifies the preempt callback data.*/
+} GDMA_QosReqTypeDef;
+
+/**
+  * @brief  GDMA QoS channel statistics
+  */
+typedef struct {
+	u64 BusyUs;                   /*!< Time between GDMA_QosXferStart() and GDMA_QosXferDone().*/
+	u64 Bytes;                    /*!< Bytes of the completed transfers.*/
+	u32 Xfers;                    /*!< Completed transfers.*/
+	u32 Allocs;                   /*!< Allocations of this channel.*/
+	u32 Preempted;                /*!< Times this channel was taken back from a borrower.*/
+} GDMA_QosChnlStatsTypeDef;
+
+/**
+  * @brief  GDMA QoS statistics
+  */
+typedef struct {
+	GDMA_QosChnlStatsTypeDef Chnl[MAX_GDMA_CHNL + 1];
+	u32 AllocFails[GDMA_QOS_CLASS_NUM];
+	u32 Borrows;                  /*!< GDMA_QOS_BULK allocations served from another class reservation.*/
+	u32 Preempts;
+	u32 WindowUs;                 /*!< Time since GDMA_QosInit(), the utilization is BusyUs / WindowUs.*/
+} GDMA_QosStatsTypeDef;
+
+/** @} */
+
 /* Exported functions --------------------------------------------------------*/
 /** @defgroup GDMA_Exported_Functions GDMA Exported Functions
   * @{
@@ -1309,6 +1372,13 @@ _LONG_CALL_ void GDMA_Resume(u8 GDMA_Index, u8 GDMA_ChNum);
 _LONG_CALL_ u8   GDMA_Abort(u8 GDMA_Index, u8 GDMA_ChNum);
 _LONG_CALL_ void GDMA_SourceGather(u8 GDMA_Index, u8 GDMA_ChNum, u32 Src_GatherCount, u32 Src_GatherInterval);
 _LONG_CALL_ void GDMA_DestinationScatter(u8 GDMA_Index, u8 GDMA_ChNum, u32 Dst_ScatterCount, u32 Dst_ScatterInterval);
+
+int GDMA_QosInit(u32 GDMA_Index, const u8 *ReserveMask);
+u8 GDMA_QosChnlAlloc(u32 GDMA_Index, GDMA_QosReqTypeDef *Req);
+u8 GDMA_QosChnlFree(u8 GDMA_Index, u8 GDMA_ChNum);
+void GDMA_QosXferStart(u8 GDMA_Index, u8 GDMA_ChNum, u32 Bytes);
+void GDMA_QosXferDone(u8 GDMA_Index, u8 GDMA_ChNum);
+void GDMA_QosGetStats(u8 GDMA_Index, GDMA_QosStatsTypeDef *Stats);
 /**
   * @}
   */
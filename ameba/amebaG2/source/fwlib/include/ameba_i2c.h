@@ -731,6 +731,21 @@ typedef struct {
 	I2C_TypeDef *I2Cx;
 } I2C_IntModeCtrl;
 
+#define I2C_CLK_RATE_MAX		4	/*!< source clock rates of one I2C_ClkBindTypeDef */
+
+/**
+  * @brief  I2C SCL counts kept across clock rate changes, see I2C_ClkBind()
+  */
+typedef struct {
+	CLK_NotifierTypeDef Notifier;
+	I2C_TypeDef *I2Cx;
+	u32 SpdMd;
+	u32 ClkId;						/*!< clock tree node of the I2C IP clock, @ref CLK_Tree_Node */
+	u32 Num;
+	CLK_DivEntry Cnt[I2C_CLK_RATE_MAX];		/*!< HCNT << 16 | LCNT of SpdMd for each source rate */
+	CLK_DivEntry McCnt[I2C_CLK_RATE_MAX];	/*!< fast speed counts of the HS master code */
+} I2C_ClkBindTypeDef;
+
 /**
   * @brief  I2C dev Table Definition
   */
@@ -843,6 +858,8 @@ _LONG_CALL_ u8 I2C_CheckFlagState(I2C_TypeDef *I2Cx, u32 I2C_FLAG);
 _LONG_CALL_ void I2C_INTConfig(I2C_TypeDef *I2Cx, u32 I2C_IT, u32 NewState);
 _LONG_CALL_ u32 I2C_ClearINT(I2C_TypeDef *I2Cx, u32 INTrAddr);
 _LONG_CALL_ void I2C_SetSpeed(I2C_TypeDef *I2Cx, u32 SpdMd, u32 I2Clk, u32 I2CIPClk);
+_LONG_CALL_ int I2C_ClkBind(I2C_ClkBindTypeDef *Bind, I2C_TypeDef *I2Cx, u32 SpdMd, u32 I2Clk, u32 ClkId, const u32 *SrcHz, u32 Num);
+_LONG_CALL_ void I2C_ClkUnbind(I2C_ClkBindTypeDef *Bind);
 _LONG_CALL_ void I2C_StructInit(I2C_InitTypeDef *I2C_InitStruct);
 _LONG_CALL_ u8 I2C_ReceiveData(I2C_TypeDef *I2Cx);
 _LONG_CALL_ s32 I2C_PollFlagRawINT(I2C_TypeDef *I2Cx, u32 I2C_FLAG, u32 I2C_RawINT, u32 timeout_ms);
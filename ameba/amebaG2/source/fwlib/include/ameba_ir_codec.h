@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _AMEBA_IR_CODEC_H_
+#define _AMEBA_IR_CODEC_H_
+
+/** @addtogroup Ameba_Periph_Driver
+  * @{
+  */
+
+/** @defgroup IR_CODEC
+  * @brief IR_CODEC driver modules
+  * @verbatim
+  *****************************************************************************************
+  * Introduction
+  *****************************************************************************************
+  * Protocol layer on top of the IR driver for NEC (and extended NEC), RC5 (and RC5X),
+  * RC6 mode 0 and Sony SIRC 12/15/20 bits:
+  *		- symbol timings are converted once at init, to TX clock ticks and to RX sample
+  *		  count windows (nominal +/- IR_CodecTolPct), nothing is scaled per edge
+  *		- TX: a frame is encoded into a list of TX FIFO words, adjacent halves of the same
+  *		  level merged, and fed to the FIFO by the TX FIFO level interrupt
+  *		- RX: the interrupt drains the RX FIFO into a duration list, the RX counter
+  *		  threshold on the idle level (IR_CodecGapUs) ends the frame, which is decoded and
+  *		  queued to the consumer. A NEC repeat code, or the same RC5/RC6/Sony frame again
+  *		  within IR_CodecRptUs, is queued with Repeat set
+  *
+  * TX uses the compensation clock (IR_TxCOMP_CLK) as tick, RX counts at IR_Freq.
+  *
+  *****************************************************************************************
+  * How to use
+  *****************************************************************************************
+  *		1. Initialize the IR by IR_Init(), in TX or RX mode.
+  *		2. Fill an IR_CODEC_InitTypeDef by IR_CODEC_StructInit(), set the IR_InitTypeDef
+  *		   used in step 1 and call IR_CODEC_Init(). In RX mode it sets the frame gap
+  *		   threshold and unmasks the RX interrupts, then start the RX by IR_Cmd().
+  *		3. Call IR_CODEC_IRQHandler() from the IR interrupt handler.
+  *		4. TX: IR_CODEC_Send() returns RTK_FAIL while the previous frame is on the wire.
+  *		   RX: take decoded frames by IR_CODEC_Receive(), IR_CODEC_EVT_RX_FRAME tells a
+  *		   frame is queued.
+  *
+  *****************************************************************************************
+  * @endverbatim
+  * @{
+  */
+
+/* Exported constants --------------------------------------------------------*/
+/** @defgroup IR_CODEC_Exported_Constants IR_CODEC Exported Constants
+  * @{
+  */
+
+/** @defgroup IR_CODEC_Protocol
+  * @{
+  */
+#define IR_CODEC_NEC				0
+#define IR_CODEC_RC5				1
+#define IR_CODEC_RC6				2
+#define IR_CODEC_SONY				3
+/** @} */
+
+/** @defgroup IR_CODEC_Event
+  * @{
+  */
+#define IR_CODEC_EVT_TX_DONE		((u32)0x01)	/*!< last word of the frame loaded */
+#define IR_CODEC_EVT_RX_FRAME		((u32)0x02)
+/** @} */
+
+#define IR_CODEC_TIMING_NUM			13
+#define IR_CODEC_WORD_MAX			72		/*!< NEC frame with header and stop mark */
+#define IR_CODEC_FRAME_QUEUE		8		/*!< decoded frames, power of 2 */
+
+/** @} */
+
+/* Exported types ------------------------------------------------------------*/
+/** @defgroup IR_CODEC_Exported_Types IR_CODEC Exported Types
+  * @{
+  */
+
+/**
+  * @brief  IR_CODEC frame
+  */
+typedef struct {
+	u8 Protocol;				/*!< @ref IR_CODEC_Protocol */
+	u8 Bits;					/*!< Sony: 12, 15 or 20, 0 for 12 */
+	u8 Toggle;					/*!< RC5/RC6 toggle bit */
+	u8 Repeat;					/*!< TX: NEC repeat code. RX: repeat of the previous frame */
+	u16 Address;				/*!< NEC: 8 bit, or 16 bit extended. RC5: 5 bit. RC6: 8 bit. Sony: 5/8/13 bit */
+	u16 Command;				/*!< NEC/RC6: 8 bit. RC5: 7 bit (RC5X). Sony: 7 bit */
+	u32 TimeUs;					/*!< RX: DTimestamp at frame end */
+} IR_CODEC_FrameTypeDef;
+
+/**
+  * @brief  IR_CODEC statistics
+  */
+typedef struct {
+	u32 TxFrames;
+	u32 RxFrames;				/*!< decoded, repeats included */
+	u32 RxRepeats;
+	u32 RxErrors;				/*!< durations matching no protocol */
+	u32 RxOverflows;			/*!< RX FIFO overflow or frame longer than IR_CODEC_WORD_MAX */
+	u32 RxQueueFull;			/*!< decoded frames dropped, consumer too slow */
+} IR_CODEC_StatsTypeDef;
+
+/**
+  * @brief  IR_CODEC init structure definition
+  */
+typedef struct {
+	IR_InitTypeDef *IR_Init;	/*!< structure given to IR_Init() */
+	u32 IR_CodecTolPct;			/*!< RX timing tolerance, percent of the nominal duration */
+	u32 IR_CodecGapUs;			/*!< RX idle time ending a frame */
+	u32 IR_CodecRptUs;			/*!< RX frames closer than this may be repeats */
+	u32 IR_CodecMarkLevel;		/*!< RX input level during a mark, 0 for the usual active low receivers */
+	void (*IR_CodecCb)(void *Data, u32 Event);	/*!< optional, @ref IR_CODEC_Event, called in ISR */
+	void *IR_CodecCbData;
+} IR_CODEC_InitTypeDef;
+
+/**
+  * @brief  IR_CODEC instance
+  */
+typedef struct {
+	IR_CODEC_InitTypeDef Cfg;
+	IR_TypeDef *IRx;
+	u32 Mode;					/*!< IR_MODE_TX or IR_MODE_RX */
+	u32 TxTick[IR_CODEC_TIMING_NUM];	/*!< TX ticks per symbol */
+	u32 RxLo[IR_CODEC_TIMING_NUM];		/*!< RX sample count windows per symbol */
+	u32 RxHi[IR_CODEC_TIMING_NUM];
+	u32 Word[IR_CODEC_WORD_MAX];	/*!< TX FIFO words, or RX durations with IR_BIT_RX_LEVEL as mark flag */
+	u32 WordNum;
+	u32 WordPos;				/*!< TX: next word to load */
+	volatile u8 TxBusy;
+	u8 RxDrop;					/*!< current RX frame overflowed, discard it */
+	volatile u8 RxHead;
+	volatile u8 RxTail;
+	IR_CODEC_FrameTypeDef Rx[IR_CODEC_FRAME_QUEUE];
+	IR_CODEC_FrameTypeDef Last;	/*!< last decoded frame, for repeats */
+	IR_CODEC_StatsTypeDef Stats;
+} IR_CODEC_TypeDef;
+
+/** @} */
+
+/* Exported functions --------------------------------------------------------*/
+/** @defgroup IR_CODEC_Exported_Functions IR_CODEC Exported Functions
+  * @{
+  */
+void IR_CODEC_StructInit(IR_CODEC_InitTypeDef *IR_CodecInitStruct);
+int IR_CODEC_Init(IR_CODEC_TypeDef *codec, IR_TypeDef *IRx, IR_CODEC_InitTypeDef *IR_CodecInitStruct);
+int IR_CODEC_Encode(IR_CODEC_TypeDef *codec, IR_CODEC_FrameTypeDef *Frame);
+bool IR_CODEC_Decode(IR_CODEC_TypeDef *codec, IR_CODEC_FrameTypeDef *Frame);
+int IR_CODEC_Send(IR_CODEC_TypeDef *codec, IR_CODEC_FrameTypeDef *Frame);
+int IR_CODEC_Receive(IR_CODEC_TypeDef *codec, IR_CODEC_FrameTypeDef *Frame);
+void IR_CODEC_IRQHandler(IR_CODEC_TypeDef *codec);
+void IR_CODEC_GetStats(IR_CODEC_TypeDef *codec, IR_CODEC_StatsTypeDef *Stats);
+/** @} */
+
+/** @} */
+
+/** @} */
+
+#endif
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _AMEBA_LCDC_FB_H_
+#define _AMEBA_LCDC_FB_H_
+
+/** @addtogroup Ameba_Periph_Driver
+  * @{
+  */
+
+/** @defgroup LCDC_FB
+  * @brief LCDC_FB driver modules
+  * @verbatim
+  *****************************************************************************************
+  * Introduction
+  *****************************************************************************************
+  * Frame presenter on top of the LCDC driver. It owns 2~3 framebuffers and hands them
+  * out to the renderer, so the buffer being displayed is never drawn into.
+  *		- RGB I/F: a presented buffer is written to the IMG_A shadow register and latched by
+  *		  the vertical blanking reload (LCDC_ShadowReloadConfig). The line interrupt reads the
+  *		  active address back to retire the previous buffer. Presenting again before the
+  *		  reload replaces the queued frame, which is reported as dropped.
+  *		- MCU I/F in trigger DMA mode: dirty rectangles are merged into full width line
+  *		  bands. Each band is pushed by one DMA trigger after FB_SetWindow() programs the
+  *		  panel GRAM window, so only changed lines cross the bus.
+  *
+  * Damage of frames presented after a buffer was last shown is accumulated per buffer,
+  * the renderer gets it by LCDC_FB_GetDamage() to bring a reused buffer up to date.
+  *
+  *****************************************************************************************
+  * How to use
+  *****************************************************************************************
+  *		1. Initialize the LCDC by LCDC_RGBInit() or LCDC_MCUInit() + LCDC_MCUDmaMode().
+  *		2. Fill a LCDC_FB_InitTypeDef by LCDC_FB_StructInit() and call LCDC_FB_Init().
+  *		3. Call LCDC_FB_IRQHandler() from the LCDC interrupt handler.
+  *		4. Per frame: LCDC_FB_Acquire(), redraw LCDC_FB_GetDamage() and new changes,
+  *		   then LCDC_FB_Present() with the changed rectangles.
+  *
+  *****************************************************************************************
+  * @endverbatim
+  * @{
+  */
+
+/* Exported constants --------------------------------------------------------*/
+/** @defgroup LCDC_FB_Exported_Constants LCDC_FB Exported Constants
+  * @{
+  */
+
+/** @defgroup LCDC_FB_Mode
+  * @{
+  */
+#define LCDC_FB_MODE_RGB			(0)
+#define LCDC_FB_MODE_MCU			(1)
+#define IS_LCDC_FB_MODE(MODE)		(((MODE) == LCDC_FB_MODE_RGB) || ((MODE) == LCDC_FB_MODE_MCU))
+/** @} */
+
+/** @defgroup LCDC_FB_Buffer_State
+  * @{
+  */
+#define LCDC_FB_BUF_FREE			((u8)0x00)	/*!< can be acquired */
+#define LCDC_FB_BUF_DRAWING			((u8)0x01)	/*!< owned by the renderer */
+#define LCDC_FB_BUF_QUEUED			((u8)0x02)	/*!< presented, waiting for vblank or bus */
+#define LCDC_FB_BUF_SCANOUT			((u8)0x03)	/*!< read by the LCDC DMA */
+#define LCDC_FB_BUF_DROPPED			((u8)0x04)	/*!< replaced while queued, freed once not active */
+/** @} */
+
+#define LCDC_FB_BUF_MAX				3
+#define LCDC_FB_BAND_MAX			4
+#define LCDC_FB_INVALID				0xFF
+
+/** @} */
+
+/* Exported types ------------------------------------------------------------*/
+/** @defgroup LCDC_FB_Exported_Types LCDC_FB Exported Types
+  * @{
+  */
+
+/**
+  * @brief  LCDC_FB dirty rectangle, in pixels
+  */
+typedef struct {
+	u16 X;
+	u16 Y;
+	u16 W;
+	u16 H;
+} LCDC_FB_Rect;
+
+/**
+  * @brief  LCDC_FB line band [Y0, Y1)
+  */
+typedef struct {
+	u16 Y0;
+	u16 Y1;
+} LCDC_FB_Band;
+
+/**
+  * @brief  LCDC_FB init structure definition
+  */
+typedef struct {
+	LCDC_TypeDef *LCDCx;
+	u32 FB_Mode;				/*!< @ref LCDC_FB_Mode */
+	u32 FB_BufNum;				/*!< 2 or 3 */
+	u32 FB_BufAddr[LCDC_FB_BUF_MAX];	/*!< framebuffer addresses, 64 bytes aligned */
+	u32 FB_Width;				/*!< pixels per line */
+	u32 FB_Height;				/*!< lines */
+	u32 FB_Bpp;					/*!< bytes per pixel of the input format */
+	u32 FB_VsyncLine;			/*!< RGB: line interrupt position used as vsync tick */
+	u32 FB_BandGap;				/*!< MCU: bands closer than this are pushed as one */
+	void (*FB_SetWindow)(void *Data, u32 Y0, u32 Y1);	/*!< MCU: program panel GRAM rows [Y0, Y1) */
+	void (*FB_VsyncCb)(void *Data);	/*!< optional, called in ISR when a buffer was released */
+	void *FB_CbData;
+} LCDC_FB_InitTypeDef;
+
+/**
+  * @brief  LCDC_FB statistics
+  */
+typedef struct {
+	u32 Presented;			/*!< frames presented by the renderer */
+	u32 Flipped;			/*!< frames that reached the panel */
+	u32 Dropped;			/*!< frames replaced before they were shown */
+	u32 Vsyncs;				/*!< RGB: vsync ticks seen */
+	u32 AcquireFail;		/*!< LCDC_FB_Acquire calls without free buffer */
+	u32 PushedLines;		/*!< MCU: lines transferred by partial refresh */
+	u32 LatencyLastUs;		/*!< present to scanout latency of the last frame */
+	u32 LatencyMaxUs;
+	u64 LatencySumUs;		/*!< divide by Flipped for the average */
+} LCDC_FB_StatsTypeDef;
+
+/**
+  * @brief  LCDC_FB instance
+  */
+typedef struct {
+	LCDC_FB_InitTypeDef Cfg;
+	u8 State[LCDC_FB_BUF_MAX];
+	u8 Scanout;				/*!< buffer on screen or being pushed */
+	u8 Pending;				/*!< buffer queued for the next flip */
+	u8 BandIdx;				/*!< MCU: band in transfer */
+	u8 Busy;				/*!< MCU: DMA transfer in progress */
+	u8 Rsvd[3];
+	u32 PresentTime[LCDC_FB_BUF_MAX];
+	u8 DirtyNum[LCDC_FB_BUF_MAX];
+	u8 DamageNum[LCDC_FB_BUF_MAX];
+	LCDC_FB_Band Dirty[LCDC_FB_BUF_MAX][LCDC_FB_BAND_MAX];	/*!< bands to push when presented */
+	LCDC_FB_Band Damage[LCDC_FB_BUF_MAX][LCDC_FB_BAND_MAX];	/*!< bands stale since last shown */
+	LCDC_FB_StatsTypeDef Stats;
+} LCDC_FB_TypeDef;
+
+/** @} */
+
+/* Exported functions --------------------------------------------------------*/
+/** @defgroup LCDC_FB_Exported_Functions LCDC_FB Exported Functions
+  * @{
+  */
+void LCDC_FB_StructInit(LCDC_FB_InitTypeDef *FB_InitStruct);
+void LCDC_FB_Init(LCDC_FB_TypeDef *fb, LCDC_FB_InitTypeDef *FB_InitStruct);
+u8 LCDC_FB_Acquire(LCDC_FB_TypeDef *fb);
+u32 LCDC_FB_GetBuffer(LCDC_FB_TypeDef *fb, u8 Idx);
+u32 LCDC_FB_GetDamage(LCDC_FB_TypeDef *fb, u8 Idx, LCDC_FB_Band *Bands);
+void LCDC_FB_Present(LCDC_FB_TypeDef *fb, u8 Idx, const LCDC_FB_Rect *Rects, u32 RectNum);
+void LCDC_FB_IRQHandler(LCDC_FB_TypeDef *fb);
+void LCDC_FB_GetStats(LCDC_FB_TypeDef *fb, LCDC_FB_StatsTypeDef *Stats);
+/** @} */
+
+/** @} */
+
+/** @} */
+
+#endif
@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _AMEBA_NAND_FTL_H_
+#define _AMEBA_NAND_FTL_H_
+
+/** @addtogroup Ameba_Periph_Driver
+  * @{
+  */
+
+/** @defgroup NAND_FTL
+  * @brief NAND_FTL driver modules
+  * @verbatim
+  *****************************************************************************************
+  * Introduction
+  *****************************************************************************************
+  * Log-structured flash translation layer on top of the DATA_NAND_* raw page APIs:
+  *		- page level logical-to-physical mapping
+  *		- bad block table built from factory markers and runtime program/erase failures
+  *		- dynamic wear leveling on block allocation, static wear leveling in GC
+  *		- greedy garbage collection using on-die copy-back (page read to cache +
+  *		  program execute), so relocated data never crosses the SPI bus
+  *
+  * Every programmed page carries a NAND_FTL_Tag in its spare area, the mapping is
+  * rebuilt from these tags in NAND_FTL_Mount(). The FTL does not allocate memory, the
+  * mapping table and block table are provided by the caller in NAND_FTL_InitTypeDef.
+  * The FTL is not reentrant, callers shall serialize access to one NAND_FTL_TypeDef.
+  *
+  *****************************************************************************************
+  * How to use
+  *****************************************************************************************
+  *		1. Initialize the data NAND flash by DATA_NAND_Init().
+  *		2. Fill a NAND_FTL_InitTypeDef with NAND_FTL_StructInit() and set the block range,
+  *		   logical page number and table buffers.
+  *		3. Call NAND_FTL_Mount() to scan the blocks and rebuild the mapping.
+  *		4. Access logical pages by NAND_FTL_Read()/NAND_FTL_Write()/NAND_FTL_Trim().
+  *		5. Call NAND_FTL_BackgroundGC() from an idle context to reclaim space ahead of writes.
+  *
+  *****************************************************************************************
+  * @endverbatim
+  * @{
+  */
+
+/* Exported constants --------------------------------------------------------*/
+/** @defgroup NAND_FTL_Exported_Constants NAND_FTL Exported Constants
+  * @{
+  */
+
+/** @defgroup NAND_FTL_Block_State
+  * @{
+  */
+#define NAND_FTL_BLOCK_FREE			((u8)0x00)	/*!< erased or never written */
+#define NAND_FTL_BLOCK_ACTIVE		((u8)0x01)	/*!< current write block */
+#define NAND_FTL_BLOCK_USED			((u8)0x02)	/*!< closed block holding data */
+#define NAND_FTL_BLOCK_BAD			((u8)0x03)	/*!< factory or runtime bad block */
+/**
+  * @}
+  */
+
+/** @defgroup NAND_FTL_Block_Flag
+  * @{
+  */
+#define NAND_FTL_FLAG_SCRUB			((u8)BIT(0))	/*!< bitflips seen, relocate in next GC */
+#define NAND_FTL_FLAG_RETIRE		((u8)BIT(1))	/*!< program failed, mark bad after relocation */
+/**
+  * @}
+  */
+
+/** @defgroup NAND_FTL_Spare_Layout
+  * @{
+  */
+#define NAND_FTL_TAG_OFFSET			4U			/*!< byte offset of the tag inside the spare area, skip bad block marker */
+#define NAND_FTL_TAG_MAGIC			0x4654524CU	/*!< "LRTF" */
+#define NAND_FTL_UNMAPPED			0xFFFFFFFFU
+#define NAND_FTL_UNREADABLE			0xFFFFFFFEU	/*!< uncorrectable page left behind by GC, reads fail until rewritten, not kept across mounts */
+/**
+  * @}
+  */
+
+/** @defgroup NAND_FTL_Default_Parameters
+  * @{
+  */
+#define NAND_FTL_GC_THRESHOLD_DEF	2U			/*!< foreground GC when free blocks drop to this value */
+#define NAND_FTL_BGC_THRESHOLD_DEF	4U			/*!< background GC keeps this many free blocks */
+#define NAND_FTL_WL_DELTA_DEF		64U			/*!< erase count gap that triggers static wear leveling */
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/* Exported types ------------------------------------------------------------*/
+/** @defgroup NAND_FTL_Exported_Types NAND_FTL Exported Types
+  * @{
+  */
+
+/**
+  * @brief  NAND_FTL spare area tag, written with every page
+  */
+typedef struct {
+	u32 Lpn;		/*!< logical page number */
+	u32 Seq;		/*!< global write sequence, the largest wins on mount */
+	u32 EraseCnt;	/*!< erase count of the block holding this page */
+	u32 Check;		/*!< Lpn ^ Seq ^ EraseCnt ^ NAND_FTL_TAG_MAGIC */
+} NAND_FTL_Tag;
+
+/**
+  * @brief  NAND_FTL per block information
+  */
+typedef struct {
+	u32 EraseCnt;	/*!< erase count of this block */
+	u16 ValidCnt;	/*!< pages in this block referenced by the mapping table */
+	u8 WritePtr;	/*!< next programmable page in this block */
+	u8 State;		/*!< @ref NAND_FTL_Block_State */
+	u8 Flag;		/*!< @ref NAND_FTL_Block_Flag */
+	u8 Rsvd[3];
+} NAND_FTL_BlockInfo;
+
+/**
+  * @brief  NAND_FTL statistics
+  */
+typedef struct {
+	u32 HostReadPages;		/*!< logical pages read by the user */
+	u32 HostWritePages;		/*!< logical pages written by the user */
+	u32 NandProgPages;		/*!< physical pages programmed, including GC copies */
+	u32 NandErases;			/*!< physical blocks erased */
+	u32 GcRuns;				/*!< victim blocks reclaimed */
+	u32 GcCopyPages;		/*!< pages relocated by GC */
+	u32 WlMoves;			/*!< GC runs triggered by static wear leveling */
+	u32 FactoryBadBlocks;	/*!< bad blocks marked by the vendor */
+	u32 RuntimeBadBlocks;	/*!< blocks retired after program or erase failure */
+	u32 EccCorrected;		/*!< reads with corrected bitflips */
+	u32 EccUncorrectable;	/*!< reads with uncorrectable errors */
+} NAND_FTL_StatsTypeDef;
+
+/**
+  * @brief  NAND_FTL init structure definition
+  */
+typedef struct {
+	u32 FTL_StartBlock;				/*!< first physical block managed by the FTL */
+	u32 FTL_BlockNum;				/*!< number of physical blocks managed by the FTL */
+	u32 FTL_LogicalPageNum;			/*!< logical pages exported, must leave room for GC and bad blocks */
+	u32 FTL_GCThreshold;			/*!< free block count that triggers foreground GC in write path */
+	u32 FTL_BGCThreshold;			/*!< free block count maintained by NAND_FTL_BackgroundGC */
+	u32 FTL_WearLevelDelta;			/*!< erase count gap that triggers static wear leveling */
+	u32 *FTL_L2P;					/*!< mapping table, FTL_LogicalPageNum entries */
+	NAND_FTL_BlockInfo *FTL_BlockInfo;	/*!< block table, FTL_BlockNum entries */
+} NAND_FTL_InitTypeDef;
+
+/**
+  * @brief  NAND_FTL instance
+  */
+typedef struct {
+	NAND_FTL_InitTypeDef Cfg;
+	u32 PageSize;			/*!< main area size in bytes */
+	u32 FreeBlocks;			/*!< blocks in NAND_FTL_BLOCK_FREE state */
+	u32 ActiveBlock;		/*!< block receiving writes, NAND_FTL_UNMAPPED if none */
+	u32 Seq;				/*!< next write sequence */
+	u8 InGC;				/*!< GC in progress, allocation must not recurse */
+	u8 Mounted;
+	u8 Rsvd[2];
+	NAND_FTL_StatsTypeDef Stats;
+} NAND_FTL_TypeDef;
+
+/**
+  * @}
+  */
+
+/* Exported functions --------------------------------------------------------*/
+/** @defgroup NAND_FTL_Exported_Functions NAND_FTL Exported Functions
+  * @{
+  */
+void NAND_FTL_StructInit(NAND_FTL_InitTypeDef *FTL_InitStruct);
+int NAND_FTL_Mount(NAND_FTL_TypeDef *ftl, NAND_FTL_InitTypeDef *FTL_InitStruct);
+int NAND_FTL_Format(NAND_FTL_TypeDef *ftl);
+int NAND_FTL_Read(NAND_FTL_TypeDef *ftl, u32 Lpn, u32 PageCnt, u8 *pData);
+int NAND_FTL_Write(NAND_FTL_TypeDef *ftl, u32 Lpn, u32 PageCnt, u8 *pData);
+int NAND_FTL_Trim(NAND_FTL_TypeDef *ftl, u32 Lpn, u32 PageCnt);
+int NAND_FTL_BackgroundGC(NAND_FTL_TypeDef *ftl, u32 MaxBlocks);
+void NAND_FTL_GetStats(NAND_FTL_TypeDef *ftl, NAND_FTL_StatsTypeDef *Stats);
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#endif
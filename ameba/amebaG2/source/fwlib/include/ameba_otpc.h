@@ -356,6 +356,24 @@ _LONG_CALL_ int OTPSetCRC(void);
 _LONG_CALL_ int OTP_Read8(u32 Addr, u8 *Data);
 _LONG_CALL_ int OTP_Write8(u32 Addr, u8 Data);
 _LONG_CALL_ int OTP_Read32(u32 Addr, u32 *Data);
+
+/**
+  * @brief  OTP logical map field, used by OTP_LMapCache_WriteBatch
+  */
+typedef struct {
+	u16 Addr;		/*!< logical map address */
+	u16 Len;		/*!< field length in byte */
+	const u8 *Data;	/*!< new field value */
+} OTP_LMapFieldDef;
+
+#define OTP_LMAP_PKT_HDR_LEN						2 /*!< physical header bytes of one logical section packet */
+#define OTP_LMAP_WORD_LEN							2 /*!< physical bytes per word enabled in a packet */
+
+int OTP_LMapCache_Init(void);
+void OTP_LMapCache_Invalidate(void);
+int OTP_LMapCache_Read(u8 *pbuf, u32 addr, u32 len);
+u32 OTP_LMapCache_WriteCost(const OTP_LMapFieldDef *Fields, u32 Num);
+int OTP_LMapCache_WriteBatch(const OTP_LMapFieldDef *Fields, u32 Num);
 /* MANUAL_GEN_END */
 
 #endif
\ No newline at end of file
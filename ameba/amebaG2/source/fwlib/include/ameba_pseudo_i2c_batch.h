@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _AMEBA_PSEUDO_I2C_BATCH_H_
+#define _AMEBA_PSEUDO_I2C_BATCH_H_
+
+/** @addtogroup Ameba_Periph_Driver
+  * @{
+  */
+
+/** @defgroup PSEUDO_I2C_BATCH
+  * @brief PSEUDO_I2C_BATCH driver modules
+  * @verbatim
+  *****************************************************************************************
+  * Introduction
+  *****************************************************************************************
+  * Batched writes on the pseudo I2C of the LEDC_PRO:
+  *		- the sequencer RAM holds one transfer, a command byte and up to 64 data bytes,
+  *		  sent between one start and one stop. A batch is a list of transfers compiled
+  *		  once to their RAM images, packed back to back as words, with the data number of
+  *		  each transfer, and checked to fit the sequencer RAM and the batch
+  *		- running a batch unlocks the control register once, then for each transfer
+  *		  copies its image by words, sets the data number and triggers, and relocks it
+  *		  after the last transfer is out
+  *		- a cache of compiled batches, keyed by a caller chosen id, keeps the sequences of
+  *		  the power state transitions ready to run
+  *
+  * Each transfer still has its own start and stop on the bus: the sequencer sends one
+  * transfer per trigger, only the setup around it is shared.
+  *
+  *****************************************************************************************
+  * How to use
+  *****************************************************************************************
+  *		1. Set the pseudo I2C up by pseudo_i2c_init().
+  *		2. Compile a list of PSEUDO_I2C_XferTypeDef by pseudo_i2c_batch_build() and run it
+  *		   by pseudo_i2c_batch_run(), or keep it by pseudo_i2c_cache_put() and run it by
+  *		   pseudo_i2c_cache_run().
+  *
+  *****************************************************************************************
+  * @endverbatim
+  * @{
+  */
+
+/* Exported constants --------------------------------------------------------*/
+/** @defgroup PSEUDO_I2C_BATCH_Exported_Constants PSEUDO_I2C_BATCH Exported Constants
+  * @{
+  */
+
+#define PSEUDO_I2C_DATA_MAX			64		/*!< data bytes of one transfer, after the command byte */
+#define PSEUDO_I2C_XFER_MAX			8		/*!< transfers of one batch */
+#define PSEUDO_I2C_BATCH_WORDS		64		/*!< RAM images of one batch */
+#define PSEUDO_I2C_CACHE_NUM		4
+
+/** @} */
+
+/* Exported types ------------------------------------------------------------*/
+/** @defgroup PSEUDO_I2C_BATCH_Exported_Types PSEUDO_I2C_BATCH Exported Types
+  * @{
+  */
+
+/**
+  * @brief  PSEUDO_I2C_BATCH transfer
+  */
+typedef struct {
+	u8 Cmd;
+	u8 Len;						/*!< data bytes, 0 ~ PSEUDO_I2C_DATA_MAX */
+	const u8 *Data;
+} PSEUDO_I2C_XferTypeDef;
+
+/**
+  * @brief  PSEUDO_I2C_BATCH compiled batch
+  */
+typedef struct {
+	u32 Id;						/*!< cache key, 0 when not cached */
+	u8 XferNum;
+	u8 Num[PSEUDO_I2C_XFER_MAX];	/*!< data number of each transfer, command byte included */
+	u32 Ram[PSEUDO_I2C_BATCH_WORDS];	/*!< RAM images of the transfers, back to back */
+} PSEUDO_I2C_BatchTypeDef;
+
+/** @} */
+
+/* Exported functions --------------------------------------------------------*/
+/** @defgroup PSEUDO_I2C_BATCH_Exported_Functions PSEUDO_I2C_BATCH Exported Functions
+  * @{
+  */
+int pseudo_i2c_batch_build(PSEUDO_I2C_BatchTypeDef *batch, const PSEUDO_I2C_XferTypeDef *xfer, u32 num);
+void pseudo_i2c_batch_run(const PSEUDO_I2C_BatchTypeDef *batch);
+int pseudo_i2c_cache_put(u32 id, const PSEUDO_I2C_XferTypeDef *xfer, u32 num);
+int pseudo_i2c_cache_run(u32 id);
+void pseudo_i2c_cache_drop(u32 id);
+/** @} */
+
+/** @} */
+
+/** @} */
+
+#endif
@@ -191,6 +191,32 @@ typedef struct {
   */
 
 
+/** @defgroup PSRAM_CalSlice
+  * @{
+  */
+typedef struct {
+	u8 Phase;			/*!< pre calibration phase of the window */
+	u8 CalNMin;			/*!< first passing CalN */
+	u8 CalNMax;			/*!< last passing CalN */
+	u8 WindowSize;
+} PSRAM_CalSlice;
+/**
+  * @}
+  */
+
+/** @defgroup PSRAM_CalRecord
+  * @{
+  */
+typedef struct {
+	u32 Key;			/*!< PSRAM vendor, type, DQ16 and temperature band */
+	u32 ClkSet;			/*!< PSRAM clock the window was found at */
+	PSRAM_CalSlice Slice[2];	/*!< DQ8: Slice[0], DQ16: SL0 and SL1 */
+	u32 Check;
+} PSRAM_CalRecord;
+/**
+  * @}
+  */
+
 /** @defgroup PSRAMINFO_TypeDef
   * @{
   */
@@ -488,6 +514,10 @@ _LONG_CALL_ void PSRAM_CTRL_Init(void);
 _LONG_CALL_ void PSRAM_REG_Read(u32 type, u32 addr, u32 read_len, u8 *read_data, u32 CR, u8 DQ_16);
 _LONG_CALL_ void PSRAM_REG_Write(u32 type, u32 addr, u32 write_len, u8 *write_data, u8 DQ_16);
 _LONG_CALL_ u32 PSRAM_calibration(void);
+u32 PSRAM_SW_Calibration(u32 DQnum);
+u32 PSRAM_SW_CalibrationSlice(u32 DQnum, PSRAM_CalSlice *Slice);
+u32 PSRAM_SW_CalibrationCheck(u32 DQnum, const PSRAM_CalSlice *Slice);
+u32 PSRAM_calibration_fast(PSRAM_CalRecord *Rec, u8 TempBand, bool *Updated);
 _LONG_CALL_ void PSRAM_APM_DEVIC_Init(void);
 _LONG_CALL_ void PSRAM_WB_DEVIC_Init(void);
 _LONG_CALL_ void PSRAM_HalfSleep_PDEX(u32 NewState);
@@ -566,6 +596,12 @@ _LONG_CALL_ void set_psram_wakeup_mode(void);
 #define PSRAM_DQ16_SL1			0x1
 #define PSRAM_DQ8_SL0			0x2
 
+#define PSRAM_CAL_PHASE_NUM		8
+#define PSRAM_CAL_TAP_NUM		32
+#define PSRAM_CAL_WINDOW_MIN	9
+#define PSRAM_CAL_STRIDE		8	/* coarse search step, not above PSRAM_CAL_WINDOW_MIN */
+#define PSRAM_CAL_REC_MAGIC		0x5053434CU	/* "PSCL" */
+
 
 #define PSRAM_MASK_CAL_ITT 		PSPHY_MASK_CFG_CAL_INTR_MASK|\
 								PSPHY_BIT_CFG_CAL_EN
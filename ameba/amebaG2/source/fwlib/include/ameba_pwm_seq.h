@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _AMEBA_PWM_SEQ_H_
+#define _AMEBA_PWM_SEQ_H_
+
+/** @addtogroup Ameba_Periph_Driver
+  * @{
+  */
+
+/** @defgroup PWM_SEQ
+  * @brief PWM_SEQ driver modules
+  * @verbatim
+  *****************************************************************************************
+  * Introduction
+  *****************************************************************************************
+  * Duty cycle sequencer on one PWM timer (TIM4~TIM7):
+  *		- a buffer of compare values, one u16 per used channel and step, channels
+  *		  interleaved in channel order, is played one step per PWM_SeqRepeat periods
+  *		- the channels run with the CCRx preload enabled: the update interrupt writes the
+  *		  next step to the preload registers while the current step is output, and all
+  *		  channels take their new value at the same update event, so the sequence is
+  *		  glitch free and the interrupt has a whole period of slack
+  *		- one-shot mode stops after the last step and holds it, ring mode wraps. Half and
+  *		  end of buffer events let the caller refill one half while the other plays
+  *		- helpers fill sine, ramp and gamma corrected fade tables
+  *
+  * The PWM timers have no GDMA request, the compare values are written by the CPU, but
+  * only one word per channel and step, with the control bits of CCRx kept aside.
+  *
+  *****************************************************************************************
+  * How to use
+  *****************************************************************************************
+  *		1. Set the PWM timer up by RTIM_TimeBaseInit() and its channels by RTIM_CCxInit(),
+  *		   the period (ARR) gives the step rate.
+  *		2. Fill a PWM_SEQ_InitTypeDef by PWM_SEQ_StructInit(), set the timer, the channel
+  *		   mask and the buffer and call PWM_SEQ_Init().
+  *		3. Call PWM_SEQ_IRQHandler() from the timer interrupt handler.
+  *		4. PWM_SEQ_Start() plays the buffer from step 0, PWM_SEQ_Stop() holds the current
+  *		   step.
+  *
+  *****************************************************************************************
+  * @endverbatim
+  * @{
+  */
+
+/* Exported constants --------------------------------------------------------*/
+/** @defgroup PWM_SEQ_Exported_Constants PWM_SEQ Exported Constants
+  * @{
+  */
+
+/** @defgroup PWM_SEQ_Mode
+  * @{
+  */
+#define PWM_SEQ_ONESHOT				0
+#define PWM_SEQ_RING				1
+/** @} */
+
+/** @defgroup PWM_SEQ_Event
+  * @{
+  */
+#define PWM_SEQ_EVT_HALF			((u32)0x01)	/*!< first half of the buffer played */
+#define PWM_SEQ_EVT_WRAP			((u32)0x02)	/*!< ring mode, second half played */
+#define PWM_SEQ_EVT_DONE			((u32)0x04)	/*!< one-shot mode, last step fully output */
+/** @} */
+
+/** @} */
+
+/* Exported types ------------------------------------------------------------*/
+/** @defgroup PWM_SEQ_Exported_Types PWM_SEQ Exported Types
+  * @{
+  */
+
+/**
+  * @brief  PWM_SEQ statistics
+  */
+typedef struct {
+	u32 Periods;				/*!< update events handled */
+	u32 Steps;
+	u32 Wraps;
+	u32 Overruns;				/*!< update events already pending at the end of the handler */
+} PWM_SEQ_StatsTypeDef;
+
+/**
+  * @brief  PWM_SEQ init structure definition
+  */
+typedef struct {
+	u32 PWM_SeqTimIdx;			/*!< 4 ~ 7 */
+	u32 PWM_SeqChnMask;			/*!< BIT(TIM_Channel_x) of the channels played */
+	const u16 *PWM_SeqBuf;		/*!< PWM_SeqLen steps of one compare value per channel */
+	u32 PWM_SeqLen;				/*!< steps */
+	u32 PWM_SeqMode;			/*!< @ref PWM_SEQ_Mode */
+	u32 PWM_SeqRepeat;			/*!< periods per step, 1 or more */
+	void (*PWM_SeqCb)(void *Data, u32 Event);	/*!< optional, @ref PWM_SEQ_Event, called in ISR */
+	void *PWM_SeqCbData;
+} PWM_SEQ_InitTypeDef;
+
+/**
+  * @brief  PWM_SEQ instance
+  */
+typedef struct {
+	PWM_SEQ_InitTypeDef Cfg;
+	RTIM_TypeDef *TIMx;
+	u8 ChnNum;
+	u8 Chn[PWM_CHAN_MAX];		/*!< channels played, in buffer order */
+	volatile u8 Running;
+	u32 Ctrl[PWM_CHAN_MAX];		/*!< CCRx without the compare value */
+	const u16 *Next;			/*!< step to write at the next update event */
+	const u16 *Half;
+	const u16 *End;
+	u32 Repeat;					/*!< update events left on the current step */
+	PWM_SEQ_StatsTypeDef Stats;
+} PWM_SEQ_TypeDef;
+
+/** @} */
+
+/* Exported functions --------------------------------------------------------*/
+/** @defgroup PWM_SEQ_Exported_Functions PWM_SEQ Exported Functions
+  * @{
+  */
+void PWM_SEQ_StructInit(PWM_SEQ_InitTypeDef *PWM_SeqInitStruct);
+int PWM_SEQ_Init(PWM_SEQ_TypeDef *seq, PWM_SEQ_InitTypeDef *PWM_SeqInitStruct);
+void PWM_SEQ_Start(PWM_SEQ_TypeDef *seq);
+void PWM_SEQ_Stop(PWM_SEQ_TypeDef *seq);
+void PWM_SEQ_IRQHandler(PWM_SEQ_TypeDef *seq);
+void PWM_SEQ_GetStats(PWM_SEQ_TypeDef *seq, PWM_SEQ_StatsTypeDef *Stats);
+void PWM_SEQ_TableSine(u16 *Tbl, u32 Len, u32 Stride, u16 Min, u16 Max);
+void PWM_SEQ_TableRamp(u16 *Tbl, u32 Len, u32 Stride, u16 From, u16 To);
+void PWM_SEQ_TableFade(u16 *Tbl, u32 Len, u32 Stride, u16 From, u16 To, float Gamma);
+/** @} */
+
+/** @} */
+
+/** @} */
+
+#endif
@@ -307,6 +307,20 @@ typedef struct {
 					This parameter can be a value of @ref RTC_AlarmMask2 */
 } RTC_AlarmTypeDef;
 
+/**
+  * @brief  RTC Calendar Date Structure Definition, UTC
+  */
+typedef struct {
+	u16 RTC_Year;		/*!< 1900~2155 */
+	u16 RTC_YearDay;	/*!< 0~365, as RTC_Days of RTC_TimeTypeDef */
+	u8 RTC_Month;		/*!< 1~12 */
+	u8 RTC_MonthDay;	/*!< 1~31 */
+	u8 RTC_WeekDay;		/*!< 0~6, Sunday is 0 */
+	u8 RTC_Hours;		/*!< 0~23 */
+	u8 RTC_Minutes;
+	u8 RTC_Seconds;
+} RTC_DateTypeDef;
+
 /**
   * @}
   */
@@ -528,6 +542,16 @@ typedef struct {
   * @}
   */
 
+/** @defgroup RTC_Epoch_Control
+  * @{
+  */
+#define RTC_EPOCH_GUARD_US	((u32) 1000)	/* debug timer to RTC drift allowed over one second */
+#define RTC_EPOCH_MIN		((s64)-2208988800LL)	/* 1900-01-01 00:00:00 */
+#define RTC_EPOCH_MAX		((s64)5869583999LL)	/* 2155-12-31 23:59:59 */
+/**
+  * @}
+  */
+
 /** @defgroup Leap_Year_Check
   * @{
   */
@@ -584,6 +608,11 @@ _LONG_CALL_ u32 RTC_DayLightSavingConfig(u32 RTC_DayLightSaving, u32 RTC_StoreOp
 _LONG_CALL_ u32 RTC_GetStoreOperation(void);
 _LONG_CALL_ u32 RTC_OutputConfig(u32 RTC_Output);
 _LONG_CALL_ u32 RTC_SmoothCalibConfig(u32 CalibSign, u32 Value, u32 CalibPeriod, u32 Calib_Enable);
+s64 RTC_DateToEpoch(RTC_DateTypeDef *RTC_DateStruct);
+void RTC_EpochToDate(s64 Epoch, RTC_DateTypeDef *RTC_DateStruct);
+u32 RTC_EpochSet(s64 Epoch);
+s64 RTC_EpochGet(void);
+void RTC_EpochSync(void);
 
 /**
   * @}
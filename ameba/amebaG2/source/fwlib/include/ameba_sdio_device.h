@@ -17,6 +17,11 @@
 #define SPDIO_MIN_RX_BD_SEND_PKT	2
 #define SPDIO_MAX_RX_BD_BUF_SIZE	16380	// the Maximum size for a RX_BD point to, make it 4-bytes aligned
 
+/* SPDIO_DeviceTxBatch aggregation: the outer INIC_RX_DESC has data_len set to the frame count (0 for a plain
+ * packet) and pkt_len to the total length, each frame follows as its own INIC_RX_DESC plus payload */
+#define SPDIO_TX_AGG_MAX_NUM		16		// frames in one aggregated transfer
+#define SPDIO_TX_AGG_MAX_SIZE		8192	// bytes in one aggregated transfer, frame descriptors included
+
 #define SDIO_INIT_INT_MASK			(SDIO_WIFI_BIT_H2C_DMA_OK | SDIO_WIFI_BIT_C2H_DMA_OK | \
 									SDIO_WIFI_BIT_H2C_BUS_RES_FAIL | SDIO_WIFI_BIT_RX_BD_FLAG_ERR_INT | SDIO_NOTIFY_TYPE_INT)
 
@@ -107,6 +112,28 @@ typedef struct {
 	u8 TxOverFlow;
 } SPDIO_ADAPTER, *PSPDIO_ADAPTER;
 
+/* Statistics of the device RX buffer pool */
+typedef struct {
+	u32 Delivered;					/* buffers handed to the consumer */
+	u32 Recycled;					/* buffers returned by SPDIO_RxPool_Recycle */
+	u32 Exhausted;					/* RX bursts stopped because the pool was empty */
+	u32 Dropped;					/* invalid packets, the buffer stays on its TX_BD */
+	u32 MinFree;					/* lowest number of spare buffers seen */
+	u32 StallMaxUs;					/* longest time the RX path waited for a recycled buffer */
+} SPDIO_RX_POOL_STATS;
+
+/* Spare buffers for zero-copy device RX, a single producer single consumer ring of free buffers */
+typedef struct {
+	struct spdio_buf_t **Ring;		/* free buffers */
+	u16 RingNum;					/* power of 2 */
+	u16 BufSize;
+	volatile u16 Head;				/* written by SPDIO_RxPool_Recycle */
+	volatile u16 Tail;				/* written by SPDIO_TxBd_DataReady_DeviceRxPool */
+	volatile u8 Stalled;
+	u32 StallStart;
+	SPDIO_RX_POOL_STATS Stats;
+} SPDIO_RX_POOL;
+
 typedef s8(*spdio_device_tx_done_cb_ptr)(PSPDIO_ADAPTER pSPDIODev, struct spdio_buf_t *buf);
 typedef s8(*spdio_device_rx_done_cb_ptr)(PSPDIO_ADAPTER pSPDIODev, struct spdio_buf_t *buf, u8 *pdata, u16 pktsize, u8 type);
 
@@ -115,7 +142,13 @@ void SDIO_RxBdHdl_Init(SPDIO_RX_BD_HANDLE *g_RXBDHdl, SPDIO_RX_BD *SPDIO_RXBDAdd
 void SPDIO_Notify_INT(SDIO_TypeDef *SDIO, u16 IntStatus);
 void SPDIO_Recycle_Rx_BD(SDIO_TypeDef *SDIO, PSPDIO_ADAPTER pSPDIODev, spdio_device_tx_done_cb_ptr spdio_device_tx_done_cb);
 u8 SPDIO_DeviceTx(SDIO_TypeDef *SDIO, PSPDIO_ADAPTER pSPDIODev, struct spdio_buf_t *pbuf);
+u16 SPDIO_DeviceTxBatch(SDIO_TypeDef *SDIO, PSPDIO_ADAPTER pSPDIODev, struct spdio_buf_t **pbuf, u16 num, u16 agg_thres);
 void SPDIO_TxBd_DataReady_DeviceRx(SDIO_TypeDef *SDIO, PSPDIO_ADAPTER pSPDIODev, spdio_device_rx_done_cb_ptr spdio_device_rx_done_cb);
+void SPDIO_RxPool_Init(SPDIO_RX_POOL *pool, struct spdio_buf_t **ring, u16 ring_num, struct spdio_buf_t *spare, u16 spare_num, u16 bufsz);
+u8 SPDIO_RxPool_Recycle(SPDIO_RX_POOL *pool, struct spdio_buf_t **buf, u16 num);
+void SPDIO_TxBd_DataReady_DeviceRxPool(SDIO_TypeDef *SDIO, PSPDIO_ADAPTER pSPDIODev, SPDIO_RX_POOL *pool,
+									   spdio_device_rx_done_cb_ptr spdio_device_rx_done_cb);
+void SPDIO_RxPool_GetStats(SPDIO_RX_POOL *pool, SPDIO_RX_POOL_STATS *Stats);
 void SPDIO_Device_Init(SDIO_TypeDef *SDIO, PSPDIO_ADAPTER pSPDIODev);
 void SPDIO_Device_DeInit(SDIO_TypeDef *SDIO);
 #endif
@@ -523,6 +523,19 @@ typedef struct {
 	IRQn_Type IrqNum;
 } SPI_DevTable;
 
+#define SPI_CLK_RATE_MAX		4	/*!< source clock rates of one SPI_ClkBindTypeDef */
+
+/**
+  * @brief  SPI master clock divider kept across clock rate changes, see SSI_ClkBind()
+  */
+typedef struct {
+	CLK_NotifierTypeDef Notifier;
+	SPI_TypeDef *spi_dev;
+	u32 ClkId;						/*!< clock tree node of ssi_clk, @ref CLK_Tree_Node */
+	u32 Num;
+	CLK_DivEntry Div[SPI_CLK_RATE_MAX];	/*!< SCKDV for each source rate */
+} SPI_ClkBindTypeDef;
+
 /**
   * @}
   */
@@ -670,6 +683,8 @@ _LONG_CALL_ void SSI_SetBaud(SPI_TypeDef *SPIx, u32 BaudRate, u32 IpClk);
 _LONG_CALL_ void SSI_SetIsrClean(SPI_TypeDef *spi_dev, u32 InterruptStatus);
 _LONG_CALL_ void SSI_SetReadLen(SPI_TypeDef *spi_dev, u32 DataFrameNumber);
 _LONG_CALL_ void SSI_SetBaudDiv(SPI_TypeDef *spi_dev, u32 ClockDivider);
+_LONG_CALL_ int SSI_ClkBind(SPI_ClkBindTypeDef *Bind, SPI_TypeDef *spi_dev, u32 BaudRate, u32 ClkId, const u32 *SrcHz, u32 Num);
+_LONG_CALL_ void SSI_ClkUnbind(SPI_ClkBindTypeDef *Bind);
 _LONG_CALL_ void SSI_SetRole(SPI_TypeDef *spi_dev, u32 role);
 
 
@@ -353,6 +353,7 @@ _LONG_CALL_ void TM_HighWtConfig(u16 TM_HighWtThre, u32 NewState);
 _LONG_CALL_ void TM_LowWtConfig(u16 TM_LowWtThre, u32 NewState);
 _LONG_CALL_ float TM_GetCdegree(u32 Data);
 _LONG_CALL_ float TM_GetFdegree(u32 Data);
+_LONG_CALL_ bool TM_GetCdegreeInt(s32 *Cdegree);
 
 /* MANUAL_GEN_END */
 
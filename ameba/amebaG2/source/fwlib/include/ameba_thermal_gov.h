@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _AMEBA_THERMAL_GOV_H_
+#define _AMEBA_THERMAL_GOV_H_
+
+/** @addtogroup Ameba_Periph_Driver
+  * @{
+  */
+
+/** @defgroup TM_GOV
+  * @brief TM_GOV driver modules
+  * @verbatim
+  *****************************************************************************************
+  * Introduction
+  *****************************************************************************************
+  * Thermal clock governor on top of the thermal meter and the HP/HPERI clock dividers:
+  *		- the user provides a table of levels, level 0 is the nominal clock and each next
+  *		  level runs slower and is entered at a higher temperature
+  *		- the thermal high/low warning thresholds always bracket the current level: high
+  *		  warning at the entry temperature of the next level, low warning at the entry
+  *		  temperature of the current level minus the hysteresis. There is no polling, the
+  *		  warning interrupt moves the window and flags the new level
+  *		- the divider change itself runs in TM_GOV_Process() (task context) through
+  *		  CLK_DivSetNotify(), so the clock tree cache follows and drivers registered by
+  *		  CLK_NotifierRegister() for CLK_ID_CPU or CLK_ID_HPERI quiesce, or veto, before
+  *		  the change and reprogram their dividers after it
+  *
+  * Only the dividers change, the PLL source of CPU and HPERI stays as set up by the boot
+  * code. Core voltage is not touched. The DelayUs calibration follows the CPU clock, an OS
+  * tick derived from the CPU clock shall be reloaded by a CLK_EVT_POST_CHANGE notifier.
+  *
+  *****************************************************************************************
+  * How to use
+  *****************************************************************************************
+  *		1. Initialize the thermal meter by TM_Init() and enable it.
+  *		2. Fill a TM_GOV_InitTypeDef by TM_GOV_StructInit(), set the level table and
+  *		   call TM_GOV_Init().
+  *		3. Register driver callbacks by CLK_NotifierRegister(), or I2C_ClkBind()/SSI_ClkBind().
+  *		4. Call TM_GOV_IRQHandler() from the thermal interrupt handler. When it returns
+  *		   TRUE, or from TM_GOV_PendingCb, wake the task that calls TM_GOV_Process().
+  *
+  *****************************************************************************************
+  * @endverbatim
+  * @{
+  */
+
+/* Exported constants --------------------------------------------------------*/
+/** @defgroup TM_GOV_Exported_Constants TM_GOV Exported Constants
+  * @{
+  */
+
+#define TM_GOV_LEVEL_MAX			8
+#define TM_GOV_HYST_DEF				5			/*!< degrees Celsius */
+
+/** @} */
+
+/* Exported types ------------------------------------------------------------*/
+/** @defgroup TM_GOV_Exported_Types TM_GOV Exported Types
+  * @{
+  */
+
+/**
+  * @brief  TM_GOV level definition
+  */
+typedef struct {
+	s16 TempEnter;				/*!< degrees Celsius, level 0 ignores it, must increase with the level */
+	u8 CpuDiv;					/*!< HP divider of the CPU PLL, 1 ~ 16 */
+	u8 HperiDiv;				/*!< HPERI divider of the HPERI PLL, 1 ~ 16 */
+} TM_GOV_LevelDef;
+
+/**
+  * @brief  TM_GOV statistics
+  */
+typedef struct {
+	u32 Irqs;					/*!< warning interrupts handled */
+	u32 Throttles;				/*!< level changes to a slower level */
+	u32 Restores;				/*!< level changes to a faster level */
+	u32 Vetoes;					/*!< level changes refused by a clock notifier */
+	s32 TempLast;				/*!< degrees Celsius */
+	s32 TempMax;
+	u32 ChangeMaxUs;			/*!< longest divider change including notifiers */
+	u64 LevelTimeUs[TM_GOV_LEVEL_MAX];	/*!< time spent in each level, current level up to the last change */
+} TM_GOV_StatsTypeDef;
+
+/**
+  * @brief  TM_GOV init structure definition
+  */
+typedef struct {
+	const TM_GOV_LevelDef *TM_GovTable;
+	u32 TM_GovLevelNum;			/*!< 2 ~ TM_GOV_LEVEL_MAX */
+	u32 TM_GovHyst;				/*!< degrees Celsius below the entry temperature to leave a level */
+	void (*TM_GovPendingCb)(void *Data);	/*!< optional, called in ISR when a level change is pending */
+	void *TM_GovCbData;
+} TM_GOV_InitTypeDef;
+
+/**
+  * @brief  TM_GOV instance
+  */
+typedef struct {
+	TM_GOV_InitTypeDef Cfg;
+	u8 Level;					/*!< level the clocks run at */
+	volatile u8 Target;			/*!< level requested by the thermal window */
+	u8 CpuSysPll;				/*!< CPU divider is on SYS PLL, else USB PLL */
+	u8 HperiSysPll;
+	s16 TargetTemp;
+	u16 Rsvd;
+	u32 LevelStart;				/*!< timestamp of the last level change */
+	TM_GOV_StatsTypeDef Stats;
+} TM_GOV_TypeDef;
+
+/** @} */
+
+/* Exported functions --------------------------------------------------------*/
+/** @defgroup TM_GOV_Exported_Functions TM_GOV Exported Functions
+  * @{
+  */
+void TM_GOV_StructInit(TM_GOV_InitTypeDef *TM_GovInitStruct);
+int TM_GOV_Init(TM_GOV_TypeDef *gov, TM_GOV_InitTypeDef *TM_GovInitStruct);
+bool TM_GOV_IRQHandler(TM_GOV_TypeDef *gov);
+int TM_GOV_Process(TM_GOV_TypeDef *gov);
+u32 TM_GOV_GetLevel(TM_GOV_TypeDef *gov);
+void TM_GOV_GetStats(TM_GOV_TypeDef *gov, TM_GOV_StatsTypeDef *Stats);
+/** @} */
+
+/** @} */
+
+/** @} */
+
+#endif
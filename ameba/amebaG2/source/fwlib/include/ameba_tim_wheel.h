@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _AMEBA_TIM_WHEEL_H_
+#define _AMEBA_TIM_WHEEL_H_
+
+/** @addtogroup Ameba_Periph_Driver
+  * @{
+  */
+
+/** @defgroup RTIM_WHEEL
+  * @brief RTIM_WHEEL driver modules
+  * @verbatim
+  *****************************************************************************************
+  * Introduction
+  *****************************************************************************************
+  * Software timers multiplexed on one basic timer (TIM0~TIM3):
+  *		- a hierarchical wheel of RTIM_WHEEL_LVL_NUM levels of 32 slots, a timer is linked
+  *		  into the slot of its expiry tick at the level matching its distance, and moved
+  *		  down a level when the wheel reaches the slot. Start and stop are O(1), the timer
+  *		  structures are owned by the caller and nothing is allocated
+  *		- each level keeps a bitmap of its non empty slots, the next tick to process is
+  *		  found by a bit scan, so the wheel jumps over idle ticks instead of stepping
+  *		- tickless: the timer update event is moved to the next tick to process by
+  *		  rewriting the auto-reload register, the counter itself is never reset, so the
+  *		  time base does not drift. With no timer the timer still wakes up every
+  *		  RTIM_WHEEL_SLEEP_MAX ticks
+  *		- the lateness of every expiry, interrupt time minus expiry tick, is recorded
+  *
+  * The tick is the counter clock of the timer: 1MHz on the XTAL source, or 32.768KHz.
+  * Callbacks are called from the timer interrupt, they may start and stop any timer.
+  *
+  *****************************************************************************************
+  * How to use
+  *****************************************************************************************
+  *		1. Enable the timer clock by RCC_PeriphClockCmd() and select its clock source.
+  *		2. Fill a RTIM_WHEEL_InitTypeDef by RTIM_WHEEL_StructInit(), set the timer index
+  *		   and call RTIM_WHEEL_Init(). It starts the counter.
+  *		3. Call RTIM_WHEEL_IRQHandler() from the timer interrupt handler.
+  *		4. Set each timer up once by RTIM_WHEEL_TimerInit(), then arm it by
+  *		   RTIM_WHEEL_Start() as one-shot (Period 0) or periodic, and cancel it by
+  *		   RTIM_WHEEL_Stop(). RTIM_WHEEL_UsToTicks() converts times to ticks.
+  *
+  *****************************************************************************************
+  * @endverbatim
+  * @{
+  */
+
+/* Exported constants --------------------------------------------------------*/
+/** @defgroup RTIM_WHEEL_Exported_Constants RTIM_WHEEL Exported Constants
+  * @{
+  */
+
+#define RTIM_WHEEL_LVL_BITS			5
+#define RTIM_WHEEL_LVL_SLOTS		(1 << RTIM_WHEEL_LVL_BITS)
+#define RTIM_WHEEL_LVL_NUM			5
+#define RTIM_WHEEL_RANGE			(1UL << (RTIM_WHEEL_LVL_BITS * RTIM_WHEEL_LVL_NUM))	/*!< ticks, further timers are re-filed on the way */
+#define RTIM_WHEEL_SLEEP_MAX		(1UL << 24)	/*!< longest time between two timer interrupts, ticks */
+#define RTIM_WHEEL_DELAY_MAX		(1UL << 30)	/*!< longest delay or period, ticks */
+#define RTIM_WHEEL_MARGIN			4		/*!< closest update event from the current count, ticks */
+
+#define RTIM_WHEEL_IDLE				0xFF	/*!< timer Level when not armed */
+#define RTIM_WHEEL_FIRING			0xFE	/*!< timer Level while on the expiry list */
+
+/** @} */
+
+/* Exported types ------------------------------------------------------------*/
+/** @defgroup RTIM_WHEEL_Exported_Types RTIM_WHEEL Exported Types
+  * @{
+  */
+
+/**
+  * @brief  RTIM_WHEEL software timer
+  */
+typedef struct RTIM_WHEEL_Timer {
+	struct RTIM_WHEEL_Timer *Next;
+	struct RTIM_WHEEL_Timer **Pprev;	/*!< link pointing to this timer, for O(1) unlink */
+	u32 Expire;					/*!< expiry tick */
+	u32 Period;					/*!< ticks, 0 for one-shot */
+	void (*Cb)(void *Data);
+	void *Data;
+	u8 Level;					/*!< wheel level, RTIM_WHEEL_IDLE or RTIM_WHEEL_FIRING */
+	u8 Slot;
+} RTIM_WHEEL_TimerTypeDef;
+
+/**
+  * @brief  RTIM_WHEEL statistics
+  */
+typedef struct {
+	u32 Active;					/*!< timers armed */
+	u32 Fired;					/*!< expiries, periodic ones included */
+	u32 Late;					/*!< expiries later than RTIM_WheelLateTolUs */
+	u32 LateMaxUs;
+	u32 LateAvgUs;
+	u32 Cascades;				/*!< timers moved down a level */
+	u32 Irqs;
+} RTIM_WHEEL_StatsTypeDef;
+
+/**
+  * @brief  RTIM_WHEEL init structure definition
+  */
+typedef struct {
+	u32 RTIM_WheelTimIdx;		/*!< 0 ~ 3, basic timers only */
+	u32 RTIM_WheelLateTolUs;	/*!< lateness counted in Late beyond this */
+} RTIM_WHEEL_InitTypeDef;
+
+/**
+  * @brief  RTIM_WHEEL instance
+  */
+typedef struct {
+	RTIM_WHEEL_InitTypeDef Cfg;
+	RTIM_TypeDef *TIMx;
+	u32 TickHz;
+	u32 LateTol;				/*!< ticks */
+	u32 Now;					/*!< next tick the wheel processes */
+	u32 Base;					/*!< tick of the last counter reload */
+	u32 Arr;					/*!< auto-reload value programmed */
+	u32 Next;					/*!< tick of the programmed update event */
+	u8 InIrq;
+	u32 Map[RTIM_WHEEL_LVL_NUM];	/*!< non empty slots */
+	RTIM_WHEEL_TimerTypeDef *Slot[RTIM_WHEEL_LVL_NUM][RTIM_WHEEL_LVL_SLOTS];
+	u64 LateSum;				/*!< ticks */
+	u32 LateMax;				/*!< ticks */
+	RTIM_WHEEL_StatsTypeDef Stats;
+} RTIM_WHEEL_TypeDef;
+
+/** @} */
+
+/* Exported functions --------------------------------------------------------*/
+/** @defgroup RTIM_WHEEL_Exported_Functions RTIM_WHEEL Exported Functions
+  * @{
+  */
+void RTIM_WHEEL_StructInit(RTIM_WHEEL_InitTypeDef *RTIM_WheelInitStruct);
+int RTIM_WHEEL_Init(RTIM_WHEEL_TypeDef *wheel, RTIM_WHEEL_InitTypeDef *RTIM_WheelInitStruct);
+void RTIM_WHEEL_DeInit(RTIM_WHEEL_TypeDef *wheel);
+u32 RTIM_WHEEL_GetTime(RTIM_WHEEL_TypeDef *wheel);
+u32 RTIM_WHEEL_UsToTicks(RTIM_WHEEL_TypeDef *wheel, u32 Us);
+void RTIM_WHEEL_TimerInit(RTIM_WHEEL_TimerTypeDef *Timer, void (*Cb)(void *Data), void *Data);
+int RTIM_WHEEL_Start(RTIM_WHEEL_TypeDef *wheel, RTIM_WHEEL_TimerTypeDef *Timer, u32 Delay, u32 Period);
+void RTIM_WHEEL_Stop(RTIM_WHEEL_TypeDef *wheel, RTIM_WHEEL_TimerTypeDef *Timer);
+bool RTIM_WHEEL_IsActive(RTIM_WHEEL_TimerTypeDef *Timer);
+void RTIM_WHEEL_IRQHandler(RTIM_WHEEL_TypeDef *wheel);
+void RTIM_WHEEL_GetStats(RTIM_WHEEL_TypeDef *wheel, RTIM_WHEEL_StatsTypeDef *Stats);
+/** @} */
+
+/** @} */
+
+/** @} */
+
+#endif
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _AMEBA_UVC_STREAM_H_
+#define _AMEBA_UVC_STREAM_H_
+
+/** @addtogroup Ameba_Periph_Driver
+  * @{
+  */
+
+/** @defgroup UVC_STREAM
+  * @brief UVC_STREAM driver modules
+  * @verbatim
+  *****************************************************************************************
+  * Introduction
+  *****************************************************************************************
+  * Frame streaming on top of one UVC channel:
+  *		- the user provides N frame buffers, two of them are armed in the channel BUF0/BUF1
+  *		  slots, the others wait in a free ring
+  *		- on frame done the interrupt handler records size, PTS and SCR of the slot, queues
+  *		  the buffer itself to the ready ring and re-arms the slot with a free buffer, so
+  *		  frames are handed over without copying and the channel never waits for the task
+  *		- when no free buffer is left the slot is re-armed with the buffer just filled and
+  *		  the frame is dropped. Oversize and header error frames are dropped the same way.
+  *		  Every frame done event takes a sequence number, a gap in Seq tells the consumer
+  *		  how many frames were lost
+  *		- the frame interval is taken from the PTS when UVC_StreamPtsHz is set (the
+  *		  dwClockFrequency of the device), else from the interrupt timestamp, and averaged
+  *		  with its jitter (mean absolute deviation)
+  *
+  *****************************************************************************************
+  * How to use
+  *****************************************************************************************
+  *		1. Allocate the channel by UVC_AllocChannel() and set it up by UVC_ChnlInit().
+  *		2. Fill an UVC_STREAM_InitTypeDef by UVC_STREAM_StructInit(), set the channel and
+  *		   the buffers and call UVC_STREAM_Init(). It arms the slots and unmasks the
+  *		   channel interrupts.
+  *		3. Call UVC_STREAM_IRQHandler() from the UVC interrupt handler, one call per
+  *		   stream, and wake the consumer when it returns non-zero.
+  *		4. Take frames by UVC_STREAM_FrameGet() and give each buffer back by
+  *		   UVC_STREAM_FrameRelease() once consumed.
+  *
+  *****************************************************************************************
+  * @endverbatim
+  * @{
+  */
+
+/* Exported constants --------------------------------------------------------*/
+/** @defgroup UVC_STREAM_Exported_Constants UVC_STREAM Exported Constants
+  * @{
+  */
+
+#define UVC_STREAM_BUF_MAX			16		/*!< frame buffers per stream, power of 2 */
+#define UVC_STREAM_BUF_MIN			3		/*!< two armed and one with the consumer */
+
+/** @} */
+
+/* Exported types ------------------------------------------------------------*/
+/** @defgroup UVC_STREAM_Exported_Types UVC_STREAM Exported Types
+  * @{
+  */
+
+/**
+  * @brief  UVC_STREAM frame handed to the consumer
+  */
+typedef struct {
+	u8 *Buf;
+	u32 Size;					/*!< payload bytes in Buf */
+	u32 Seq;					/*!< frame done sequence number, dropped frames included */
+	u32 PTS;
+	u32 SCRFirst;
+	u32 SCRLast;
+	u32 TimeUs;					/*!< DTimestamp at frame done */
+} UVC_STREAM_FrameTypeDef;
+
+/**
+  * @brief  UVC_STREAM statistics
+  */
+typedef struct {
+	u32 Frames;					/*!< frames handed to the consumer */
+	u32 Overflows;				/*!< frames dropped for lack of a free buffer */
+	u32 Oversize;
+	u32 HeaderErr;
+	u32 IntervalUs;				/*!< average frame interval */
+	u32 IntervalMinUs;
+	u32 IntervalMaxUs;
+	u32 JitterUs;				/*!< average deviation of the frame interval */
+	u32 FpsX100;				/*!< frame rate from IntervalUs */
+	u32 MinFree;				/*!< lowest number of free buffers seen */
+} UVC_STREAM_StatsTypeDef;
+
+/**
+  * @brief  UVC_STREAM init structure definition
+  */
+typedef struct {
+	u32 UVC_StreamChn;
+	u8 **UVC_StreamBuf;			/*!< frame buffers, cache line aligned */
+	u32 UVC_StreamBufNum;		/*!< UVC_STREAM_BUF_MIN ~ UVC_STREAM_BUF_MAX */
+	u32 UVC_StreamBufSize;		/*!< bytes per buffer, multiple of the cache line */
+	u32 UVC_StreamPtsHz;		/*!< PTS clock, 0 to time frames by the interrupt timestamp */
+} UVC_STREAM_InitTypeDef;
+
+/**
+  * @brief  UVC_STREAM instance
+  */
+typedef struct {
+	UVC_STREAM_InitTypeDef Cfg;
+	u8 *Armed[UVC_MAX_BUF_NUM];	/*!< buffer in each channel slot */
+	u8 Slot;					/*!< slot the channel fills next */
+	u8 Timed;					/*!< a previous frame time is known */
+	u16 Rsvd;
+	volatile u16 FreeHead;		/*!< written by UVC_STREAM_FrameRelease */
+	volatile u16 FreeTail;		/*!< written by UVC_STREAM_IRQHandler */
+	volatile u16 ReadyHead;		/*!< written by UVC_STREAM_IRQHandler */
+	volatile u16 ReadyTail;		/*!< written by UVC_STREAM_FrameGet */
+	u8 *Free[UVC_STREAM_BUF_MAX];
+	UVC_STREAM_FrameTypeDef Ready[UVC_STREAM_BUF_MAX];
+	u32 Seq;
+	u32 LastTime;				/*!< PTS or timestamp of the previous frame */
+	s32 IntervalQ4;				/*!< averages in 1/16 us */
+	s32 JitterQ4;
+	UVC_STREAM_StatsTypeDef Stats;
+} UVC_STREAM_TypeDef;
+
+/** @} */
+
+/* Exported functions --------------------------------------------------------*/
+/** @defgroup UVC_STREAM_Exported_Functions UVC_STREAM Exported Functions
+  * @{
+  */
+void UVC_STREAM_StructInit(UVC_STREAM_InitTypeDef *UVC_StreamInitStruct);
+int UVC_STREAM_Init(UVC_STREAM_TypeDef *stream, UVC_STREAM_InitTypeDef *UVC_StreamInitStruct);
+void UVC_STREAM_DeInit(UVC_STREAM_TypeDef *stream);
+u32 UVC_STREAM_IRQHandler(UVC_STREAM_TypeDef *stream);
+int UVC_STREAM_FrameGet(UVC_STREAM_TypeDef *stream, UVC_STREAM_FrameTypeDef *Frame);
+int UVC_STREAM_FrameRelease(UVC_STREAM_TypeDef *stream, u8 *Buf);
+void UVC_STREAM_GetStats(UVC_STREAM_TypeDef *stream, UVC_STREAM_StatsTypeDef *Stats);
+/** @} */
+
+/** @} */
+
+/** @} */
+
+#endif
@@ -38,6 +38,55 @@ const u32 i2s_clock_source[3] = {PLL_CLOCK_98P304M, PLL_CLOCK_45P1584M, I2S_CLOC
   * @{
   */
 
+static u32 audio_clock_gcd(u32 a, u32 b)
+{
+	u32 t;
+
+	while (b) {
+		t = a % b;
+		a = b;
+		b = t;
+	}
+
+	return a;
+}
+
+/**
+  * @brief  Get the smallest sport NI/MI pair for the given clock and frame format.
+  * @param	clock: audio clock.
+  * @param  sr: sport sample rate.
+  * @param  chn_len: sport channel length.
+  * @param  chn_cnt: sport channel number.
+  * @param  ni: output, MCLK_NI.
+  * @param  mi: output, MCLK_MI.
+  * @retval ni_mi_found:0/1
+  * @note   BCLK = clock * ni / mi must be chn_cnt * chn_len * sr. With g = gcd(clock, bclk),
+  *         every solution is ni = k * bclk / g, mi = k * clock / g, so the ratio mi / ni is
+  *         fixed and k = 1 is the only candidate within the register ranges.
+  */
+bool Audio_Clock_NiMiGet(u32 clock, u32 sr, u32 chn_len, u32 chn_cnt, u32 *ni, u32 *mi)
+{
+	u32 max_ni = 32767;
+	u32 max_mi = 65535;
+	u32 bclk = chn_cnt * chn_len * sr;
+	u32 g;
+
+	if (clock == 0 || bclk == 0) {
+		return 0;
+	}
+
+	g = audio_clock_gcd(clock, bclk);
+	*ni = bclk / g;
+	*mi = clock / g;
+
+	/* mi < 2 * ni means BCLK above half the clock */
+	if (*ni > max_ni || *mi > max_mi || *mi < 2 * *ni) {
+		return 0;
+	}
+
+	return 1;
+}
+
 /**
   * @brief  Determine whether the clock can be divided normally.
   * @param	clock: audio clock.
@@ -48,29 +97,9 @@ const u32 i2s_clock_source[3] = {PLL_CLOCK_98P304M, PLL_CLOCK_45P1584M, I2S_CLOC
   */
 bool is_sport_ni_mi_supported(u32 clock, u32 sr, u32 chn_len, u32 chn_cnt)
 {
-	int ni = 1;
-	int mi = 1;
-	int max_ni = 32767;
-	int max_mi = 65535;
-	bool ni_mi_found = 0;
-
-	for (; ni <= max_ni ; ni++) {
-		if (clock * ni % (chn_cnt * chn_len * sr) == 0) {
-			mi = clock * ni / (chn_cnt * chn_len * sr);
-			//printf("check founded: ni : %d, mi: %d \n", ni, mi);
-			if (mi < 2 * ni) {
-				//printf("mi <= ni, check fail, try another pll divider or sport mclk divider \n");
-				break;
-			}
-			if (mi <= max_mi) {
-				//printf("check ni : %d, mi: %d success\n", ni, mi);
-				ni_mi_found = 1;
-				break;
-			}
-		}
-	}
+	u32 ni, mi;
 
-	return ni_mi_found;
+	return Audio_Clock_NiMiGet(clock, sr, chn_len, chn_cnt, &ni, &mi);
 }
 
 /**
@@ -87,6 +116,7 @@ void Audio_Clock_Choose(u32 clock_sel, AUDIO_InitParams *initparams, AUDIO_Clock
 	u32 NI = 1;
 	u32 MI = 1;
 	u32 clock = 0;
+	u32 pow2;
 
 	if (clock_sel == PLL_CLK) {
 		if (initparams->codec_multiplier_with_rate && initparams->sport_mclk_fixed_max) {
@@ -126,16 +156,15 @@ void Audio_Clock_Choose(u32 clock_sel, AUDIO_InitParams *initparams, AUDIO_Clock
 				clock_index = 1;
 			}
 
-			for (; MI < 65536; MI = MI + 1) {
-				if ((clock / MI  <= initparams->sport_mclk_fixed_max) && ((MI & (MI - 1)) == 0)) {
-					if (is_sport_ni_mi_supported(clock, initparams->sr, initparams->chn_len, initparams->chn_cnt)) {
-						choose_done = 1;
-					}
-					break;
+			/* smallest power of two MI, not below the current one, that meets the limit */
+			for (pow2 = 1; pow2 < MI; pow2 <<= 1);
+			MI = pow2;
+			while (MI < 65536 && clock / MI > initparams->sport_mclk_fixed_max) {
+				MI <<= 1;
+			}
 
-				} else {
-					continue;
-				}
+			if (MI < 65536 && is_sport_ni_mi_supported(clock, initparams->sr, initparams->chn_len, initparams->chn_cnt)) {
+				choose_done = 1;
 			}
 		}
 
@@ -0,0 +1,462 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ameba_soc.h"
+
+static const char *const TAG = "CTPIPE";
+
+/** @addtogroup Ameba_Periph_Driver
+  * @{
+  */
+
+/** @defgroup CT_PIPE
+  * @brief CT_PIPE driver modules
+  * @{
+  */
+
+static void ct_pipe_event(CT_PIPE_TypeDef *pipe, u8 Event, u32 Arg)
+{
+	if (pipe->Cfg.CT_PipeEventCb) {
+		pipe->Cfg.CT_PipeEventCb(pipe->Cfg.CT_PipeCbData, Event, Arg);
+	}
+}
+
+static void ct_pipe_release(CT_PIPE_TypeDef *pipe, u8 Channel)
+{
+	CT_PIPE_ChState *st = &pipe->Ch[Channel];
+
+	st->Touched = 0;
+	st->Debounce = 0;
+	pipe->TouchMask &= ~BIT(Channel);
+	pipe->Stats.Releases++;
+	ct_pipe_event(pipe, CT_PIPE_EVT_RELEASE, Channel);
+}
+
+static void ct_pipe_channel(CT_PIPE_TypeDef *pipe, u8 Channel, u32 Data, u32 TimeUs)
+{
+	CT_PIPE_InitTypeDef *cfg = &pipe->Cfg;
+	CT_PIPE_ChState *st = &pipe->Ch[Channel];
+	s32 data = (s32)(Data << CT_PIPE_Q);
+	s32 err = data - (s32)st->Baseline;
+	s32 sig = -err >> CT_PIPE_Q;
+	u32 dev, now;
+
+	st->Signal = sig;
+
+	if (st->Touched) {
+		if (st->HeldScans != 0xFFFF) {
+			st->HeldScans++;
+		}
+		if ((u32)MAX(sig, 0) > st->Peak) {
+			st->Peak = sig;
+		}
+
+		if (cfg->CT_PipeStuckScans && st->HeldScans >= cfg->CT_PipeStuckScans) {
+			/* nobody holds a key that long, the data drifted under the baseline */
+			st->Baseline = data;
+			pipe->Stats.Reseeds++;
+			ct_pipe_release(pipe, Channel);
+		} else if (sig < (s32)(st->Thres * cfg->CT_PipeHystPercent / 100)) {
+			if (++st->Debounce >= cfg->CT_PipeDebounce) {
+				ct_pipe_release(pipe, Channel);
+			}
+		} else {
+			st->Debounce = 0;
+		}
+		return;
+	}
+
+	if (sig >= (s32)st->Thres) {
+		if (st->Debounce++ == 0) {
+			st->CrossTime = TimeUs;
+		}
+		if (st->Debounce >= cfg->CT_PipeDebounce) {
+			st->Touched = 1;
+			st->Debounce = 0;
+			st->HeldScans = 0;
+			st->Above = 0;
+			st->Peak = sig;
+			pipe->TouchMask |= BIT(Channel);
+			pipe->Stats.Presses++;
+
+			now = DTimestamp_Get();
+			pipe->Stats.DetectMaxUs = MAX(pipe->Stats.DetectMaxUs, now - st->CrossTime);
+			ct_pipe_event(pipe, CT_PIPE_EVT_PRESS, Channel);
+		}
+		return;
+	}
+
+	st->Debounce = 0;
+
+	/* data above the baseline: the channel was touched when the baseline was taken */
+	if (err > 0) {
+		if (++st->Above >= cfg->CT_PipeReseedScans) {
+			st->Baseline = data;
+			st->Above = 0;
+			pipe->Stats.Reseeds++;
+			return;
+		}
+	} else {
+		st->Above = 0;
+	}
+
+	dev = (u32)(err < 0 ? -err : err);
+	if ((dev >> CT_PIPE_Q) < st->Thres) {
+		st->Noise = (u32)((s32)st->Noise + (((s32)dev - (s32)st->Noise) >> cfg->CT_PipeNoiseShift));
+	}
+
+	st->Baseline = (u32)((s32)st->Baseline + (err >> cfg->CT_PipeDriftShift));
+}
+
+static s32 ct_pipe_slider_sig(CT_PIPE_TypeDef *pipe, s32 Idx)
+{
+	CT_PIPE_InitTypeDef *cfg = &pipe->Cfg;
+	s32 num = (s32)cfg->CT_PipeSliderNum;
+
+	if (cfg->CT_PipeSliderType == CT_PIPE_SLIDER_WHEEL) {
+		Idx = (Idx + num) % num;
+	} else if (Idx < 0 || Idx >= num) {
+		return 0;
+	}
+
+	return MAX(pipe->Ch[cfg->CT_PipeSliderCh[Idx]].Signal, 0);
+}
+
+static void ct_pipe_slider(CT_PIPE_TypeDef *pipe, u32 TimeUs)
+{
+	CT_PIPE_InitTypeDef *cfg = &pipe->Cfg;
+	s32 num = (s32)cfg->CT_PipeSliderNum;
+	s32 range = num * CT_PIPE_SLIDER_STEP;
+	s32 i, peak = 0, prev, cur, next, sum, pos, travel;
+	u32 touched = 0;
+
+	for (i = 0; i < num; i++) {
+		touched |= pipe->TouchMask & BIT(cfg->CT_PipeSliderCh[i]);
+		if (pipe->Ch[cfg->CT_PipeSliderCh[i]].Signal > pipe->Ch[cfg->CT_PipeSliderCh[peak]].Signal) {
+			peak = i;
+		}
+	}
+
+	if (!touched) {
+		if (pipe->SliderPos == CT_PIPE_POS_NONE) {
+			return;
+		}
+
+		travel = (s32)pipe->SliderPos - (s32)pipe->SwipeStart;
+		if (cfg->CT_PipeSliderType == CT_PIPE_SLIDER_WHEEL) {
+			if (travel > range / 2) {
+				travel -= range;
+			} else if (travel < -range / 2) {
+				travel += range;
+			}
+		}
+
+		if ((u32)(travel < 0 ? -travel : travel) >= cfg->CT_PipeSwipeDist &&
+			TimeUs - pipe->SwipeTime <= cfg->CT_PipeSwipeTimeUs) {
+			ct_pipe_event(pipe, travel > 0 ? CT_PIPE_EVT_SWIPE_UP : CT_PIPE_EVT_SWIPE_DOWN, travel < 0 ? -travel : travel);
+		}
+
+		pipe->SliderPos = CT_PIPE_POS_NONE;
+		return;
+	}
+
+	/* centroid of the peak channel and its two neighbours */
+	prev = ct_pipe_slider_sig(pipe, peak - 1);
+	cur = ct_pipe_slider_sig(pipe, peak);
+	next = ct_pipe_slider_sig(pipe, peak + 1);
+	sum = prev + cur + next;
+
+	pos = peak * CT_PIPE_SLIDER_STEP;
+	if (sum > 0) {
+		pos += (next - prev) * (s32)CT_PIPE_SLIDER_STEP / sum;
+	}
+
+	if (cfg->CT_PipeSliderType == CT_PIPE_SLIDER_WHEEL) {
+		pos = (pos + range) % range;
+	} else {
+		pos = MAX(pos, 0);
+		pos = MIN(pos, range - (s32)CT_PIPE_SLIDER_STEP);
+	}
+
+	if (pipe->SliderPos == CT_PIPE_POS_NONE) {
+		pipe->SwipeStart = pos;
+		pipe->SwipeTime = TimeUs;
+	}
+
+	if ((u32)pos != pipe->SliderPos) {
+		pipe->SliderPos = pos;
+		ct_pipe_event(pipe, CT_PIPE_EVT_SLIDE, pos);
+	}
+}
+
+/**
+  * @brief  Fill each CT_PIPE_InitStruct member with its default value.
+  * @param  CT_PipeInitStruct: pointer to a CT_PIPE_InitTypeDef structure which will be initialized.
+  * @retval None
+  */
+void CT_PIPE_StructInit(CT_PIPE_InitTypeDef *CT_PipeInitStruct)
+{
+	_memset((void *)CT_PipeInitStruct, 0, sizeof(CT_PIPE_InitTypeDef));
+
+	CT_PipeInitStruct->CapTouch = CAPTOUCH_DEV;
+	CT_PipeInitStruct->CT_PipeDriftShift = 6;
+	CT_PipeInitStruct->CT_PipeNoiseShift = 4;
+	CT_PipeInitStruct->CT_PipeDebounce = 2;
+	CT_PipeInitStruct->CT_PipeHystPercent = 70;
+	CT_PipeInitStruct->CT_PipeStuckScans = 20000;
+	CT_PipeInitStruct->CT_PipeReseedScans = 32;
+	CT_PipeInitStruct->CT_PipeSNR = 5;
+	CT_PipeInitStruct->CT_PipeThresPercent = 80;
+	CT_PipeInitStruct->CT_PipeEtcNoiseMul = 3;
+	CT_PipeInitStruct->CT_PipeSliderType = CT_PIPE_SLIDER_LINEAR;
+	CT_PipeInitStruct->CT_PipeSwipeDist = 2 * CT_PIPE_SLIDER_STEP;
+	CT_PipeInitStruct->CT_PipeSwipeTimeUs = 500000;
+}
+
+/**
+  * @brief  Initialize the pipeline and enable the scan end interrupt.
+  * @param  pipe: pipeline instance.
+  * @param  CT_PipeInitStruct: pointer to a CT_PIPE_InitTypeDef structure.
+  * @retval RTK_SUCCESS or RTK_ERR_BADARG
+  * @note   Baselines start from the hardware baselines and thresholds from the
+  *         hardware difference thresholds, so call it after CapTouch_Init().
+  */
+int CT_PIPE_Init(CT_PIPE_TypeDef *pipe, CT_PIPE_InitTypeDef *CT_PipeInitStruct)
+{
+	u32 i;
+	u8 ch;
+
+	assert_param(IS_CAPTOUCH_ALL_PERIPH(CT_PipeInitStruct->CapTouch));
+
+	if (CT_PipeInitStruct->CT_PipeRing == NULL || CT_PipeInitStruct->CT_PipeRingNum == 0 ||
+		(CT_PipeInitStruct->CT_PipeRingNum & (CT_PipeInitStruct->CT_PipeRingNum - 1)) ||
+		CT_PipeInitStruct->CT_PipeChMask == 0 || (CT_PipeInitStruct->CT_PipeChMask >> CT_CHANNEL_NUM) ||
+		CT_PipeInitStruct->CT_PipeSliderNum == 1 || CT_PipeInitStruct->CT_PipeSliderNum > CT_PIPE_SLIDER_MAX) {
+		return RTK_ERR_BADARG;
+	}
+
+	for (i = 0; i < CT_PipeInitStruct->CT_PipeSliderNum; i++) {
+		if (!IS_CT_CHANNEL(CT_PipeInitStruct->CT_PipeSliderCh[i]) ||
+			!(CT_PipeInitStruct->CT_PipeChMask & BIT(CT_PipeInitStruct->CT_PipeSliderCh[i]))) {
+			RTK_LOGE(TAG, "Slider channel %d not tracked\n", CT_PipeInitStruct->CT_PipeSliderCh[i]);
+			return RTK_ERR_BADARG;
+		}
+	}
+
+	_memset((void *)pipe, 0, sizeof(CT_PIPE_TypeDef));
+	pipe->Cfg = *CT_PipeInitStruct;
+	pipe->Cfg.CT_PipeDebounce = MAX(pipe->Cfg.CT_PipeDebounce, 1);
+	pipe->SliderPos = CT_PIPE_POS_NONE;
+
+	for (ch = 0; ch < CT_CHANNEL_NUM; ch++) {
+		if (pipe->Cfg.CT_PipeChMask & BIT(ch)) {
+			pipe->Ch[ch].Baseline = CapTouch_GetChBaseline(pipe->Cfg.CapTouch, ch) << CT_PIPE_Q;
+			pipe->Ch[ch].Thres = CapTouch_GetChDiffThres(pipe->Cfg.CapTouch, ch);
+		}
+	}
+
+	CapTouch_INTClearPendingBit(pipe->Cfg.CapTouch, CT_BIT_SCAN_END_CLR);
+	CapTouch_INTConfig(pipe->Cfg.CapTouch, CT_BIT_SCAN_END_INTR_EN, ENABLE);
+
+	return RTK_SUCCESS;
+}
+
+/**
+  * @brief  Snapshot all tracked channels on scan end.
+  * @param  pipe: pipeline instance.
+  * @retval Interrupt status, only the scan end interrupt is cleared here, other
+  *         bits are left to the caller.
+  */
+u32 CT_PIPE_IRQHandler(CT_PIPE_TypeDef *pipe)
+{
+	CAPTOUCH_TypeDef *CapTouch = pipe->Cfg.CapTouch;
+	u32 isr = CapTouch_GetISR(CapTouch);
+	u32 head = pipe->Head;
+	CT_PIPE_Frame *frame;
+	u8 ch;
+
+	if (!(isr & CT_BIT_SCAN_END_INTR)) {
+		return isr;
+	}
+
+	CapTouch_INTClearPendingBit(CapTouch, CT_BIT_SCAN_END_CLR);
+	pipe->Stats.Scans++;
+
+	if (head - pipe->Tail >= pipe->Cfg.CT_PipeRingNum) {
+		pipe->Stats.Overruns++;
+		return isr;
+	}
+
+	frame = &pipe->Cfg.CT_PipeRing[head & (pipe->Cfg.CT_PipeRingNum - 1)];
+	frame->TimeUs = DTimestamp_Get();
+	for (ch = 0; ch < CT_CHANNEL_NUM; ch++) {
+		if (pipe->Cfg.CT_PipeChMask & BIT(ch)) {
+			frame->Data[ch] = CT_GET_CHx_DATA_AVE(CapTouch->CT_CH[ch].CT_CHx_DATA_INF);
+		}
+	}
+
+	__DMB();
+	pipe->Head = head + 1;
+
+	return isr;
+}
+
+/**
+  * @brief  Run baseline tracking, touch detection and slider decoding on queued scans.
+  * @param  pipe: pipeline instance.
+  * @retval Number of scans processed.
+  * @note   Call it from one task only, events are reported from this context.
+  */
+u32 CT_PIPE_Process(CT_PIPE_TypeDef *pipe)
+{
+	CT_PIPE_Frame *frame;
+	u32 tail = pipe->Tail;
+	u32 cnt = 0;
+	u8 ch;
+
+	while (tail != pipe->Head) {
+		__DMB();
+		frame = &pipe->Cfg.CT_PipeRing[tail & (pipe->Cfg.CT_PipeRingNum - 1)];
+		pipe->Stats.LatencyMaxUs = MAX(pipe->Stats.LatencyMaxUs, DTimestamp_Get() - frame->TimeUs);
+
+		for (ch = 0; ch < CT_CHANNEL_NUM; ch++) {
+			if (pipe->Cfg.CT_PipeChMask & BIT(ch)) {
+				ct_pipe_channel(pipe, ch, frame->Data[ch], frame->TimeUs);
+			}
+		}
+
+		if (pipe->Cfg.CT_PipeSliderNum) {
+			ct_pipe_slider(pipe, frame->TimeUs);
+		}
+
+		pipe->Tail = ++tail;
+		cnt++;
+	}
+
+	pipe->Stats.Processed += cnt;
+
+	return cnt;
+}
+
+/**
+  * @brief  Retune the touch and environmental noise thresholds from the measured noise.
+  * @param  pipe: pipeline instance.
+  * @note   The touch threshold is CT_PipeThresPercent of the last touch peak, but never below
+  *         CT_PipeSNR times the noise. The hardware ETC noise thresholds are set to
+  *         CT_PipeEtcNoiseMul times the noise and kept under half the touch threshold.
+  *         The block is stopped once for all the channels, the baselines are reinitialized
+  *         when it restarts. Call it from the CT_PIPE_Process context.
+  * @retval None
+  */
+void CT_PIPE_AutoTune(CT_PIPE_TypeDef *pipe)
+{
+	CT_PIPE_InitTypeDef *cfg = &pipe->Cfg;
+	CAPTOUCH_TypeDef *CapTouch = cfg->CapTouch;
+	CT_PIPE_ChState *st;
+	u16 etc[CT_CHANNEL_NUM];
+	u32 noise, thres, TempVal;
+	bool ctc_is_en = FALSE;
+	u8 ch;
+
+	for (ch = 0; ch < CT_CHANNEL_NUM; ch++) {
+		if (!(cfg->CT_PipeChMask & BIT(ch))) {
+			continue;
+		}
+
+		st = &pipe->Ch[ch];
+		noise = MAX((st->Noise + BIT(CT_PIPE_Q) - 1) >> CT_PIPE_Q, 1);
+
+		thres = noise * cfg->CT_PipeSNR;
+		if (st->Peak) {
+			thres = MAX(thres, st->Peak * cfg->CT_PipeThresPercent / 100);
+		}
+		thres = MIN(thres, 0xFFF);
+
+		etc[ch] = (u16)MAX(MIN(noise * cfg->CT_PipeEtcNoiseMul, thres / 2), 1);
+		st->Thres = thres;
+
+		RTK_LOGI(TAG, "CH%d noise %lu thres %lu etc %u\n", ch, noise, thres, etc[ch]);
+	}
+
+	/* the CapTouch_SetXxxThres() helpers restart the block on each call, write all the
+	 * thresholds in one stopped window instead */
+	if (CapTouch->CT_CTC_CTRL & CT_BIT_ENABLE) {
+		CapTouch_Cmd(CapTouch, DISABLE);
+		ctc_is_en = TRUE;
+	}
+
+	for (ch = 0; ch < CT_CHANNEL_NUM; ch++) {
+		if (!(cfg->CT_PipeChMask & BIT(ch))) {
+			continue;
+		}
+
+		TempVal = CapTouch->CT_CH[ch].CT_CHx_CTRL;
+		TempVal &= ~CT_MASK_CHx_D_TOUCH_TH;
+		TempVal |= CT_CHx_D_TOUCH_TH(pipe->Ch[ch].Thres);
+		CapTouch->CT_CH[ch].CT_CHx_CTRL = TempVal;
+
+		CapTouch->CT_CH[ch].CT_CHx_NOISE_TH = CT_CHx_N_ENT(etc[ch]) | CT_CHx_P_ENT(etc[ch]);
+	}
+
+	if (ctc_is_en) {
+		CapTouch_Cmd(CapTouch, ENABLE);
+	}
+
+	pipe->Stats.Retunes++;
+}
+
+/**
+  * @brief  Get the debounced touch state.
+  * @param  pipe: pipeline instance.
+  * @retval Bit n set when channel n is touched.
+  */
+u32 CT_PIPE_GetTouchMask(CT_PIPE_TypeDef *pipe)
+{
+	return pipe->TouchMask;
+}
+
+/**
+  * @brief  Get the slider position.
+  * @param  pipe: pipeline instance.
+  * @retval 0 ~ (CT_PipeSliderNum - 1) * CT_PIPE_SLIDER_STEP for a linear slider,
+  *         0 ~ CT_PipeSliderNum * CT_PIPE_SLIDER_STEP - 1 for a wheel, or CT_PIPE_POS_NONE.
+  */
+u32 CT_PIPE_GetSliderPos(CT_PIPE_TypeDef *pipe)
+{
+	return pipe->SliderPos;
+}
+
+/**
+  * @brief  Get the noise estimate of a channel.
+  * @param  pipe: pipeline instance.
+  * @param  Channel: channel index.
+  * @retval Mean absolute deviation of the released data, Q8.
+  */
+u32 CT_PIPE_GetNoise(CT_PIPE_TypeDef *pipe, u8 Channel)
+{
+	assert_param(IS_CT_CHANNEL(Channel));
+
+	return pipe->Ch[Channel].Noise;
+}
+
+/**
+  * @brief  Get a snapshot of the pipeline statistics.
+  * @param  pipe: pipeline instance.
+  * @param  Stats: pointer to the structure that receives the statistics.
+  * @retval None
+  */
+void CT_PIPE_GetStats(CT_PIPE_TypeDef *pipe, CT_PIPE_StatsTypeDef *Stats)
+{
+	u32 PrevStatus = __get_PRIMASK();
+
+	__disable_irq();
+	*Stats = pipe->Stats;
+	__set_PRIMASK(PrevStatus);
+}
+
+/** @} */
+
+/** @} */
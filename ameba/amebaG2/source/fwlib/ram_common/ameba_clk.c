@@ -388,6 +388,296 @@ cal_end:
 	return TRUE;
 }
 
+#define OSC_CAL_RUN_NONE		0
+#define OSC_CAL_RUN_VALID		1
+#define OSC_CAL_RUN_STALE		2	/* started before the last trim code change */
+
+static u32 osc_cal_code_get(OSC_CAL_TypeDef *cal)
+{
+	RTC_MISC_TypeDef *osc131k = OSC131K_BASE;
+	LDO_TypeDef *ldo = LDO_BASE;
+
+	if (cal->Cfg.OSC_CalClk == AON128K_CAL_CLK) {
+		return RTC_GET_RCAL(osc131k->RTC_OSC131K_CTRL);
+	} else {
+		return LDO_GET_FREQ_R_SEL(ldo->LDO_4M_OSC_CTRL1);
+	}
+}
+
+/* no settle delay here, OSC_CAL_Process() skips the counter until SettleUs has passed */
+static void osc_cal_code_set(OSC_CAL_TypeDef *cal, u32 code)
+{
+	RTC_MISC_TypeDef *osc131k = OSC131K_BASE;
+	LDO_TypeDef *ldo = LDO_BASE;
+	u32 temp;
+
+	if (cal->Cfg.OSC_CalClk == AON128K_CAL_CLK) {
+		temp = osc131k->RTC_OSC131K_CTRL;
+		temp &= ~RTC_MASK_RCAL;
+		temp |= RTC_RCAL(code);
+		osc131k->RTC_OSC131K_CTRL = temp;
+	} else {
+		temp = ldo->LDO_4M_OSC_CTRL1;
+		temp &= ~LDO_MASK_FREQ_R_SEL;
+		temp |= LDO_FREQ_R_SEL(code);
+		ldo->LDO_4M_OSC_CTRL1 = temp;
+	}
+
+	cal->Code = (u8)code;
+	cal->ChangeTime = DTimestamp_Get();
+	cal->Samples = 0;
+	cal->Sum = 0;
+	if (cal->Measuring) {
+		cal->Measuring = OSC_CAL_RUN_STALE;
+	}
+}
+
+/* the thermal meter driver is optional, without it every temperature falls in band 0 */
+static bool osc_cal_temp_get(OSC_CAL_TypeDef *cal)
+{
+#if defined(CONFIG_TEMP_AMEBA)
+	return TM_GetCdegreeInt(&cal->Temp);
+#else
+	cal->Temp = cal->Cfg.OSC_CalTempMin;
+	return TRUE;
+#endif
+}
+
+static u32 osc_cal_band(OSC_CAL_TypeDef *cal, s32 Temp)
+{
+	s32 width = (s32)cal->Cfg.OSC_CalBandWidth;
+	s32 offset = Temp - cal->Cfg.OSC_CalTempMin;
+	s32 band;
+
+	/* 1 degree hysteresis at the edges of the current band */
+	if (cal->Band != OSC_CAL_CODE_NONE) {
+		band = cal->Band;
+		if (offset >= band * width - 1 && offset <= (band + 1) * width) {
+			return cal->Band;
+		}
+	}
+
+	band = offset < 0 ? 0 : offset / width;
+
+	return MIN((u32)band, OSC_CAL_BAND_NUM - 1);
+}
+
+/**
+  * @brief  Fill each OSC_CAL_InitTypeDef member with its default value.
+  * @param  OSC_CalInitStruct: pointer to an OSC_CAL_InitTypeDef structure.
+  * @retval None
+  */
+void OSC_CAL_StructInit(OSC_CAL_InitTypeDef *OSC_CalInitStruct)
+{
+	OSC_CalInitStruct->OSC_CalClk = AON128K_CAL_CLK;
+	OSC_CalInitStruct->OSC_CalTolPpm = 500;
+	OSC_CalInitStruct->OSC_CalSamples = 4;
+	OSC_CalInitStruct->OSC_CalTempMin = -40;
+	OSC_CalInitStruct->OSC_CalBandWidth = 10;
+}
+
+/**
+  * @brief  Initialize the tracking of one OSC, starting from the trim code in use.
+  * @param  cal: tracking instance.
+  * @param  OSC_CalInitStruct: pointer to an OSC_CAL_InitTypeDef structure.
+  * @retval RTK_SUCCESS or RTK_ERR_BADARG.
+  * @note   OSC131K_Calibration() or OSC4M_Calibration() shall have run before, and with
+  *         CONFIG_TEMP_AMEBA the thermal meter shall be on (TM_Init()). The cache starts
+  *         empty, restore a saved one by writing cal->Cache after this call.
+  */
+int OSC_CAL_Init(OSC_CAL_TypeDef *cal, OSC_CAL_InitTypeDef *OSC_CalInitStruct)
+{
+	if ((OSC_CalInitStruct->OSC_CalClk != AON128K_CAL_CLK && OSC_CalInitStruct->OSC_CalClk != OSC4M_CAL_CLK) ||
+		OSC_CalInitStruct->OSC_CalSamples == 0 || OSC_CalInitStruct->OSC_CalSamples > OSC_CAL_SAMPLE_MAX ||
+		OSC_CalInitStruct->OSC_CalBandWidth == 0) {
+		RTK_LOGE(TAG, "Invalid OSC cal config\n");
+		return RTK_ERR_BADARG;
+	}
+
+	_memset((void *)cal, 0, sizeof(OSC_CAL_TypeDef));
+	_memset((void *)cal->Cache, OSC_CAL_CODE_NONE, sizeof(cal->Cache));
+	cal->Cfg = *OSC_CalInitStruct;
+	cal->Band = OSC_CAL_CODE_NONE;
+
+	if (cal->Cfg.OSC_CalClk == AON128K_CAL_CLK) {
+		cal->Target = 2441;		/* cal_rpt=8*40Mhz/fclk_osc131k */
+		cal->CodeMax = RTC_GET_RCAL(RTC_MASK_RCAL);
+		cal->SettleUs = 1000;
+	} else {
+		cal->Target = 320;		/* cal_rpt=32*40Mhz/fclk_osc4m */
+		cal->CodeMax = LDO_GET_FREQ_R_SEL(LDO_MASK_FREQ_R_SEL);
+		cal->SettleUs = 2;
+	}
+
+	cal->Code = (u8)osc_cal_code_get(cal);
+	cal->ChangeTime = DTimestamp_Get();
+
+	return RTK_SUCCESS;
+}
+
+/**
+  * @brief  Run one step of the OSC tracking, never waits.
+  * @param  cal: tracking instance.
+  * @retval TRUE while the trim code is moving, call again soon. FALSE when the error is
+  *         within OSC_CalTolPpm or the best code is held, a slow period is enough.
+  * @note   Called from one task or idle hook only. The band follows the thermal meter, it
+  *         is kept while the meter has no valid result. Without CONFIG_TEMP_AMEBA there is
+  *         no meter and only band 0 is used. A frequency counter run started by
+  *         OSC_CalResult_Get() is left alone, the step is skipped.
+  *         Each decision averages OSC_CalSamples counter runs, one run per call.
+  */
+bool OSC_CAL_Process(OSC_CAL_TypeDef *cal)
+{
+	PLL_TypeDef *sys_pll = (PLL_TypeDef *)PLL_REG_BASE;
+	u32 band = cal->Band;
+	u32 temp, err, total;
+	s32 ppm, dir;
+
+	if (osc_cal_temp_get(cal)) {
+		band = osc_cal_band(cal, cal->Temp);
+	} else {
+		cal->Stats.TempInvalid++;
+	}
+
+	/* no band before the first valid thermal meter result */
+	if (band == OSC_CAL_CODE_NONE) {
+		return FALSE;
+	}
+
+	if (band != cal->Band) {
+		cal->Band = (u8)band;
+		cal->Hold = FALSE;
+		cal->LastDir = 0;
+		if (cal->Cache[band] != OSC_CAL_CODE_NONE) {
+			cal->Stats.CacheHits++;
+			cal->Tracking = FALSE;
+			if (cal->Cache[band] != cal->Code) {
+				osc_cal_code_set(cal, cal->Cache[band]);
+			}
+		} else {
+			cal->Stats.CacheMisses++;
+			cal->Tracking = TRUE;
+		}
+	}
+
+	temp = sys_pll->PLL_CLK_CALC;
+	if (temp & PLL_BIT_CK_CAL_START) {
+		return cal->Tracking;
+	}
+
+	if (cal->Measuring) {
+		if (cal->Measuring == OSC_CAL_RUN_VALID && PLL_GET_CK_CAL_SEL(temp) == cal->Cfg.OSC_CalClk) {
+			cal->Sum += PLL_GET_CK_CAL_RPT(temp);
+			cal->Samples++;
+			cal->Stats.Measures++;
+		}
+		cal->Measuring = OSC_CAL_RUN_NONE;
+	}
+
+	if (DTimestamp_Get() - cal->ChangeTime < cal->SettleUs) {
+		return cal->Tracking;
+	}
+
+	if (cal->Samples < cal->Cfg.OSC_CalSamples) {
+		temp &= ~PLL_MASK_CK_CAL_SEL;
+		temp |= (PLL_CK_CAL_SEL(cal->Cfg.OSC_CalClk) | PLL_BIT_CK_CAL_START);
+		sys_pll->PLL_CLK_CALC = temp;
+		cal->Measuring = OSC_CAL_RUN_VALID;
+		return cal->Tracking;
+	}
+
+	/* counter result is inversely proportional to the OSC frequency */
+	total = cal->Target * cal->Samples;
+	ppm = (s32)(((s64)total - cal->Sum) * 1000000 / (s32)total);
+	err = ppm < 0 ? -ppm : ppm;
+	cal->Samples = 0;
+	cal->Sum = 0;
+	cal->Ppm = ppm;
+
+	if (err > (u32)(cal->Stats.PpmMax < 0 ? -cal->Stats.PpmMax : cal->Stats.PpmMax)) {
+		cal->Stats.PpmMax = ppm;
+	}
+
+	if (cal->Hold) {
+		if (err <= (u32)(cal->LastPpm < 0 ? -cal->LastPpm : cal->LastPpm) + cal->Cfg.OSC_CalTolPpm) {
+			return FALSE;
+		}
+		cal->Hold = FALSE;
+		cal->LastDir = 0;
+	}
+
+	if (err <= cal->Cfg.OSC_CalTolPpm) {
+		cal->Cache[cal->Band] = cal->Code;
+		cal->LastDir = 0;
+		cal->Tracking = FALSE;
+		return FALSE;
+	}
+
+	/* RCAL larger is faster, FREQ_R_SEL larger is slower */
+	dir = ppm > 0 ? -1 : 1;
+	if (cal->Cfg.OSC_CalClk == OSC4M_CAL_CLK) {
+		dir = -dir;
+	}
+
+	/* stepped over the target, keep the better of the two codes around it */
+	if (cal->LastDir != 0 && dir != cal->LastDir) {
+		if ((u32)(cal->LastPpm < 0 ? -cal->LastPpm : cal->LastPpm) < err) {
+			osc_cal_code_set(cal, cal->Code - cal->LastDir);
+			cal->Ppm = cal->LastPpm;
+		} else {
+			cal->LastPpm = ppm;
+		}
+		goto hold;
+	}
+
+	if ((dir < 0 && cal->Code == 0) || (dir > 0 && cal->Code >= cal->CodeMax)) {
+		cal->Stats.Saturated++;
+		cal->LastPpm = ppm;
+		goto hold;
+	}
+
+	cal->LastPpm = ppm;
+	cal->LastDir = (s8)dir;
+	cal->Tracking = TRUE;
+	cal->Stats.Steps++;
+	osc_cal_code_set(cal, cal->Code + dir);
+
+	return TRUE;
+
+hold:
+	cal->Cache[cal->Band] = cal->Code;
+	cal->Hold = TRUE;
+	cal->LastDir = 0;
+	cal->Tracking = FALSE;
+
+	return FALSE;
+}
+
+/**
+  * @brief  Get the OSC frequency error of the last decision.
+  * @param  cal: tracking instance.
+  * @retval Error in ppm, > 0 if the OSC is faster than its nominal frequency.
+  */
+s32 OSC_CAL_GetPpm(OSC_CAL_TypeDef *cal)
+{
+	return cal->Ppm;
+}
+
+/**
+  * @brief  Get a snapshot of the tracking statistics.
+  * @param  cal: tracking instance.
+  * @param  Stats: pointer to the statistics copy.
+  * @retval None
+  */
+void OSC_CAL_GetStats(OSC_CAL_TypeDef *cal, OSC_CAL_StatsTypeDef *Stats)
+{
+	u32 PrevStatus = __get_PRIMASK();
+
+	__disable_irq();
+	*Stats = cal->Stats;
+	__set_PRIMASK(PrevStatus);
+}
+
 /**
   * @brief  OSC4M Init
   * @param  NA
@@ -589,3 +879,287 @@ u8 PLL_ClkSrcGet(const u32 sys_pll, const u32 usb_pll, u32 fre_limit)
 	}
 	return ret;
 }
+
+/* Clock tree model: rates of the nodes fed by the PLLs, cached so drivers do not read the
+ * retention memory under the IPC semaphore on every divider computation. */
+static u32 clk_tree_rate[CLK_ID_NUM];
+static CLK_NotifierTypeDef *clk_notifiers;	/* sorted by Prio */
+
+static u32 clk_tree_node(const struct CLK_Info_Backup *info, u8 ckd)
+{
+	return ((ckd & IS_SYS_PLL) ? info->SYSPLL_CLK : info->USBPLL_CLK) / GET_CLK_DIV(ckd);
+}
+
+static void clk_tree_calc(const struct CLK_Info_Backup *info, u32 *rate)
+{
+	rate[CLK_ID_USB_PLL] = info->USBPLL_CLK;
+	rate[CLK_ID_SYS_PLL] = info->SYSPLL_CLK;
+	rate[CLK_ID_SHPERI] = clk_tree_node(info, info->shperi_ckd);
+	rate[CLK_ID_HPERI] = clk_tree_node(info, info->hperi_ckd);
+	rate[CLK_ID_PSRAMC] = clk_tree_node(info, info->psramc_ckd);
+	rate[CLK_ID_VO] = clk_tree_node(info, info->vo_ckd);
+
+	if (SYSCFG_CHIPType_Get() == CHIP_TYPE_FPGA) {
+		rate[CLK_ID_CPU] = 40 * MHZ_TICK_CNT;
+	} else if (CKSL_HP_XTAL == RCC_PeriphClockSourceGet(HP)) {
+		rate[CLK_ID_CPU] = XTAL_ClkGet();
+	} else {
+		rate[CLK_ID_CPU] = clk_tree_node(info, info->CPU_CKD);
+	}
+}
+
+static void clk_tree_info_get(struct CLK_Info_Backup *info)
+{
+	IPC_SEMTake(IPC_SEM_RRAM, 0xffffffff);
+	_memcpy(info, &RRAM_DEV->clk_info_bk, sizeof(struct CLK_Info_Backup));
+	IPC_SEMFree(IPC_SEM_RRAM);
+}
+
+static int clk_tree_notify(u32 Event, const CLK_RateChangeTypeDef *Change, CLK_NotifierTypeDef *Stop)
+{
+	CLK_NotifierTypeDef *n;
+
+	for (n = clk_notifiers; n != Stop; n = n->Next) {
+		if ((n->ClkMask & Change->ChangedMask) == 0) {
+			continue;
+		}
+		if (n->Cb(n->Data, Event, Change) != RTK_SUCCESS && Event == CLK_EVT_PRE_CHANGE) {
+			RTK_LOGW(TAG, "Rate change vetoed by notifier %p\n", n);
+			/* the ones already notified go back to their current settings */
+			clk_tree_notify(CLK_EVT_ABORT_CHANGE, Change, n);
+			return RTK_FAIL;
+		}
+	}
+
+	return RTK_SUCCESS;
+}
+
+/**
+  * @brief  Reload the cached clock tree rates from the retention memory.
+  * @note   Call it after the clock dividers or sources were changed without PLL_SetFreqNotify.
+  * @retval None
+  */
+void CLK_TreeRefresh(void)
+{
+	struct CLK_Info_Backup info;
+	u32 rate[CLK_ID_NUM];
+	u32 PrevStatus;
+
+	clk_tree_info_get(&info);
+	clk_tree_calc(&info, rate);
+
+	PrevStatus = __get_PRIMASK();
+	__disable_irq();
+	_memcpy(clk_tree_rate, rate, sizeof(clk_tree_rate));
+	__set_PRIMASK(PrevStatus);
+}
+
+/**
+  * @brief  Get the cached rate of a clock tree node.
+  * @param  ClkId: @ref CLK_Tree_Node
+  * @retval frequency in Hz
+  */
+u32 CLK_RateGet(u32 ClkId)
+{
+	assert_param(ClkId < CLK_ID_NUM);
+
+	if (clk_tree_rate[CLK_ID_CPU] == 0) {
+		CLK_TreeRefresh();
+	}
+
+	return clk_tree_rate[ClkId];
+}
+
+/**
+  * @brief  Register a rate change notifier.
+  * @param  Notifier: storage provided by the driver, Cb, Data, ClkMask and Prio filled.
+  * @note   Notifiers run in ascending Prio order for every event, equal Prio in registration order.
+  * @retval None
+  */
+void CLK_NotifierRegister(CLK_NotifierTypeDef *Notifier)
+{
+	CLK_NotifierTypeDef **pp;
+	u32 PrevStatus = __get_PRIMASK();
+
+	assert_param(Notifier->Cb != NULL);
+
+	__disable_irq();
+	for (pp = &clk_notifiers; *pp != NULL && (*pp)->Prio <= Notifier->Prio; pp = &(*pp)->Next);
+	Notifier->Next = *pp;
+	*pp = Notifier;
+	__set_PRIMASK(PrevStatus);
+}
+
+/**
+  * @brief  Unregister a rate change notifier.
+  * @param  Notifier: notifier given to CLK_NotifierRegister.
+  * @retval None
+  */
+void CLK_NotifierUnregister(CLK_NotifierTypeDef *Notifier)
+{
+	CLK_NotifierTypeDef **pp;
+	u32 PrevStatus = __get_PRIMASK();
+
+	__disable_irq();
+	for (pp = &clk_notifiers; *pp != NULL; pp = &(*pp)->Next) {
+		if (*pp == Notifier) {
+			*pp = Notifier->Next;
+			break;
+		}
+	}
+	__set_PRIMASK(PrevStatus);
+}
+
+/* Move the clock tree to info: notify, run apply for the hardware and the retention memory,
+ * then refresh the cache and notify again. */
+static int clk_tree_change(const struct CLK_Info_Backup *info, void (*apply)(const struct CLK_Info_Backup *info))
+{
+	struct CLK_Info_Backup cur;
+	CLK_RateChangeTypeDef chg;
+	u32 id;
+
+	clk_tree_info_get(&cur);
+	clk_tree_calc(&cur, chg.OldRate);
+	clk_tree_calc(info, chg.NewRate);
+
+	chg.ChangedMask = 0;
+	for (id = 0; id < CLK_ID_NUM; id++) {
+		if (chg.OldRate[id] != chg.NewRate[id]) {
+			chg.ChangedMask |= BIT(id);
+		}
+	}
+
+	if (chg.ChangedMask == 0) {
+		return RTK_SUCCESS;
+	}
+
+	if (clk_tree_notify(CLK_EVT_PRE_CHANGE, &chg, NULL) != RTK_SUCCESS) {
+		return RTK_FAIL;
+	}
+
+	apply(info);
+	CLK_TreeRefresh();
+
+	if (chg.ChangedMask & BIT(CLK_ID_CPU)) {
+		DelayClkUpdate(chg.NewRate[CLK_ID_CPU]);
+	}
+
+	clk_tree_notify(CLK_EVT_POST_CHANGE, &chg, NULL);
+
+	return RTK_SUCCESS;
+}
+
+static void clk_tree_div_apply(const struct CLK_Info_Backup *info)
+{
+	u32 PrevStatus = __get_PRIMASK();
+
+	__disable_irq();
+
+	if (info->CPU_CKD & IS_SYS_PLL) {
+		RCC_PeriphClockDividerSet(SYS_PLL_HP, GET_CLK_DIV(info->CPU_CKD));
+	} else {
+		RCC_PeriphClockDividerSet(USB_PLL_HP, GET_CLK_DIV(info->CPU_CKD));
+	}
+
+	if (info->hperi_ckd & IS_SYS_PLL) {
+		RCC_PeriphClockDividerSet(SYS_PLL_HPERI, GET_CLK_DIV(info->hperi_ckd));
+	} else {
+		RCC_PeriphClockDividerSet(USB_PLL_HPERI, GET_CLK_DIV(info->hperi_ckd));
+	}
+
+	__set_PRIMASK(PrevStatus);
+
+	/* CPU_ClkGet and HPERI_ClkGet read the dividers back from retention memory */
+	IPC_SEMTake(IPC_SEM_RRAM, 0xffffffff);
+	RRAM_DEV->clk_info_bk.CPU_CKD = info->CPU_CKD;
+	RRAM_DEV->clk_info_bk.hperi_ckd = info->hperi_ckd;
+	IPC_SEMFree(IPC_SEM_RRAM);
+}
+
+/* PLL_SetFreq is in ameba_pll.c, which is only built with the I2S driver */
+#if defined(CONFIG_I2S_AMEBA)
+static void clk_tree_pll_apply(const struct CLK_Info_Backup *info)
+{
+	/* only the PLL whose rate differs is reprogrammed */
+	if (info->SYSPLL_CLK != RRAM_DEV->clk_info_bk.SYSPLL_CLK) {
+		PLL_SetFreq(SYS_PLL, info->SYSPLL_CLK);
+	}
+	if (info->USBPLL_CLK != RRAM_DEV->clk_info_bk.USBPLL_CLK) {
+		PLL_SetFreq(USB_PLL, info->USBPLL_CLK);
+	}
+
+	IPC_SEMTake(IPC_SEM_RRAM, 0xffffffff);
+	RRAM_DEV->clk_info_bk.SYSPLL_CLK = info->SYSPLL_CLK;
+	RRAM_DEV->clk_info_bk.USBPLL_CLK = info->USBPLL_CLK;
+	IPC_SEMFree(IPC_SEM_RRAM);
+}
+
+/**
+  * @brief  Change a PLL frequency at runtime and notify the drivers clocked from it.
+  * @param  pll_name: USB_PLL / SYS_PLL
+  * @param  pll_freq: new frequency in Hz
+  * @retval RTK_SUCCESS, or RTK_FAIL if a notifier vetoed the change (the PLL is unchanged)
+  * @note   Sequence: CLK_EVT_PRE_CHANGE to every notifier whose ClkMask has a changing node,
+  *         PLL_SetFreq, retention memory and cache update, DelayUs recalibration when the CPU
+  *         clock changed, then CLK_EVT_POST_CHANGE. Call it from a task, not with interrupts off.
+  */
+int PLL_SetFreqNotify(u8 pll_name, u32 pll_freq)
+{
+	struct CLK_Info_Backup info;
+
+	assert_param(IS_VALID_PLL_TYPE(pll_name));
+
+	clk_tree_info_get(&info);
+	if (pll_name == SYS_PLL) {
+		info.SYSPLL_CLK = pll_freq;
+	} else {
+		info.USBPLL_CLK = pll_freq;
+	}
+
+	return clk_tree_change(&info, clk_tree_pll_apply);
+}
+#endif
+
+/**
+  * @brief  Change the CPU (HP) and HPERI dividers at runtime and notify the drivers clocked from them.
+  * @param  CpuCkd: IS_SYS_PLL or IS_USB_PLL | divider 1 ~ 16, as in the retention memory clock info
+  * @param  HperiCkd: same encoding for HPERI
+  * @retval RTK_SUCCESS, or RTK_FAIL if a notifier vetoed the change (the dividers are unchanged)
+  * @note   Same sequence as PLL_SetFreqNotify. The PLL of each node shall be the one it runs
+  *         from, only the divider changes. Call it from a task, not with interrupts off.
+  */
+int CLK_DivSetNotify(u8 CpuCkd, u8 HperiCkd)
+{
+	struct CLK_Info_Backup info;
+
+	assert_param(GET_CLK_DIV(CpuCkd) >= 1 && GET_CLK_DIV(CpuCkd) <= 16);
+	assert_param(GET_CLK_DIV(HperiCkd) >= 1 && GET_CLK_DIV(HperiCkd) <= 16);
+
+	clk_tree_info_get(&info);
+	info.CPU_CKD = CpuCkd;
+	info.hperi_ckd = HperiCkd;
+
+	return clk_tree_change(&info, clk_tree_div_apply);
+}
+
+/**
+  * @brief  Find the precomputed divider for a source clock rate.
+  * @param  Table: entries built by the driver for every source rate it may run from.
+  * @param  Num: number of entries.
+  * @param  SrcHz: source clock rate, usually CLK_RateChangeTypeDef.NewRate of the node.
+  * @param  Val: divider setting of the matching entry.
+  * @retval RTK_SUCCESS, or RTK_FAIL if the rate is not in the table
+  */
+int CLK_DivTableLookup(const CLK_DivEntry *Table, u32 Num, u32 SrcHz, u32 *Val)
+{
+	u32 i;
+
+	for (i = 0; i < Num; i++) {
+		if (Table[i].SrcHz == SrcHz) {
+			*Val = Table[i].Val;
+			return RTK_SUCCESS;
+		}
+	}
+
+	return RTK_FAIL;
+}
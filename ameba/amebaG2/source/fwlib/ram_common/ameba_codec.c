@@ -5,6 +5,7 @@
  */
 
 #include "ameba_soc.h"
+#include <math.h>
 
 static const char *const TAG = "CODEC";
 
@@ -884,6 +885,267 @@ void AUDIO_CODEC_SetADCEQBand(u32 ad_chn, u32 band_sel, u32 newstate)
 }
 
 
+#define CODEC_EQ_PI			3.14159265358979323846
+#define CODEC_EQ_ONE		((s32)0x02000000)	/* 1.0 in 4.25 format */
+#define CODEC_EQ_COEF_MASK	((u32)0x1FFFFFFF)
+
+/* the register spec does not give the sign of A1/A2, see AMEBA_CODEC_EQ_FEEDBACK_ADD */
+#if defined(CONFIG_AMEBA_CODEC_EQ_FEEDBACK_ADD)
+#define CODEC_EQ_A_SIGN		(-1)
+#else
+#define CODEC_EQ_A_SIGN		1
+#endif
+
+/* Round to the 29 bit two's complement 4.25 format, -8 ~ 7.99 */
+static int codec_eq_quant(double x, u32 *q, s32 *v)
+{
+	if (x >= 8.0 || x < -8.0) {
+		return RTK_ERR_BADARG;
+	}
+
+	*v = (s32)floor(x * CODEC_EQ_ONE + 0.5);
+	*v = MIN(*v, (s32)0x0FFFFFFF);
+	*q = (u32)*v & CODEC_EQ_COEF_MASK;
+
+	return RTK_SUCCESS;
+}
+
+/**
+  * @brief  Design one EQ band and quantize it for the codec biquad.
+  * @param  Param: band type, frequency, Q and gain.
+  * @param  SampleRate: ADC sample rate in Hz.
+  * @param  Coef: quantized coefficients for AUDIO_CODEC_SetADCEQFilter().
+  * @retval RTK_SUCCESS, or RTK_ERR_BADARG if the parameters are invalid or the filter
+  *         does not fit the coefficient range.
+  * @note   Audio EQ cookbook biquads, computed in double, normalized and given in the
+  *         register convention of CODEC_EQFilterCoef. The poles are checked again after
+  *         quantization, a band that would be unstable is refused.
+  */
+int AUDIO_CODEC_EQDesign(CODEC_EQBandParam *Param, u32 SampleRate, CODEC_EQFilterCoef *Coef)
+{
+	double w0, cs, alpha, A, sa;
+	double b0, b1, b2, a0, a1, a2;
+	s32 v[5];
+
+	if (SampleRate == 0 || Param->Fc == 0 || Param->Fc * 2 >= SampleRate || !(Param->Q > 0)) {
+		RTK_LOGE(TAG, "Invalid EQ band\n");
+		return RTK_ERR_BADARG;
+	}
+
+	w0 = 2 * CODEC_EQ_PI * Param->Fc / SampleRate;
+	cs = cos(w0);
+	alpha = sin(w0) / (2 * Param->Q);
+	A = pow(10, Param->GainDb / 40);
+	sa = 2 * sqrt(A) * alpha;
+
+	switch (Param->Type) {
+	case CODEC_EQ_LOWPASS:
+		b0 = (1 - cs) / 2;
+		b1 = 1 - cs;
+		b2 = b0;
+		a0 = 1 + alpha;
+		a1 = -2 * cs;
+		a2 = 1 - alpha;
+		break;
+	case CODEC_EQ_HIGHPASS:
+		b0 = (1 + cs) / 2;
+		b1 = -(1 + cs);
+		b2 = b0;
+		a0 = 1 + alpha;
+		a1 = -2 * cs;
+		a2 = 1 - alpha;
+		break;
+	case CODEC_EQ_BANDPASS:
+		b0 = alpha;
+		b1 = 0;
+		b2 = -alpha;
+		a0 = 1 + alpha;
+		a1 = -2 * cs;
+		a2 = 1 - alpha;
+		break;
+	case CODEC_EQ_NOTCH:
+		b0 = 1;
+		b1 = -2 * cs;
+		b2 = 1;
+		a0 = 1 + alpha;
+		a1 = -2 * cs;
+		a2 = 1 - alpha;
+		break;
+	case CODEC_EQ_PEAK:
+		b0 = 1 + alpha * A;
+		b1 = -2 * cs;
+		b2 = 1 - alpha * A;
+		a0 = 1 + alpha / A;
+		a1 = -2 * cs;
+		a2 = 1 - alpha / A;
+		break;
+	case CODEC_EQ_LOWSHELF:
+		b0 = A * ((A + 1) - (A - 1) * cs + sa);
+		b1 = 2 * A * ((A - 1) - (A + 1) * cs);
+		b2 = A * ((A + 1) - (A - 1) * cs - sa);
+		a0 = (A + 1) + (A - 1) * cs + sa;
+		a1 = -2 * ((A - 1) + (A + 1) * cs);
+		a2 = (A + 1) + (A - 1) * cs - sa;
+		break;
+	case CODEC_EQ_HIGHSHELF:
+		b0 = A * ((A + 1) + (A - 1) * cs + sa);
+		b1 = -2 * A * ((A - 1) + (A + 1) * cs);
+		b2 = A * ((A + 1) + (A - 1) * cs - sa);
+		a0 = (A + 1) - (A - 1) * cs + sa;
+		a1 = 2 * ((A - 1) - (A + 1) * cs);
+		a2 = (A + 1) - (A - 1) * cs - sa;
+		break;
+	default:
+		RTK_LOGE(TAG, "Invalid EQ type %lu\n", Param->Type);
+		return RTK_ERR_BADARG;
+	}
+
+	if (codec_eq_quant(b0 / a0, &Coef->H0_Q, &v[0]) || codec_eq_quant(b1 / a0, &Coef->B1_Q, &v[1]) ||
+		codec_eq_quant(b2 / a0, &Coef->B2_Q, &v[2]) ||
+		codec_eq_quant(CODEC_EQ_A_SIGN * a1 / a0, &Coef->A1_Q, &v[3]) ||
+		codec_eq_quant(CODEC_EQ_A_SIGN * a2 / a0, &Coef->A2_Q, &v[4])) {
+		RTK_LOGE(TAG, "EQ coef out of range\n");
+		return RTK_ERR_BADARG;
+	}
+
+	/* stability triangle of 1 + a1*z^-1 + a2*z^-2, a = CODEC_EQ_A_SIGN * v: |a2| < 1 and |a1| < 1 + a2 */
+	if (v[4] >= CODEC_EQ_ONE || v[4] <= -CODEC_EQ_ONE ||
+		(v[3] < 0 ? -v[3] : v[3]) >= CODEC_EQ_ONE + CODEC_EQ_A_SIGN * v[4]) {
+		RTK_LOGE(TAG, "EQ band unstable after quantization\n");
+		return RTK_ERR_BADARG;
+	}
+
+	return RTK_SUCCESS;
+}
+
+/**
+  * @brief  Design all enabled bands of a preset and cache the coefficients in it.
+  * @param  Preset: EQ preset.
+  * @retval RTK_SUCCESS or RTK_ERR_BADARG.
+  */
+int AUDIO_CODEC_EQPresetBuild(CODEC_EQPreset *Preset)
+{
+	int ret;
+	u32 i;
+
+	Preset->Built = FALSE;
+
+	/* also paces the muted load, even with no band enabled */
+	if (Preset->SampleRate == 0) {
+		RTK_LOGE(TAG, "Invalid EQ sample rate\n");
+		return RTK_ERR_BADARG;
+	}
+
+	for (i = 0; i < CODEC_EQ_BAND_NUM; i++) {
+		if (Preset->BandMask & BIT(i)) {
+			ret = AUDIO_CODEC_EQDesign(&Preset->Band[i], Preset->SampleRate, &Preset->Coef[i]);
+			if (ret != RTK_SUCCESS) {
+				return ret;
+			}
+		}
+	}
+
+	Preset->Built = TRUE;
+
+	return RTK_SUCCESS;
+}
+
+/**
+  * @brief  Load a preset into the EQ of an adc channel without glitches.
+  * @param  ad_chn: select adc channel
+  *          This parameter can be one of the following values:
+  *            @arg ADCHN1
+  *            @arg ADCHN2
+  * @param  Preset: EQ preset, built here if Preset->Built is not set.
+  * @param  Mode: @ref AUDIO_CODEC_EQ_Load_Mode
+  * @retval RTK_SUCCESS or RTK_ERR_BADARG.
+  * @note   Bands whose registers already hold the preset keep running. A band is never
+  *         enabled with a mix of old and new coefficients: it is disabled, written and
+  *         enabled again. With CODEC_EQ_LOAD_MUTE the adc path is muted at a zero
+  *         crossing (64 samples timeout) around the update, this waits
+  *         2 * CODEC_EQ_MUTE_SAMPLES samples, so call it from a task.
+  *         The EQ clock shall be enabled by AUDIO_CODEC_SetADCEQClk().
+  */
+int AUDIO_CODEC_EQPresetLoad(u32 ad_chn, CODEC_EQPreset *Preset, u32 Mode)
+{
+	AUDIO_CODEC_TypeDef *audio_base = AUDIO_CODEC_GetAddr();
+	CODEC_EQ_BAND_TypeDef *eq;
+	CODEC_EQFilterCoef *coef;
+	u32 on, changed, save, wait, i;
+	int ret;
+
+	assert_param(IS_CODEC_ADCHN_SEL(ad_chn));
+
+	if (Preset->SampleRate == 0) {
+		RTK_LOGE(TAG, "Invalid EQ sample rate\n");
+		return RTK_ERR_BADARG;
+	}
+
+	if (!Preset->Built) {
+		ret = AUDIO_CODEC_EQPresetBuild(Preset);
+		if (ret != RTK_SUCCESS) {
+			return ret;
+		}
+	}
+
+	if (ad_chn == ADCHN1) {
+		eq = (CODEC_EQ_BAND_TypeDef *)audio_base->CODEC_ADC_0_EQ_BAND;
+		on = audio_base->CODEC_ADC_0_EQ_CTRL;
+	} else {
+		eq = (CODEC_EQ_BAND_TypeDef *)audio_base->CODEC_ADC_1_EQ_BAND;
+		on = audio_base->CODEC_ADC_1_EQ_CTRL;
+	}
+
+	changed = 0;
+	for (i = 0; i < CODEC_EQ_BAND_NUM; i++) {
+		coef = &Preset->Coef[i];
+		if (!(Preset->BandMask & BIT(i))) {
+			if (on & BIT(i)) {
+				changed |= BIT(i);
+			}
+		} else if (!(on & BIT(i)) || (eq[i].CODEC_BIQUAD_H0_x & CODEC_EQ_COEF_MASK) != coef->H0_Q ||
+				   (eq[i].CODEC_BIQUAD_B1_x & CODEC_EQ_COEF_MASK) != coef->B1_Q ||
+				   (eq[i].CODEC_BIQUAD_B2_x & CODEC_EQ_COEF_MASK) != coef->B2_Q ||
+				   (eq[i].CODEC_BIQUAD_A1_x & CODEC_EQ_COEF_MASK) != coef->A1_Q ||
+				   (eq[i].CODEC_BIQUAD_A2_x & CODEC_EQ_COEF_MASK) != coef->A2_Q) {
+			changed |= BIT(i);
+		}
+	}
+
+	if (changed == 0) {
+		return RTK_SUCCESS;
+	}
+
+	save = audio_base->CODEC_ADC_CH_CTRL[ad_chn - 1].CODEC_ADC_x_CONTROL_0;
+	wait = CODEC_EQ_MUTE_SAMPLES * 1000000 / Preset->SampleRate;
+
+	if (Mode == CODEC_EQ_LOAD_MUTE && !(save & AUD_BIT_ADC_x_AD_MUTE)) {
+		AUDIO_CODEC_SetADCZDET(ad_chn, ZDET_TIMEOUT);
+		AUDIO_CODEC_SetADCZDETTimeOut(ad_chn, 3);
+		AUDIO_CODEC_SetADCMute(ad_chn, MUTE);
+		DelayUs(wait);
+	}
+
+	for (i = 0; i < CODEC_EQ_BAND_NUM; i++) {
+		if (changed & BIT(i)) {
+			AUDIO_CODEC_SetADCEQBand(ad_chn, i, DISABLE);
+			if (Preset->BandMask & BIT(i)) {
+				AUDIO_CODEC_SetADCEQFilter(ad_chn, i, &Preset->Coef[i]);
+				AUDIO_CODEC_SetADCEQBand(ad_chn, i, ENABLE);
+			}
+		}
+	}
+
+	if (Mode == CODEC_EQ_LOAD_MUTE && !(save & AUD_BIT_ADC_x_AD_MUTE)) {
+		AUDIO_CODEC_SetADCMute(ad_chn, UNMUTE);
+		DelayUs(wait);
+		AUDIO_CODEC_SetADCZDET(ad_chn, AUD_GET_ADC_x_AD_ZDET_FUNC(save));
+		AUDIO_CODEC_SetADCZDETTimeOut(ad_chn, AUD_GET_ADC_x_AD_ZDET_TOUT(save));
+	}
+
+	return RTK_SUCCESS;
+}
+
 /**
   * @brief  Set ADC path zero detection function.
   * @param  channel: select adc channel.
@@ -18,6 +18,24 @@ static u8 GDMA_IrqNum[8] = {
 	GDMA0_CHANNEL7_IRQ,
 };
 
+/* QoS allocator state, reserved channels stay marked in REG_LSYS_BOOT_REASON_SW while idle so that
+ * GDMA_ChnlAlloc() on either core only hands out unreserved channels */
+static struct {
+	u8 Reserved[GDMA_QOS_CLASS_NUM];	/* channels held for each class */
+	u8 Owned;							/* channels allocated by GDMA_QosChnlAlloc() */
+	u8 Borrowed;						/* reserved channels lent to GDMA_QOS_BULK */
+	u8 Busy;							/* channels between GDMA_QosXferStart() and GDMA_QosXferDone() */
+	u32 XferStart[MAX_GDMA_CHNL + 1];
+	u32 XferBytes[MAX_GDMA_CHNL + 1];
+	void (*PreemptCb[MAX_GDMA_CHNL + 1])(void *Data, u8 GDMA_ChNum);
+	void *PreemptData[MAX_GDMA_CHNL + 1];
+	u32 InitTime;
+	GDMA_QosStatsTypeDef Stats;
+} GDMA_Qos;
+
+/* CH_PRIOR per class, 0 is the highest */
+static const u8 GDMA_QosPrior[GDMA_QOS_CLASS_NUM] = {0, 4, 7};
+
 /** @addtogroup Ameba_Periph_Driver
   * @{
   */
@@ -73,6 +91,9 @@ void GDMA_Init(u8 GDMA_Index, u8 GDMA_ChNum, PGDMA_InitTypeDef GDMA_InitStruct)
 		GDMA = ((GDMA_TypeDef *) GDMA0_REG_BASE_S);
 	}
 
+	/* keep the channel priority set at allocation */
+	CfgxLow = GDMA->CH[GDMA_ChNum].GDMA_CFGx_L & GDMA_MASK_CFGx_L_CH_PRIOR;
+
 	/* Check the parameters */
 	assert_param(IS_GDMA_Index(GDMA_Index));
 	assert_param(IS_GDMA_ChannelNum(GDMA_ChNum));
@@ -624,6 +645,9 @@ static void GDMA_ChnlRegister(u8 GDMA_Index, u8 GDMA_ChNum, IRQ_FUN IrqFun, u32
 	ValTemp |= BIT(GDMA_ChNum);
 	HAL_WRITE8(SYSTEM_CTRL_BASE, REG_LSYS_BOOT_REASON_SW + 3, ValTemp);
 
+	/* GDMA_Init() keeps the channel priority, start every owner from the reset value */
+	GDMA_SetChnlPriority(GDMA_Index, GDMA_ChNum, 0);
+
 	if (IrqFun != NULL) {
 		IrqNum = GDMA_IrqNum[GDMA_ChNum];
 		InterruptRegister(IrqFun, IrqNum, IrqData, IrqPriority);
@@ -932,6 +956,295 @@ void GDMA_DestinationScatter(u8 GDMA_Index, u8 GDMA_ChNum, u32 Dst_ScatterCount,
 	GDMA->CH[GDMA_ChNum].GDMA_DSRx_L = GDMA_DSRx_L_DSC(Dst_ScatterCount) | GDMA_DSRx_L_DSI(Dst_ScatterInterval);
 }
 
+/* BG takes the highest channel numbers first, they have the lowest fixed priority */
+static u32 GDMA_QosPick(u32 QosClass, u32 Mask)
+{
+	Mask &= BIT(MAX_GDMA_CHNL + 1) - 1;
+
+	if (Mask == 0) {
+		return 0xFF;
+	}
+
+	return (QosClass == GDMA_QOS_BG) ? 31 - __builtin_clz(Mask) : __builtin_ctz(Mask);
+}
+
+/* close the transfer accounting and drop the owner, the channel bit and the IRQ are left to the caller */
+static void GDMA_QosDetach(u8 GDMA_Index, u8 GDMA_ChNum)
+{
+	u32 PrevStatus = __get_PRIMASK();
+
+	__disable_irq();
+	if (GDMA_Qos.Busy & BIT(GDMA_ChNum)) {
+		GDMA_Qos.Stats.Chnl[GDMA_ChNum].BusyUs += DTimestamp_Get() - GDMA_Qos.XferStart[GDMA_ChNum];
+		GDMA_Qos.Busy &= ~BIT(GDMA_ChNum);
+	}
+	GDMA_Qos.Owned &= ~BIT(GDMA_ChNum);
+	GDMA_Qos.Borrowed &= ~BIT(GDMA_ChNum);
+	GDMA_Qos.PreemptCb[GDMA_ChNum] = NULL;
+	__set_PRIMASK(PrevStatus);
+
+	GDMA_SetChnlPriority(GDMA_Index, GDMA_ChNum, 0);
+}
+
+/**
+  * @brief  Reserve channels for the QoS classes.
+  * @param  GDMA_Index: 0.
+  * @param  ReserveMask: channel bit mask per class, indexed by @ref GDMA_QoS_Class, NULL for no reservation.
+  * @retval RTK_SUCCESS, RTK_ERR_BADARG if the masks overlap, or RTK_FAIL if a channel is in use.
+  * @note   Reserved channels are only handed out by GDMA_QosChnlAlloc():
+  *         - a class first takes its own idle reserved channels, then unreserved free channels
+  *         - GDMA_QOS_BULK then borrows idle channels reserved for another class
+  *         - when nothing is left, a class takes back its own reserved channel from a borrower, the
+  *           transfer on it is aborted and the borrower is told by its PreemptCb
+  *         With fixed channel priority the lower channel number wins, reserve the lowest channels for GDMA_QOS_RT.
+  */
+int GDMA_QosInit(u32 GDMA_Index, const u8 *ReserveMask)
+{
+	u8 ValTemp, held = 0, mask = 0;
+	u32 i;
+
+	assert_param(IS_GDMA_Index(GDMA_Index));
+
+	if (ReserveMask != NULL) {
+		for (i = 0; i < GDMA_QOS_CLASS_NUM; i++) {
+			if (mask & ReserveMask[i]) {
+				return RTK_ERR_BADARG;
+			}
+			mask |= ReserveMask[i];
+		}
+	}
+
+	if (IPC_SEMTake(IPC_SEM_GDMA, 1000) == FALSE) {
+		return RTK_FAIL;
+	}
+
+	if (GDMA_Qos.Owned) {
+		IPC_SEMFree(IPC_SEM_GDMA);
+		return RTK_FAIL;
+	}
+
+	for (i = 0; i < GDMA_QOS_CLASS_NUM; i++) {
+		held |= GDMA_Qos.Reserved[i];
+	}
+
+	ValTemp = HAL_READ8(SYSTEM_CTRL_BASE, REG_LSYS_BOOT_REASON_SW + 3) & ~held;
+	if (ValTemp & mask) {
+		IPC_SEMFree(IPC_SEM_GDMA);
+		RTK_LOGE(TAG, "Reserved channel in use: 0x%x\n", ValTemp & mask);
+		return RTK_FAIL;
+	}
+	HAL_WRITE8(SYSTEM_CTRL_BASE, REG_LSYS_BOOT_REASON_SW + 3, ValTemp | mask);
+
+	_memset((void *)&GDMA_Qos, 0, sizeof(GDMA_Qos));
+	if (ReserveMask != NULL) {
+		_memcpy((void *)GDMA_Qos.Reserved, ReserveMask, GDMA_QOS_CLASS_NUM);
+	}
+	GDMA_Qos.InitTime = DTimestamp_Get();
+
+	IPC_SEMFree(IPC_SEM_GDMA);
+
+	return RTK_SUCCESS;
+}
+
+/**
+  * @brief  Allocate a channel for a QoS class.
+  * @param  GDMA_Index: 0.
+  * @param  Req: pointer to a GDMA_QosReqTypeDef structure.
+  * @retval GDMA_ChNum, or 0xFF if no channel is available.
+  * @note   Task context only. The channel priority is set from the class, GDMA_Init() keeps it.
+  *         The PreemptCb of a channel taken back is called before this function returns.
+  */
+u8 GDMA_QosChnlAlloc(u32 GDMA_Index, GDMA_QosReqTypeDef *Req)
+{
+	void (*PreemptCb)(void *Data, u8 GDMA_ChNum) = NULL;
+	void *PreemptData = NULL;
+	u32 QosClass = Req->QosClass;
+	u32 GDMA_ChNum, reserved, mask;
+	u8 ValTemp;
+
+	assert_param(IS_GDMA_Index(GDMA_Index));
+	assert_param(IS_GDMA_QOS_CLASS(QosClass));
+
+	if (IPC_SEMTake(IPC_SEM_GDMA, 1000) == FALSE) {
+		GDMA_Qos.Stats.AllocFails[QosClass]++;
+		return 0xFF;
+	}
+
+	reserved = GDMA_Qos.Reserved[GDMA_QOS_RT] | GDMA_Qos.Reserved[GDMA_QOS_BULK] | GDMA_Qos.Reserved[GDMA_QOS_BG];
+	ValTemp = HAL_READ8(SYSTEM_CTRL_BASE, REG_LSYS_BOOT_REASON_SW + 3);
+
+	GDMA_ChNum = GDMA_QosPick(QosClass, GDMA_Qos.Reserved[QosClass] & ~GDMA_Qos.Owned);
+
+	if (GDMA_ChNum == 0xFF) {
+		GDMA_ChNum = GDMA_QosPick(QosClass, ~(ValTemp | reserved));
+	}
+
+	if (GDMA_ChNum == 0xFF && QosClass == GDMA_QOS_BULK) {
+		/* borrow from the lowest priority reservation first, its highest channel number first */
+		GDMA_ChNum = GDMA_QosPick(GDMA_QOS_BG, GDMA_Qos.Reserved[GDMA_QOS_BG] & ~GDMA_Qos.Owned);
+		if (GDMA_ChNum == 0xFF) {
+			GDMA_ChNum = GDMA_QosPick(GDMA_QOS_BG, GDMA_Qos.Reserved[GDMA_QOS_RT] & ~GDMA_Qos.Owned);
+		}
+		if (GDMA_ChNum != 0xFF) {
+			GDMA_Qos.Borrowed |= BIT(GDMA_ChNum);
+			GDMA_Qos.Stats.Borrows++;
+		}
+	}
+
+	if (GDMA_ChNum == 0xFF) {
+		mask = GDMA_Qos.Reserved[QosClass] & GDMA_Qos.Borrowed;
+		while (mask) {
+			GDMA_ChNum = __builtin_ctz(mask);
+			mask &= ~BIT(GDMA_ChNum);
+
+			if (GDMA_Abort(GDMA_Index, GDMA_ChNum) == FALSE) {
+				GDMA_ChNum = 0xFF;
+				continue;
+			}
+
+			GDMA_ClearINT(GDMA_Index, GDMA_ChNum);
+			InterruptDis(GDMA_IrqNum[GDMA_ChNum]);
+			InterruptUnRegister(GDMA_IrqNum[GDMA_ChNum]);
+
+			PreemptCb = GDMA_Qos.PreemptCb[GDMA_ChNum];
+			PreemptData = GDMA_Qos.PreemptData[GDMA_ChNum];
+			GDMA_QosDetach(GDMA_Index, GDMA_ChNum);
+
+			GDMA_Qos.Stats.Chnl[GDMA_ChNum].Preempted++;
+			GDMA_Qos.Stats.Preempts++;
+			break;
+		}
+	}
+
+	if (GDMA_ChNum != 0xFF) {
+		GDMA_ChnlRegister(GDMA_Index, GDMA_ChNum, Req->IrqFun, Req->IrqData, Req->IrqPriority);
+		GDMA_SetChnlPriority(GDMA_Index, GDMA_ChNum, GDMA_QosPrior[QosClass]);
+
+		GDMA_Qos.Owned |= BIT(GDMA_ChNum);
+		GDMA_Qos.PreemptCb[GDMA_ChNum] = Req->PreemptCb;
+		GDMA_Qos.PreemptData[GDMA_ChNum] = Req->PreemptData;
+		GDMA_Qos.Stats.Chnl[GDMA_ChNum].Allocs++;
+	} else {
+		GDMA_Qos.Stats.AllocFails[QosClass]++;
+	}
+
+	IPC_SEMFree(IPC_SEM_GDMA);
+
+	if (PreemptCb != NULL) {
+		PreemptCb(PreemptData, GDMA_ChNum);
+	}
+
+	return GDMA_ChNum;
+}
+
+/**
+  * @brief  Free a channel allocated by GDMA_QosChnlAlloc().
+  * @param  GDMA_Index: 0.
+  * @param  GDMA_ChNum: 0 ~ 7.
+  * @retval TRUE/FALSE
+  * @note   A reserved channel goes back to its reservation, an unreserved channel is freed for GDMA_ChnlAlloc().
+  */
+u8 GDMA_QosChnlFree(u8 GDMA_Index, u8 GDMA_ChNum)
+{
+	GDMA_TypeDef *GDMA = NULL;
+	u32 reserved;
+
+	assert_param(IS_GDMA_Index(GDMA_Index));
+	assert_param(IS_GDMA_ChannelNum(GDMA_ChNum));
+
+	/* Owned is only stable under the semaphore, GDMA_QosChnlAlloc() may be taking the channel back */
+	if (IPC_SEMTake(IPC_SEM_GDMA, 1000) == FALSE) {
+		return FALSE;
+	}
+
+	if ((GDMA_Qos.Owned & BIT(GDMA_ChNum)) == 0) {
+		IPC_SEMFree(IPC_SEM_GDMA);
+		return FALSE;
+	}
+
+	reserved = GDMA_Qos.Reserved[GDMA_QOS_RT] | GDMA_Qos.Reserved[GDMA_QOS_BULK] | GDMA_Qos.Reserved[GDMA_QOS_BG];
+
+	if (TrustZone_IsSecure()) {
+		GDMA = ((GDMA_TypeDef *) GDMA0_REG_BASE_S);
+		GDMA->CH[GDMA_ChNum].GDMA_CFGx_H |= GDMA_BIT_CFGx_H_PROTCTL;
+	}
+
+	if (reserved & BIT(GDMA_ChNum)) {
+		InterruptDis(GDMA_IrqNum[GDMA_ChNum]);
+		InterruptUnRegister(GDMA_IrqNum[GDMA_ChNum]);
+	} else {
+		GDMA_ChnlUnRegister(GDMA_Index, GDMA_ChNum);
+	}
+	GDMA_QosDetach(GDMA_Index, GDMA_ChNum);
+
+	IPC_SEMFree(IPC_SEM_GDMA);
+
+	return TRUE;
+}
+
+/**
+  * @brief  Account the start of a transfer on a channel.
+  * @param  GDMA_Index: 0.
+  * @param  GDMA_ChNum: 0 ~ 7.
+  * @param  Bytes: bytes the transfer moves.
+  * @retval None
+  */
+void GDMA_QosXferStart(u8 GDMA_Index, u8 GDMA_ChNum, u32 Bytes)
+{
+	u32 PrevStatus = __get_PRIMASK();
+
+	assert_param(IS_GDMA_Index(GDMA_Index));
+	assert_param(IS_GDMA_ChannelNum(GDMA_ChNum));
+
+	__disable_irq();
+	GDMA_Qos.XferStart[GDMA_ChNum] = DTimestamp_Get();
+	GDMA_Qos.XferBytes[GDMA_ChNum] = Bytes;
+	GDMA_Qos.Busy |= BIT(GDMA_ChNum);
+	__set_PRIMASK(PrevStatus);
+}
+
+/**
+  * @brief  Account the completion of a transfer on a channel, may be called from the GDMA IRQ callback.
+  * @param  GDMA_Index: 0.
+  * @param  GDMA_ChNum: 0 ~ 7.
+  * @retval None
+  */
+void GDMA_QosXferDone(u8 GDMA_Index, u8 GDMA_ChNum)
+{
+	GDMA_QosChnlStatsTypeDef *st = &GDMA_Qos.Stats.Chnl[GDMA_ChNum];
+	u32 PrevStatus = __get_PRIMASK();
+
+	assert_param(IS_GDMA_Index(GDMA_Index));
+	assert_param(IS_GDMA_ChannelNum(GDMA_ChNum));
+
+	__disable_irq();
+	if (GDMA_Qos.Busy & BIT(GDMA_ChNum)) {
+		st->BusyUs += DTimestamp_Get() - GDMA_Qos.XferStart[GDMA_ChNum];
+		st->Bytes += GDMA_Qos.XferBytes[GDMA_ChNum];
+		st->Xfers++;
+		GDMA_Qos.Busy &= ~BIT(GDMA_ChNum);
+	}
+	__set_PRIMASK(PrevStatus);
+}
+
+/**
+  * @brief  Get a snapshot of the QoS statistics.
+  * @param  GDMA_Index: 0.
+  * @param  Stats: pointer to the statistics copy.
+  * @retval None
+  */
+void GDMA_QosGetStats(u8 GDMA_Index, GDMA_QosStatsTypeDef *Stats)
+{
+	u32 PrevStatus = __get_PRIMASK();
+
+	assert_param(IS_GDMA_Index(GDMA_Index));
+
+	__disable_irq();
+	*Stats = GDMA_Qos.Stats;
+	Stats->WindowUs = DTimestamp_Get() - GDMA_Qos.InitTime;
+	__set_PRIMASK(PrevStatus);
+}
+
 /**
   * @}
   */
@@ -323,6 +323,62 @@ void I2C_Init(I2C_TypeDef *I2Cx, I2C_InitTypeDef *I2C_InitStruct)
 	I2C_INTConfig(I2Cx, 0xFFFFFFFF, DISABLE);
 }
 
+/* SCL high and low counts of one bus clock, HCNT << 16 | LCNT */
+static u32 i2c_scl_cnt(u32 I2Clk, u32 HTime, u32 LTime, u32 IPClkM)
+{
+	u32 ICHtime = ((1000000 / I2Clk) * HTime) / (HTime + LTime);
+	u32 ICLtime = ((1000000 / I2Clk) * LTime) / (HTime + LTime);
+
+	return (((ICHtime * IPClkM + 500) / 1000) << 16) | ((ICLtime * IPClkM + 500) / 1000);
+}
+
+/* SCL counts of a speed mode, McCnt gets the fast speed counts of the HS master code */
+static u32 i2c_speed_cnt(u32 SpdMd, u32 I2Clk, u32 IPClkM, u32 *McCnt)
+{
+	*McCnt = 0;
+
+	switch (SpdMd) {
+	case I2C_SS_MODE:
+		return i2c_scl_cnt(I2Clk, I2C_SS_MIN_SCL_HTIME, I2C_SS_MIN_SCL_LTIME, IPClkM);
+
+	case I2C_FS_MODE:
+		return i2c_scl_cnt(I2Clk, I2C_FS_MIN_SCL_HTIME, I2C_FS_MIN_SCL_LTIME, IPClkM);
+
+	case I2C_HS_MODE:
+		/*set Fast mode count for Master code*/
+		*McCnt = i2c_scl_cnt(400, I2C_FS_MIN_SCL_HTIME, I2C_FS_MIN_SCL_LTIME, IPClkM);
+		return i2c_scl_cnt(I2Clk, I2C_HS_MIN_SCL_HTIME_100, I2C_HS_MIN_SCL_LTIME_100, IPClkM);
+
+	default:
+		return 0;
+	}
+}
+
+static void i2c_speed_write(I2C_TypeDef *I2Cx, u32 SpdMd, u32 Cnt, u32 McCnt)
+{
+	switch (SpdMd) {
+	case I2C_SS_MODE:
+		I2Cx->IC_SS_SCL_HCNT = Cnt >> 16;
+		I2Cx->IC_SS_SCL_LCNT = Cnt & 0xFFFF;
+		break;
+
+	case I2C_FS_MODE:
+		I2Cx->IC_FS_SCL_HCNT = Cnt >> 16;
+		I2Cx->IC_FS_SCL_LCNT = Cnt & 0xFFFF;
+		break;
+
+	case I2C_HS_MODE:
+		I2Cx->IC_FS_SCL_HCNT = McCnt >> 16;
+		I2Cx->IC_FS_SCL_LCNT = McCnt & 0xFFFF;
+		I2Cx->IC_HS_SCL_HCNT = Cnt >> 16;
+		I2Cx->IC_HS_SCL_LCNT = Cnt & 0xFFFF;
+		break;
+
+	default:
+		break;
+	}
+}
+
 /**
   * @brief  Master sets I2C Speed Mode.
   * @param  I2Cx: where I2Cx can be I2C0_DEV, I2C1_DEV and I2C2_DEV.
@@ -343,64 +399,98 @@ void I2C_Init(I2C_TypeDef *I2Cx, I2C_InitTypeDef *I2C_InitStruct)
   */
 void I2C_SetSpeed(I2C_TypeDef *I2Cx, u32 SpdMd, u32 I2Clk, u32 I2CIPClk)
 {
-	u32 ICHLcnt;
-	u32 ICHtime;
-	u32 ICLtime;
-	u32 IPClkM = I2CIPClk / 1000000;
-
-	switch (SpdMd) {
-	case I2C_SS_MODE: {
-		ICHtime = ((1000000 / I2Clk) * I2C_SS_MIN_SCL_HTIME) / (I2C_SS_MIN_SCL_HTIME + I2C_SS_MIN_SCL_LTIME);
-		ICLtime = ((1000000 / I2Clk) * I2C_SS_MIN_SCL_LTIME) / (I2C_SS_MIN_SCL_HTIME + I2C_SS_MIN_SCL_LTIME);
-
-		ICHLcnt = (ICHtime * IPClkM + 500) / 1000;
-		I2Cx->IC_SS_SCL_HCNT = ICHLcnt;
+	u32 Cnt, McCnt;
 
-		ICHLcnt = (ICLtime * IPClkM + 500) / 1000;
-		I2Cx->IC_SS_SCL_LCNT = ICHLcnt;
+	Cnt = i2c_speed_cnt(SpdMd, I2Clk, I2CIPClk / 1000000, &McCnt);
+	i2c_speed_write(I2Cx, SpdMd, Cnt, McCnt);
+}
 
-		break;
+static int i2c_clk_notify(void *Data, u32 Event, const CLK_RateChangeTypeDef *Change)
+{
+	I2C_ClkBindTypeDef *Bind = (I2C_ClkBindTypeDef *)Data;
+	I2C_TypeDef *I2Cx = Bind->I2Cx;
+	u32 SrcHz = Change->NewRate[Bind->ClkId];
+	u32 Cnt, McCnt = 0, Enable;
+
+	if (Event == CLK_EVT_PRE_CHANGE) {
+		if (CLK_DivTableLookup(Bind->Cnt, Bind->Num, SrcHz, &Cnt) != RTK_SUCCESS) {
+			RTK_LOGW(TAG, "No SCL counts for %lu Hz\n", SrcHz);
+			return RTK_FAIL;
+		}
+		/* a transfer would run on with counts of the old clock */
+		if (I2C_CheckFlagState(I2Cx, I2C_BIT_ACTIVITY)) {
+			return RTK_FAIL;
+		}
+		return RTK_SUCCESS;
 	}
 
-	case I2C_FS_MODE: {
-		ICHtime = ((1000000 / I2Clk) * I2C_FS_MIN_SCL_HTIME) / (I2C_FS_MIN_SCL_HTIME + I2C_FS_MIN_SCL_LTIME);
-		ICLtime = ((1000000 / I2Clk) * I2C_FS_MIN_SCL_LTIME) / (I2C_FS_MIN_SCL_HTIME + I2C_FS_MIN_SCL_LTIME);
-
-		ICHLcnt = (ICHtime * IPClkM + 500) / 1000;
-		I2Cx->IC_FS_SCL_HCNT = ICHLcnt;
+	if (Event != CLK_EVT_POST_CHANGE) {
+		return RTK_SUCCESS;
+	}
 
-		ICHLcnt = (ICLtime * IPClkM + 500) / 1000;
-		I2Cx->IC_FS_SCL_LCNT = ICHLcnt;
+	CLK_DivTableLookup(Bind->Cnt, Bind->Num, SrcHz, &Cnt);
+	CLK_DivTableLookup(Bind->McCnt, Bind->Num, SrcHz, &McCnt);
 
-		break;
+	/* the SCL count registers can be written only with the I2C disabled */
+	Enable = I2Cx->IC_ENABLE & I2C_BIT_ENABLE;
+	I2C_Cmd(I2Cx, DISABLE);
+	i2c_speed_write(I2Cx, Bind->SpdMd, Cnt, McCnt);
+	if (Enable) {
+		I2C_Cmd(I2Cx, ENABLE);
 	}
 
-	case I2C_HS_MODE: {
-		/*set Fast mode count for Master code*/
-		ICHtime = ((1000000 / 400) * I2C_FS_MIN_SCL_HTIME) / (I2C_FS_MIN_SCL_HTIME + I2C_FS_MIN_SCL_LTIME);
-		ICLtime = ((1000000 / 400) * I2C_FS_MIN_SCL_LTIME) / (I2C_FS_MIN_SCL_HTIME + I2C_FS_MIN_SCL_LTIME);
+	return RTK_SUCCESS;
+}
 
-		ICHLcnt = (ICHtime * IPClkM + 500) / 1000;
-		I2Cx->IC_FS_SCL_HCNT = ICHLcnt;
+/**
+  * @brief  Keep the SCL speed of an I2C master across clock tree rate changes.
+  * @param  Bind: storage provided by the driver, owned by the clock tree until I2C_ClkUnbind().
+  * @param  I2Cx: where I2Cx can be I2C0_DEV, I2C1_DEV and I2C2_DEV.
+  * @param  SpdMd: I2C Speed Mode, as given to I2C_SetSpeed().
+  * @param  I2Clk: I2C Bus Clock, unit is KHz.
+  * @param  ClkId: clock tree node the I2C IP clock is taken from, @ref CLK_Tree_Node.
+  * @param  SrcHz: every rate of this node the application may switch to.
+  * @param  Num: number of rates, 1 ~ I2C_CLK_RATE_MAX.
+  * @retval RTK_SUCCESS or RTK_ERR_BADARG.
+  * @note   The SCL counts of every rate are computed here, the change path only looks them up.
+  *         A change to a rate out of the table, or while the I2C is active, is vetoed.
+  */
+int I2C_ClkBind(I2C_ClkBindTypeDef *Bind, I2C_TypeDef *I2Cx, u32 SpdMd, u32 I2Clk, u32 ClkId, const u32 *SrcHz, u32 Num)
+{
+	u32 i;
 
-		ICHLcnt = (ICLtime * IPClkM + 500) / 1000;
-		I2Cx->IC_FS_SCL_LCNT = ICHLcnt;
+	if (Num == 0 || Num > I2C_CLK_RATE_MAX || ClkId >= CLK_ID_NUM || I2Clk == 0) {
+		return RTK_ERR_BADARG;
+	}
 
-		ICHtime = ((1000000 / I2Clk) * I2C_HS_MIN_SCL_HTIME_100) / (I2C_HS_MIN_SCL_HTIME_100 + I2C_HS_MIN_SCL_LTIME_100);
-		ICLtime = ((1000000 / I2Clk) * I2C_HS_MIN_SCL_LTIME_100) / (I2C_HS_MIN_SCL_HTIME_100 + I2C_HS_MIN_SCL_LTIME_100);
+	_memset((void *)Bind, 0, sizeof(I2C_ClkBindTypeDef));
+	Bind->I2Cx = I2Cx;
+	Bind->SpdMd = SpdMd;
+	Bind->ClkId = ClkId;
+	Bind->Num = Num;
 
-		ICHLcnt = (ICHtime * IPClkM + 500) / 1000;
-		I2Cx->IC_HS_SCL_HCNT = ICHLcnt;
+	for (i = 0; i < Num; i++) {
+		Bind->Cnt[i].SrcHz = SrcHz[i];
+		Bind->Cnt[i].Val = i2c_speed_cnt(SpdMd, I2Clk, SrcHz[i] / 1000000, &Bind->McCnt[i].Val);
+		Bind->McCnt[i].SrcHz = SrcHz[i];
+	}
 
-		ICHLcnt = (ICLtime * IPClkM + 500) / 1000;
-		I2Cx->IC_HS_SCL_LCNT = ICHLcnt;
+	Bind->Notifier.Cb = i2c_clk_notify;
+	Bind->Notifier.Data = Bind;
+	Bind->Notifier.ClkMask = BIT(ClkId);
+	CLK_NotifierRegister(&Bind->Notifier);
 
-		break;
-	}
+	return RTK_SUCCESS;
+}
 
-	default:
-		break;
-	}
+/**
+  * @brief  Stop following the clock tree rate changes.
+  * @param  Bind: binding set up by I2C_ClkBind().
+  * @retval None
+  */
+void I2C_ClkUnbind(I2C_ClkBindTypeDef *Bind)
+{
+	CLK_NotifierUnregister(&Bind->Notifier);
 }
 
 /**
@@ -0,0 +1,662 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ameba_soc.h"
+
+static const char *const TAG = "IRCODEC";
+
+/** @addtogroup Ameba_Periph_Driver
+  * @{
+  */
+
+/** @defgroup IR_CODEC
+  * @brief IR_CODEC driver modules
+  * @{
+  */
+
+enum {
+	IR_CODEC_T_NEC_HDR_MARK = 0,
+	IR_CODEC_T_NEC_HDR_SPACE,
+	IR_CODEC_T_NEC_RPT_SPACE,
+	IR_CODEC_T_NEC_BIT_MARK,
+	IR_CODEC_T_NEC_ZERO_SPACE,
+	IR_CODEC_T_NEC_ONE_SPACE,
+	IR_CODEC_T_SONY_HDR_MARK,
+	IR_CODEC_T_SONY_ONE_MARK,
+	IR_CODEC_T_SONY_ZERO_MARK,
+	IR_CODEC_T_SONY_SPACE,
+	IR_CODEC_T_RC5_UNIT,
+	IR_CODEC_T_RC6_LEADER_MARK,
+	IR_CODEC_T_RC6_UNIT,
+};
+
+/* nominal durations in us, indexed as above */
+static const u16 ir_codec_timing[IR_CODEC_TIMING_NUM] = {
+	9000, 4500, 2250, 560, 560, 1690,
+	2400, 1200, 600, 600,
+	889,
+	2666, 444,
+};
+
+#define IR_CODEC_MARK				IR_BIT_RX_LEVEL
+#define IR_CODEC_CNT(d)				((d) & IR_MASK_RX_CNT)
+#define IR_CODEC_HALF_MAX			44		/* RC6 mode 0 after the leader */
+
+#define IR_CODEC_RING(idx)			((idx) & (IR_CODEC_FRAME_QUEUE - 1))
+
+static void ir_codec_emit(IR_CODEC_TypeDef *codec, u32 mark, u32 ticks)
+{
+	u32 type = mark ? IR_BIT_TX_DATA_TYPE : 0;
+
+	/* the line idles without carrier, a leading space is not sent */
+	if (codec->WordNum == 0 && !mark) {
+		return;
+	}
+
+	if (codec->WordNum && (codec->Word[codec->WordNum - 1] & IR_BIT_TX_DATA_TYPE) == type) {
+		codec->Word[codec->WordNum - 1] += ticks;
+		return;
+	}
+
+	if (codec->WordNum < IR_CODEC_WORD_MAX) {
+		codec->Word[codec->WordNum++] = type | ticks;
+	}
+}
+
+/* Manchester bit as two halves of Unit ticks, Mark1st tells the level of the first half */
+static void ir_codec_emit_bit(IR_CODEC_TypeDef *codec, u32 mark1st, u32 ticks)
+{
+	ir_codec_emit(codec, mark1st, ticks);
+	ir_codec_emit(codec, !mark1st, ticks);
+}
+
+static inline bool ir_codec_in(IR_CODEC_TypeDef *codec, u32 d, u32 mark, u32 sym)
+{
+	u32 cnt = IR_CODEC_CNT(d);
+
+	return ((d & IR_CODEC_MARK) == (mark ? IR_CODEC_MARK : 0)) && cnt >= codec->RxLo[sym] && cnt <= codec->RxHi[sym];
+}
+
+/* Split durations from Word[Start] into halves of the Unit symbol, one bit per half (1 for a mark) */
+static bool ir_codec_halves(IR_CODEC_TypeDef *codec, u32 Start, u32 Unit, u32 MaxUnits, u64 *Halves, u32 *Num)
+{
+	u32 unit = (codec->RxLo[Unit] + codec->RxHi[Unit]) / 2;
+	u32 tol = unit - codec->RxLo[Unit];
+	u32 i, k, cnt, err;
+
+	for (i = Start; i < codec->WordNum; i++) {
+		cnt = IR_CODEC_CNT(codec->Word[i]);
+		k = (cnt + unit / 2) / unit;
+		err = cnt > k * unit ? cnt - k * unit : k * unit - cnt;
+		if (k == 0 || k > MaxUnits || err > tol * k || *Num + k > 64) {
+			return FALSE;
+		}
+		while (k--) {
+			if (codec->Word[i] & IR_CODEC_MARK) {
+				*Halves |= (u64)1 << *Num;
+			}
+			(*Num)++;
+		}
+	}
+
+	return TRUE;
+}
+
+static bool ir_codec_decode_nec(IR_CODEC_TypeDef *codec, IR_CODEC_FrameTypeDef *Frame)
+{
+	u32 *d = codec->Word;
+	u32 v = 0;
+	u32 i;
+
+	if (codec->WordNum >= 3 && ir_codec_in(codec, d[1], 0, IR_CODEC_T_NEC_RPT_SPACE) &&
+		ir_codec_in(codec, d[2], 1, IR_CODEC_T_NEC_BIT_MARK)) {
+		Frame->Repeat = TRUE;
+		return TRUE;
+	}
+
+	if (codec->WordNum < 67 || !ir_codec_in(codec, d[1], 0, IR_CODEC_T_NEC_HDR_SPACE)) {
+		return FALSE;
+	}
+
+	for (i = 0; i < 32; i++) {
+		if (!ir_codec_in(codec, d[2 + 2 * i], 1, IR_CODEC_T_NEC_BIT_MARK)) {
+			return FALSE;
+		}
+		if (ir_codec_in(codec, d[3 + 2 * i], 0, IR_CODEC_T_NEC_ONE_SPACE)) {
+			v |= BIT(i);
+		} else if (!ir_codec_in(codec, d[3 + 2 * i], 0, IR_CODEC_T_NEC_ZERO_SPACE)) {
+			return FALSE;
+		}
+	}
+
+	if ((((v >> 16) ^ (v >> 24)) & 0xFF) != 0xFF) {
+		return FALSE;
+	}
+
+	Frame->Command = (v >> 16) & 0xFF;
+	if (((v ^ (v >> 8)) & 0xFF) == 0xFF) {
+		Frame->Address = v & 0xFF;
+	} else {
+		Frame->Address = v & 0xFFFF;
+	}
+
+	return TRUE;
+}
+
+static bool ir_codec_decode_sony(IR_CODEC_TypeDef *codec, IR_CODEC_FrameTypeDef *Frame)
+{
+	u32 *d = codec->Word;
+	u32 v = 0;
+	u32 bits = 0;
+	u32 i;
+
+	if (!ir_codec_in(codec, d[1], 0, IR_CODEC_T_SONY_SPACE)) {
+		return FALSE;
+	}
+
+	/* the space after the last bit is part of the frame gap */
+	for (i = 2; i < codec->WordNum; i += 2) {
+		if (ir_codec_in(codec, d[i], 1, IR_CODEC_T_SONY_ONE_MARK)) {
+			v |= BIT(bits);
+		} else if (!ir_codec_in(codec, d[i], 1, IR_CODEC_T_SONY_ZERO_MARK)) {
+			return FALSE;
+		}
+		bits++;
+		if (i + 1 < codec->WordNum && !ir_codec_in(codec, d[i + 1], 0, IR_CODEC_T_SONY_SPACE)) {
+			return FALSE;
+		}
+	}
+
+	if (bits != 12 && bits != 15 && bits != 20) {
+		return FALSE;
+	}
+
+	Frame->Bits = bits;
+	Frame->Command = v & 0x7F;
+	Frame->Address = v >> 7;
+
+	return TRUE;
+}
+
+static bool ir_codec_decode_rc5(IR_CODEC_TypeDef *codec, IR_CODEC_FrameTypeDef *Frame)
+{
+	u64 h = 0;
+	u32 num = 1;				/* first half of S1 is a space, merged with the idle line */
+	u32 v = 0;
+	u32 i, first;
+
+	if (!ir_codec_halves(codec, 0, IR_CODEC_T_RC5_UNIT, 2, &h, &num)) {
+		return FALSE;
+	}
+
+	/* a frame ending with a 0 bit lost its last space half in the gap */
+	if (num == 27) {
+		num++;
+	}
+	if (num != 28) {
+		return FALSE;
+	}
+
+	for (i = 0; i < 14; i++) {
+		first = (h >> (2 * i)) & 1;
+		if (first == ((h >> (2 * i + 1)) & 1)) {
+			return FALSE;
+		}
+		/* space then mark is a 1 */
+		v = (v << 1) | (first ^ 1);
+	}
+
+	Frame->Toggle = (v >> 11) & 1;
+	Frame->Address = (v >> 6) & 0x1F;
+	Frame->Command = (v & 0x3F) | ((v & BIT(12)) ? 0 : 0x40);
+
+	return TRUE;
+}
+
+static bool ir_codec_decode_rc6(IR_CODEC_TypeDef *codec, IR_CODEC_FrameTypeDef *Frame)
+{
+	u64 h = 0;
+	u32 num = 0;
+	u32 v = 0;
+	u32 i, first, toggle;
+
+	if (codec->WordNum < 3 || IR_CODEC_CNT(codec->Word[1]) < codec->RxLo[IR_CODEC_T_RC6_UNIT] * 2 ||
+		IR_CODEC_CNT(codec->Word[1]) > codec->RxHi[IR_CODEC_T_RC6_UNIT] * 2 ||
+		!ir_codec_halves(codec, 2, IR_CODEC_T_RC6_UNIT, 3, &h, &num)) {
+		return FALSE;
+	}
+
+	/* a frame ending with a 1 bit lost its last space half in the gap */
+	if (num == IR_CODEC_HALF_MAX - 1) {
+		num++;
+	}
+	if (num != IR_CODEC_HALF_MAX) {
+		return FALSE;
+	}
+
+	/* start bit 1, mode 0 */
+	if ((h & 0xFF) != 0xA9) {
+		return FALSE;
+	}
+
+	/* trailer bit is two double halves */
+	first = (h >> 8) & 1;
+	if (((h >> 9) & 1) != first || ((h >> 10) & 1) == first || ((h >> 11) & 1) == first) {
+		return FALSE;
+	}
+	toggle = first;
+
+	for (i = 0; i < 16; i++) {
+		first = (h >> (12 + 2 * i)) & 1;
+		if (first == ((h >> (13 + 2 * i)) & 1)) {
+			return FALSE;
+		}
+		/* mark then space is a 1 */
+		v = (v << 1) | first;
+	}
+
+	Frame->Toggle = toggle;
+	Frame->Address = v >> 8;
+	Frame->Command = v & 0xFF;
+
+	return TRUE;
+}
+
+static void ir_codec_tx_fill(IR_CODEC_TypeDef *codec)
+{
+	u32 free = IR_GetTxFIFOFreeLen(codec->IRx);
+
+	while (free-- && codec->WordPos < codec->WordNum) {
+		IR_SendData(codec->IRx, codec->Word[codec->WordPos++]);
+	}
+}
+
+static void ir_codec_rx_frame(IR_CODEC_TypeDef *codec)
+{
+	IR_CODEC_FrameTypeDef frame;
+	u8 head = codec->RxHead;
+
+	if (codec->RxDrop || codec->WordNum == 0) {
+		codec->RxDrop = FALSE;
+		codec->WordNum = 0;
+		return;
+	}
+
+	if (!IR_CODEC_Decode(codec, &frame)) {
+		codec->Stats.RxErrors++;
+		codec->WordNum = 0;
+		return;
+	}
+	codec->WordNum = 0;
+
+	if ((u8)(head - codec->RxTail) >= IR_CODEC_FRAME_QUEUE) {
+		codec->Stats.RxQueueFull++;
+		return;
+	}
+
+	codec->Rx[IR_CODEC_RING(head)] = frame;
+	codec->RxHead = head + 1;
+	codec->Stats.RxFrames++;
+	if (frame.Repeat) {
+		codec->Stats.RxRepeats++;
+	}
+
+	if (codec->Cfg.IR_CodecCb) {
+		codec->Cfg.IR_CodecCb(codec->Cfg.IR_CodecCbData, IR_CODEC_EVT_RX_FRAME);
+	}
+}
+
+/**
+  * @brief  Fill each IR_CODEC_InitTypeDef member with its default value.
+  * @param  IR_CodecInitStruct: pointer to an IR_CODEC_InitTypeDef structure.
+  * @retval None
+  */
+void IR_CODEC_StructInit(IR_CODEC_InitTypeDef *IR_CodecInitStruct)
+{
+	_memset((void *)IR_CodecInitStruct, 0, sizeof(IR_CODEC_InitTypeDef));
+	IR_CodecInitStruct->IR_CodecTolPct = 25;
+	IR_CodecInitStruct->IR_CodecGapUs = 8000;
+	IR_CodecInitStruct->IR_CodecRptUs = 150000;
+}
+
+/**
+  * @brief  Initialize the codec and convert the protocol timings for the IR clocks.
+  * @param  codec: codec instance.
+  * @param  IRx: IR device, initialized by IR_Init().
+  * @param  IR_CodecInitStruct: pointer to an IR_CODEC_InitTypeDef structure.
+  * @retval RTK_SUCCESS or RTK_ERR_BADARG.
+  * @note   In RX mode the RX counter threshold of the IR is replaced by the frame gap.
+  */
+int IR_CODEC_Init(IR_CODEC_TypeDef *codec, IR_TypeDef *IRx, IR_CODEC_InitTypeDef *IR_CodecInitStruct)
+{
+	IR_InitTypeDef *ir = IR_CodecInitStruct->IR_Init;
+	u32 tol = IR_CodecInitStruct->IR_CodecTolPct;
+	u32 hz, i;
+
+	if (ir == NULL || tol == 0 || tol >= 50 || ir->IR_TxCOMP_CLK == 0 || ir->IR_Freq == 0) {
+		RTK_LOGE(TAG, "Invalid codec config\n");
+		return RTK_ERR_BADARG;
+	}
+
+	hz = ir->IR_Freq;
+	_memset((void *)codec, 0, sizeof(IR_CODEC_TypeDef));
+	codec->Cfg = *IR_CodecInitStruct;
+	codec->IRx = IRx;
+	codec->Mode = ir->IR_Mode;
+
+	for (i = 0; i < IR_CODEC_TIMING_NUM; i++) {
+		codec->TxTick[i] = (u32)((u64)ir_codec_timing[i] * ir->IR_TxCOMP_CLK / 1000000);
+		codec->RxLo[i] = (u32)((u64)ir_codec_timing[i] * (100 - tol) * hz / 100000000);
+		codec->RxHi[i] = (u32)((u64)ir_codec_timing[i] * (100 + tol) * hz / 100000000);
+	}
+
+	if (codec->Mode == IR_MODE_TX) {
+		IR_SetTxThreshold(IRx, IR_TX_FIFO_SIZE / 2);
+	} else {
+		/* the counter of the idle level ends a frame */
+		IR_SetRxCounterThreshold(IRx, codec->Cfg.IR_CodecMarkLevel ? 0 : IR_BIT_RX_CNT_THR_TRIGGER_LV,
+								 (u32)((u64)codec->Cfg.IR_CodecGapUs * ir->IR_Freq / 1000000));
+		IR_SetRxThreshold(IRx, IR_RX_FIFO_SIZE / 2);
+		IR_ClearINTPendingBit(IRx, IR_RX_INT_ALL_CLR);
+		IR_INTConfig(IRx, IR_BIT_RX_FIFO_LEVEL_INT_EN | IR_BIT_RX_CNT_THR_INT_EN | IR_BIT_RX_FIFO_OF_INT_EN, ENABLE);
+	}
+
+	return RTK_SUCCESS;
+}
+
+/**
+  * @brief  Encode a frame into TX FIFO words, codec->Word[0 ~ codec->WordNum - 1].
+  * @param  codec: codec instance.
+  * @param  Frame: frame to encode, TimeUs is not used.
+  * @retval RTK_SUCCESS or RTK_ERR_BADARG.
+  * @note   The frame ends with its last mark, the gap before a repeat is up to the caller.
+  */
+int IR_CODEC_Encode(IR_CODEC_TypeDef *codec, IR_CODEC_FrameTypeDef *Frame)
+{
+	u32 *t = codec->TxTick;
+	u32 v, bits, i;
+
+	codec->WordNum = 0;
+	codec->WordPos = 0;
+
+	switch (Frame->Protocol) {
+	case IR_CODEC_NEC:
+		ir_codec_emit(codec, 1, t[IR_CODEC_T_NEC_HDR_MARK]);
+		if (Frame->Repeat) {
+			ir_codec_emit(codec, 0, t[IR_CODEC_T_NEC_RPT_SPACE]);
+			ir_codec_emit(codec, 1, t[IR_CODEC_T_NEC_BIT_MARK]);
+			break;
+		}
+		ir_codec_emit(codec, 0, t[IR_CODEC_T_NEC_HDR_SPACE]);
+		v = Frame->Address > 0xFF ? Frame->Address : (Frame->Address | ((~Frame->Address & 0xFF) << 8));
+		v |= ((u32)(Frame->Command & 0xFF) << 16) | ((u32)(~Frame->Command & 0xFF) << 24);
+		for (i = 0; i < 32; i++) {
+			ir_codec_emit(codec, 1, t[IR_CODEC_T_NEC_BIT_MARK]);
+			ir_codec_emit(codec, 0, (v & BIT(i)) ? t[IR_CODEC_T_NEC_ONE_SPACE] : t[IR_CODEC_T_NEC_ZERO_SPACE]);
+		}
+		ir_codec_emit(codec, 1, t[IR_CODEC_T_NEC_BIT_MARK]);
+		break;
+
+	case IR_CODEC_SONY:
+		bits = Frame->Bits ? Frame->Bits : 12;
+		if (bits != 12 && bits != 15 && bits != 20) {
+			return RTK_ERR_BADARG;
+		}
+		v = (Frame->Command & 0x7F) | ((u32)Frame->Address << 7);
+		ir_codec_emit(codec, 1, t[IR_CODEC_T_SONY_HDR_MARK]);
+		for (i = 0; i < bits; i++) {
+			ir_codec_emit(codec, 0, t[IR_CODEC_T_SONY_SPACE]);
+			ir_codec_emit(codec, 1, (v & BIT(i)) ? t[IR_CODEC_T_SONY_ONE_MARK] : t[IR_CODEC_T_SONY_ZERO_MARK]);
+		}
+		break;
+
+	case IR_CODEC_RC5:
+		/* S1, S2 (inverted command bit 6), toggle, 5 address bits, 6 command bits, MSB first */
+		v = BIT(13) | ((Frame->Command & 0x40) ? 0 : BIT(12)) | ((Frame->Toggle & 1) << 11) |
+			((Frame->Address & 0x1F) << 6) | (Frame->Command & 0x3F);
+		for (i = 0; i < 14; i++) {
+			ir_codec_emit_bit(codec, !(v & BIT(13 - i)), t[IR_CODEC_T_RC5_UNIT]);
+		}
+		break;
+
+	case IR_CODEC_RC6:
+		ir_codec_emit(codec, 1, t[IR_CODEC_T_RC6_LEADER_MARK]);
+		ir_codec_emit(codec, 0, t[IR_CODEC_T_RC6_UNIT] * 2);
+		/* start bit 1, mode 000 */
+		ir_codec_emit_bit(codec, 1, t[IR_CODEC_T_RC6_UNIT]);
+		for (i = 0; i < 3; i++) {
+			ir_codec_emit_bit(codec, 0, t[IR_CODEC_T_RC6_UNIT]);
+		}
+		ir_codec_emit_bit(codec, Frame->Toggle & 1, t[IR_CODEC_T_RC6_UNIT] * 2);
+		v = ((u32)(Frame->Address & 0xFF) << 8) | (Frame->Command & 0xFF);
+		for (i = 0; i < 16; i++) {
+			ir_codec_emit_bit(codec, !!(v & BIT(15 - i)), t[IR_CODEC_T_RC6_UNIT]);
+		}
+		break;
+
+	default:
+		return RTK_ERR_BADARG;
+	}
+
+	/* trailing space is part of the gap */
+	if ((codec->Word[codec->WordNum - 1] & IR_BIT_TX_DATA_TYPE) == 0) {
+		codec->WordNum--;
+	}
+
+	/* ticks to FIFO words, real time = (IR_TX_DATA_TIME + 1) * compensation clock period */
+	for (i = 0; i < codec->WordNum; i++) {
+		v = codec->Word[i];
+		codec->Word[i] = (v & IR_BIT_TX_DATA_TYPE) | IR_TX_COMPENSATION(3) | IR_TX_DATA_TIME((v & IR_MASK_TX_DATA_TIME) - 1);
+	}
+	codec->Word[codec->WordNum - 1] |= IR_BIT_TX_DATA_END_FLAG;
+
+	return RTK_SUCCESS;
+}
+
+/**
+  * @brief  Decode the durations in codec->Word[0 ~ codec->WordNum - 1].
+  * @param  codec: codec instance.
+  * @param  Frame: decoded frame.
+  * @retval TRUE if a protocol matched.
+  * @note   Durations are RX sample counts with IR_BIT_RX_LEVEL set for a mark, starting
+  *         with a mark. Repeat and TimeUs are set against the previous decoded frame.
+  */
+bool IR_CODEC_Decode(IR_CODEC_TypeDef *codec, IR_CODEC_FrameTypeDef *Frame)
+{
+	u32 now = DTimestamp_Get();
+	u32 first;
+	bool ok = FALSE;
+
+	_memset((void *)Frame, 0, sizeof(IR_CODEC_FrameTypeDef));
+
+	if (codec->WordNum < 2) {
+		return FALSE;
+	}
+
+	/* RC6 leader and Sony header windows overlap, a failed protocol falls through to the next */
+	first = codec->Word[0];
+	if (ir_codec_in(codec, first, 1, IR_CODEC_T_NEC_HDR_MARK)) {
+		Frame->Protocol = IR_CODEC_NEC;
+		ok = ir_codec_decode_nec(codec, Frame);
+	}
+	if (!ok && ir_codec_in(codec, first, 1, IR_CODEC_T_RC6_LEADER_MARK)) {
+		Frame->Protocol = IR_CODEC_RC6;
+		ok = ir_codec_decode_rc6(codec, Frame);
+	}
+	if (!ok && ir_codec_in(codec, first, 1, IR_CODEC_T_SONY_HDR_MARK)) {
+		Frame->Protocol = IR_CODEC_SONY;
+		ok = ir_codec_decode_sony(codec, Frame);
+	}
+	if (!ok) {
+		Frame->Protocol = IR_CODEC_RC5;
+		ok = ir_codec_decode_rc5(codec, Frame);
+	}
+
+	if (!ok) {
+		return FALSE;
+	}
+
+	if (Frame->Repeat) {
+		/* NEC repeat code, only valid right after a NEC frame */
+		if (codec->Last.Protocol != IR_CODEC_NEC || codec->Last.TimeUs == 0 ||
+			now - codec->Last.TimeUs > codec->Cfg.IR_CodecRptUs) {
+			return FALSE;
+		}
+		Frame->Address = codec->Last.Address;
+		Frame->Command = codec->Last.Command;
+	} else if (Frame->Protocol != IR_CODEC_NEC && codec->Last.TimeUs != 0 &&
+			   now - codec->Last.TimeUs <= codec->Cfg.IR_CodecRptUs && Frame->Protocol == codec->Last.Protocol &&
+			   Frame->Address == codec->Last.Address && Frame->Command == codec->Last.Command &&
+			   Frame->Toggle == codec->Last.Toggle && Frame->Bits == codec->Last.Bits) {
+		Frame->Repeat = TRUE;
+	}
+
+	Frame->TimeUs = now;
+	codec->Last = *Frame;
+
+	return TRUE;
+}
+
+/**
+  * @brief  Encode a frame and start sending it, the FIFO is refilled from the interrupt.
+  * @param  codec: codec instance in TX mode.
+  * @param  Frame: frame to send.
+  * @retval RTK_SUCCESS, RTK_FAIL if the previous frame is still sent, or RTK_ERR_BADARG.
+  */
+int IR_CODEC_Send(IR_CODEC_TypeDef *codec, IR_CODEC_FrameTypeDef *Frame)
+{
+	IR_TypeDef *IRx = codec->IRx;
+	int ret;
+
+	if (codec->Mode != IR_MODE_TX) {
+		return RTK_ERR_BADARG;
+	}
+
+	if (codec->TxBusy || IR_FSMRunning(IRx)) {
+		return RTK_FAIL;
+	}
+
+	ret = IR_CODEC_Encode(codec, Frame);
+	if (ret != RTK_SUCCESS) {
+		return ret;
+	}
+
+	codec->TxBusy = TRUE;
+
+	IR_Cmd(IRx, IR_MODE_TX, DISABLE);
+	IR_ClearTxFIFO(IRx);
+	IR_ClearINTPendingBit(IRx, IR_TX_INT_ALL_CLR);
+	ir_codec_tx_fill(codec);
+
+	if (codec->WordPos < codec->WordNum) {
+		IR_INTConfig(IRx, IR_BIT_TX_FIFO_LEVEL_INT_EN, ENABLE);
+	} else {
+		IR_INTConfig(IRx, IR_BIT_TX_FIFO_EMPTY_INT_EN, ENABLE);
+	}
+	IR_Cmd(IRx, IR_MODE_TX, ENABLE);
+
+	return RTK_SUCCESS;
+}
+
+/**
+  * @brief  Take the oldest decoded frame.
+  * @param  codec: codec instance in RX mode.
+  * @param  Frame: decoded frame.
+  * @retval RTK_SUCCESS, or RTK_FAIL if no frame is queued.
+  */
+int IR_CODEC_Receive(IR_CODEC_TypeDef *codec, IR_CODEC_FrameTypeDef *Frame)
+{
+	if (codec->RxTail == codec->RxHead) {
+		return RTK_FAIL;
+	}
+
+	*Frame = codec->Rx[IR_CODEC_RING(codec->RxTail)];
+	codec->RxTail++;
+
+	return RTK_SUCCESS;
+}
+
+/**
+  * @brief  Refill the TX FIFO, or collect and decode RX durations.
+  * @param  codec: codec instance.
+  * @retval None
+  * @note   Called from the IR interrupt handler.
+  */
+void IR_CODEC_IRQHandler(IR_CODEC_TypeDef *codec)
+{
+	IR_TypeDef *IRx = codec->IRx;
+	u32 status = IR_GetINTStatus(IRx);
+	u32 level = codec->Cfg.IR_CodecMarkLevel ? IR_BIT_RX_LEVEL : 0;
+	u32 d, mark;
+
+	if (codec->Mode == IR_MODE_TX) {
+		/* TX events are FIFO levels, the clear bits do not line up with the status bits */
+		IR_ClearINTPendingBit(IRx, IR_TX_INT_ALL_CLR);
+
+		if (status & IR_BIT_TX_FIFO_LEVEL_INT_STATUS) {
+			ir_codec_tx_fill(codec);
+			if (codec->WordPos == codec->WordNum) {
+				IR_INTConfig(IRx, IR_BIT_TX_FIFO_LEVEL_INT_EN, DISABLE);
+				IR_INTConfig(IRx, IR_BIT_TX_FIFO_EMPTY_INT_EN, ENABLE);
+			}
+		} else if ((status & IR_BIT_TX_FIFO_EMPTY_INT_STATUS) && codec->WordPos == codec->WordNum) {
+			IR_INTConfig(IRx, IR_BIT_TX_FIFO_EMPTY_INT_EN, DISABLE);
+			codec->TxBusy = FALSE;
+			codec->Stats.TxFrames++;
+			if (codec->Cfg.IR_CodecCb) {
+				codec->Cfg.IR_CodecCb(codec->Cfg.IR_CodecCbData, IR_CODEC_EVT_TX_DONE);
+			}
+		}
+		return;
+	}
+
+	while (IR_GetRxDataLen(IRx)) {
+		d = IR_ReceiveData(IRx);
+		mark = ((d & IR_BIT_RX_LEVEL) == level) ? IR_CODEC_MARK : 0;
+
+		if (codec->WordNum == 0 && !mark) {
+			continue;
+		}
+		if (codec->WordNum && (codec->Word[codec->WordNum - 1] & IR_CODEC_MARK) == mark) {
+			codec->Word[codec->WordNum - 1] += IR_GET_RX_CNT(d);
+		} else if (codec->WordNum < IR_CODEC_WORD_MAX) {
+			codec->Word[codec->WordNum++] = mark | IR_GET_RX_CNT(d);
+		} else if (!codec->RxDrop) {
+			codec->RxDrop = TRUE;
+			codec->Stats.RxOverflows++;
+		}
+	}
+
+	if ((status & IR_BIT_RX_FIFO_OF_INT_STATUS) && !codec->RxDrop) {
+		codec->RxDrop = TRUE;
+		codec->Stats.RxOverflows++;
+	}
+
+	if (status & IR_BIT_RX_CNT_THR_INT_STATUS) {
+		ir_codec_rx_frame(codec);
+	}
+
+	IR_ClearINTPendingBit(IRx, status & IR_RX_INT_ALL_CLR);
+}
+
+/**
+  * @brief  Get a snapshot of the codec statistics.
+  * @param  codec: codec instance.
+  * @param  Stats: pointer to the statistics copy.
+  * @retval None
+  */
+void IR_CODEC_GetStats(IR_CODEC_TypeDef *codec, IR_CODEC_StatsTypeDef *Stats)
+{
+	u32 PrevStatus = __get_PRIMASK();
+
+	__disable_irq();
+	*Stats = codec->Stats;
+	__set_PRIMASK(PrevStatus);
+}
+
+/** @} */
+
+/** @} */
@@ -0,0 +1,430 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ameba_soc.h"
+
+/** @addtogroup Ameba_Periph_Driver
+  * @{
+  */
+
+/** @defgroup LCDC_FB
+  * @brief LCDC_FB driver modules
+  * @{
+  */
+
+/*
+ * Add line band [Y0, Y1) to a sorted band list. Bands overlapping or closer than Gap are
+ * merged, when the list overflows the two closest bands are merged.
+ */
+static u32 lcdc_fb_band_add(LCDC_FB_Band *Bands, u32 Num, u32 Y0, u32 Y1, u32 Gap)
+{
+	LCDC_FB_Band tmp[LCDC_FB_BAND_MAX + 1];
+	u32 i, j, best, best_gap;
+
+	for (i = 0, j = 0; i < Num && Bands[i].Y0 <= Y0; i++) {
+		tmp[j++] = Bands[i];
+	}
+	tmp[j].Y0 = Y0;
+	tmp[j++].Y1 = Y1;
+	for (; i < Num; i++) {
+		tmp[j++] = Bands[i];
+	}
+	Num = j;
+
+	for (i = 0, j = 0; i < Num; i++) {
+		if (j && tmp[i].Y0 <= tmp[j - 1].Y1 + Gap) {
+			tmp[j - 1].Y1 = MAX(tmp[j - 1].Y1, tmp[i].Y1);
+		} else {
+			tmp[j++] = tmp[i];
+		}
+	}
+	Num = j;
+
+	while (Num > LCDC_FB_BAND_MAX) {
+		best = 0;
+		best_gap = 0xFFFFFFFF;
+		for (i = 0; i + 1 < Num; i++) {
+			if ((u32)(tmp[i + 1].Y0 - tmp[i].Y1) < best_gap) {
+				best_gap = tmp[i + 1].Y0 - tmp[i].Y1;
+				best = i;
+			}
+		}
+		tmp[best].Y1 = tmp[best + 1].Y1;
+		for (i = best + 1; i + 1 < Num; i++) {
+			tmp[i] = tmp[i + 1];
+		}
+		Num--;
+	}
+
+	for (i = 0; i < Num; i++) {
+		Bands[i] = tmp[i];
+	}
+
+	return Num;
+}
+
+/* Record the bands of a presented frame: the presented buffer is clean, all others are stale there. */
+static void lcdc_fb_update_damage(LCDC_FB_TypeDef *fb, u8 Idx, LCDC_FB_Band *Bands, u32 Num)
+{
+	u32 buf, i;
+
+	for (buf = 0; buf < fb->Cfg.FB_BufNum; buf++) {
+		if (buf == Idx) {
+			fb->DamageNum[buf] = 0;
+			continue;
+		}
+		for (i = 0; i < Num; i++) {
+			fb->DamageNum[buf] = lcdc_fb_band_add(fb->Damage[buf], fb->DamageNum[buf], Bands[i].Y0, Bands[i].Y1,
+												  fb->Cfg.FB_BandGap);
+		}
+	}
+}
+
+static void lcdc_fb_flip_done(LCDC_FB_TypeDef *fb, u8 Idx)
+{
+	u32 latency = DTimestamp_Get() - fb->PresentTime[Idx];
+
+	fb->Stats.Flipped++;
+	fb->Stats.LatencyLastUs = latency;
+	fb->Stats.LatencySumUs += latency;
+	if (latency > fb->Stats.LatencyMaxUs) {
+		fb->Stats.LatencyMaxUs = latency;
+	}
+}
+
+static void lcdc_fb_mcu_push_band(LCDC_FB_TypeDef *fb)
+{
+	LCDC_FB_Band *band = &fb->Dirty[fb->Scanout][fb->BandIdx];
+	u32 lines = band->Y1 - band->Y0;
+
+	if (fb->Cfg.FB_SetWindow) {
+		fb->Cfg.FB_SetWindow(fb->Cfg.FB_CbData, band->Y0, band->Y1);
+	}
+
+	/* full width bands are contiguous in the framebuffer, no stride needed */
+	LCDC_PanelSizeConfig(fb->Cfg.LCDCx, fb->Cfg.FB_Width, lines);
+	LCDC_DMAImgCfg(fb->Cfg.LCDCx, fb->Cfg.FB_BufAddr[fb->Scanout] + band->Y0 * fb->Cfg.FB_Width * fb->Cfg.FB_Bpp);
+	LCDC_ShadowReloadConfig(fb->Cfg.LCDCx);
+	LCDC_MCUDMATrigger(fb->Cfg.LCDCx);
+
+	fb->Stats.PushedLines += lines;
+}
+
+static void lcdc_fb_mcu_start(LCDC_FB_TypeDef *fb)
+{
+	fb->Scanout = fb->Pending;
+	fb->Pending = LCDC_FB_INVALID;
+	fb->State[fb->Scanout] = LCDC_FB_BUF_SCANOUT;
+	fb->BandIdx = 0;
+	fb->Busy = 1;
+
+	lcdc_fb_mcu_push_band(fb);
+}
+
+static void lcdc_fb_rgb_vsync(LCDC_FB_TypeDef *fb)
+{
+	u32 addr_a, addr_b;
+	u8 i, active = LCDC_FB_INVALID;
+
+	fb->Stats.Vsyncs++;
+
+	/* shadow registers read back the active value, so this is the buffer latched at vblank */
+	LCDC_GetImgAddr(fb->Cfg.LCDCx, &addr_a, &addr_b);
+	for (i = 0; i < fb->Cfg.FB_BufNum; i++) {
+		if (fb->Cfg.FB_BufAddr[i] == addr_a) {
+			active = i;
+		}
+	}
+
+	if (active == LCDC_FB_INVALID || active == fb->Scanout) {
+		return;
+	}
+
+	/* a frame replaced in the same blanking window may still have been latched */
+	if (fb->State[active] == LCDC_FB_BUF_DROPPED) {
+		fb->Stats.Dropped--;
+	}
+	if (fb->Pending == active) {
+		fb->Pending = LCDC_FB_INVALID;
+	}
+
+	for (i = 0; i < fb->Cfg.FB_BufNum; i++) {
+		if (i != active && (fb->State[i] == LCDC_FB_BUF_SCANOUT || fb->State[i] == LCDC_FB_BUF_DROPPED)) {
+			fb->State[i] = LCDC_FB_BUF_FREE;
+		}
+	}
+
+	fb->State[active] = LCDC_FB_BUF_SCANOUT;
+	fb->Scanout = active;
+	lcdc_fb_flip_done(fb, active);
+
+	if (fb->Cfg.FB_VsyncCb) {
+		fb->Cfg.FB_VsyncCb(fb->Cfg.FB_CbData);
+	}
+}
+
+static void lcdc_fb_mcu_done(LCDC_FB_TypeDef *fb)
+{
+	if (!fb->Busy) {
+		return;
+	}
+
+	fb->BandIdx++;
+	if (fb->BandIdx < fb->DirtyNum[fb->Scanout]) {
+		lcdc_fb_mcu_push_band(fb);
+		return;
+	}
+
+	/* panel GRAM holds the frame now, the buffer can be drawn again */
+	fb->Busy = 0;
+	fb->State[fb->Scanout] = LCDC_FB_BUF_FREE;
+	lcdc_fb_flip_done(fb, fb->Scanout);
+
+	if (fb->Pending != LCDC_FB_INVALID) {
+		lcdc_fb_mcu_start(fb);
+	}
+
+	if (fb->Cfg.FB_VsyncCb) {
+		fb->Cfg.FB_VsyncCb(fb->Cfg.FB_CbData);
+	}
+}
+
+/* Exported functions --------------------------------------------------------*/
+/** @defgroup LCDC_FB_Exported_Functions LCDC_FB Exported Functions
+  * @{
+  */
+
+/**
+  * @brief  Fill each FB_InitStruct member with its default value.
+  * @param  FB_InitStruct: pointer to a LCDC_FB_InitTypeDef structure which will be initialized.
+  * @retval None
+  */
+void LCDC_FB_StructInit(LCDC_FB_InitTypeDef *FB_InitStruct)
+{
+	_memset((void *)FB_InitStruct, 0, sizeof(LCDC_FB_InitTypeDef));
+
+	FB_InitStruct->LCDCx = LCDC;
+	FB_InitStruct->FB_Mode = LCDC_FB_MODE_RGB;
+	FB_InitStruct->FB_BufNum = 2;
+	FB_InitStruct->FB_Bpp = 2;
+	FB_InitStruct->FB_BandGap = 8;
+}
+
+/**
+  * @brief  Initialize the frame presenter and enable the interrupt it needs.
+  * @param  fb: presenter instance.
+  * @param  FB_InitStruct: pointer to a LCDC_FB_InitTypeDef structure that contains
+  *         the framebuffers and panel geometry.
+  * @note   RGB mode shows buffer 0 after init. MCU mode expects trigger DMA mode.
+  * @retval None
+  */
+void LCDC_FB_Init(LCDC_FB_TypeDef *fb, LCDC_FB_InitTypeDef *FB_InitStruct)
+{
+	assert_param(IS_LCDC_FB_MODE(FB_InitStruct->FB_Mode));
+	assert_param((FB_InitStruct->FB_BufNum >= 2) && (FB_InitStruct->FB_BufNum <= LCDC_FB_BUF_MAX));
+
+	_memset((void *)fb, 0, sizeof(LCDC_FB_TypeDef));
+	fb->Cfg = *FB_InitStruct;
+	fb->Pending = LCDC_FB_INVALID;
+	fb->Scanout = LCDC_FB_INVALID;
+
+	LCDC_ClearINT(fb->Cfg.LCDCx, LCDC_BIT_LCD_LIN_INTS | LCDC_BIT_LCD_FRD_INTS);
+
+	if (fb->Cfg.FB_Mode == LCDC_FB_MODE_RGB) {
+		fb->Scanout = 0;
+		fb->State[0] = LCDC_FB_BUF_SCANOUT;
+		LCDC_DMAImgCfg(fb->Cfg.LCDCx, fb->Cfg.FB_BufAddr[0]);
+		LCDC_ShadowReloadConfig(fb->Cfg.LCDCx);
+		LCDC_LineINTPosConfig(fb->Cfg.LCDCx, fb->Cfg.FB_VsyncLine);
+		LCDC_INTConfig(fb->Cfg.LCDCx, LCDC_BIT_LCD_LIN_INTEN, ENABLE);
+	} else {
+		LCDC_INTConfig(fb->Cfg.LCDCx, LCDC_BIT_LCD_FRD_INTEN, ENABLE);
+	}
+}
+
+/**
+  * @brief  Get a buffer for rendering.
+  * @param  fb: presenter instance.
+  * @retval buffer index, or LCDC_FB_INVALID if all buffers are queued or on screen.
+  *         Wait for FB_VsyncCb and retry in that case.
+  */
+u8 LCDC_FB_Acquire(LCDC_FB_TypeDef *fb)
+{
+	u32 PrevStatus = __get_PRIMASK();
+	u8 i, idx = LCDC_FB_INVALID;
+
+	__disable_irq();
+	for (i = 0; i < fb->Cfg.FB_BufNum; i++) {
+		if (fb->State[i] == LCDC_FB_BUF_FREE) {
+			fb->State[i] = LCDC_FB_BUF_DRAWING;
+			idx = i;
+			break;
+		}
+	}
+	if (idx == LCDC_FB_INVALID) {
+		fb->Stats.AcquireFail++;
+	}
+	__set_PRIMASK(PrevStatus);
+
+	return idx;
+}
+
+/**
+  * @brief  Get the address of a framebuffer.
+  * @param  fb: presenter instance.
+  * @param  Idx: buffer index returned by LCDC_FB_Acquire().
+  * @retval framebuffer address
+  */
+u32 LCDC_FB_GetBuffer(LCDC_FB_TypeDef *fb, u8 Idx)
+{
+	assert_param(Idx < fb->Cfg.FB_BufNum);
+
+	return fb->Cfg.FB_BufAddr[Idx];
+}
+
+/**
+  * @brief  Get the line bands changed by frames presented since this buffer was last presented.
+  * @param  fb: presenter instance.
+  * @param  Idx: buffer index returned by LCDC_FB_Acquire().
+  * @param  Bands: array of LCDC_FB_BAND_MAX entries receiving the bands.
+  * @retval number of bands, the renderer shall redraw them before presenting the buffer.
+  */
+u32 LCDC_FB_GetDamage(LCDC_FB_TypeDef *fb, u8 Idx, LCDC_FB_Band *Bands)
+{
+	u32 PrevStatus = __get_PRIMASK();
+	u32 i, num;
+
+	assert_param(Idx < fb->Cfg.FB_BufNum);
+
+	__disable_irq();
+	num = fb->DamageNum[Idx];
+	for (i = 0; i < num; i++) {
+		Bands[i] = fb->Damage[Idx][i];
+	}
+	__set_PRIMASK(PrevStatus);
+
+	return num;
+}
+
+/**
+  * @brief  Queue a rendered buffer for display.
+  * @param  fb: presenter instance.
+  * @param  Idx: buffer index returned by LCDC_FB_Acquire().
+  * @param  Rects: rectangles changed in this frame, NULL for the full frame.
+  * @param  RectNum: number of rectangles.
+  * @note   RGB mode flips at the next vertical blank. MCU mode pushes the dirty bands as
+  *         soon as the bus is idle, a frame still waiting for the bus is merged into this one.
+  * @retval None
+  */
+void LCDC_FB_Present(LCDC_FB_TypeDef *fb, u8 Idx, const LCDC_FB_Rect *Rects, u32 RectNum)
+{
+	u32 PrevStatus = __get_PRIMASK();
+	LCDC_FB_Band *dirty = fb->Dirty[Idx];
+	u32 i, num = 0;
+
+	assert_param(Idx < fb->Cfg.FB_BufNum);
+	assert_param(fb->State[Idx] == LCDC_FB_BUF_DRAWING);
+
+	if (Rects == NULL || RectNum == 0) {
+		dirty[0].Y0 = 0;
+		dirty[0].Y1 = fb->Cfg.FB_Height;
+		num = 1;
+	} else {
+		for (i = 0; i < RectNum; i++) {
+			if (Rects[i].W == 0 || Rects[i].H == 0 || Rects[i].Y >= fb->Cfg.FB_Height) {
+				continue;
+			}
+			num = lcdc_fb_band_add(dirty, num, Rects[i].Y, MIN(Rects[i].Y + Rects[i].H, fb->Cfg.FB_Height),
+								   fb->Cfg.FB_BandGap);
+		}
+	}
+
+	__disable_irq();
+
+	fb->Stats.Presented++;
+	fb->PresentTime[Idx] = DTimestamp_Get();
+	lcdc_fb_update_damage(fb, Idx, dirty, num);
+
+	if (fb->Cfg.FB_Mode == LCDC_FB_MODE_RGB) {
+		if (fb->Pending != LCDC_FB_INVALID) {
+			fb->State[fb->Pending] = LCDC_FB_BUF_DROPPED;
+			fb->Stats.Dropped++;
+		}
+		fb->State[Idx] = LCDC_FB_BUF_QUEUED;
+		fb->Pending = Idx;
+		fb->DirtyNum[Idx] = num;
+
+		LCDC_DMAImgCfg(fb->Cfg.LCDCx, fb->Cfg.FB_BufAddr[Idx]);
+		LCDC_ShadowReloadConfig(fb->Cfg.LCDCx);
+	} else {
+		if (fb->Pending != LCDC_FB_INVALID) {
+			/* the replaced frame never reached the panel, its bands go with this one */
+			for (i = 0; i < fb->DirtyNum[fb->Pending]; i++) {
+				num = lcdc_fb_band_add(dirty, num, fb->Dirty[fb->Pending][i].Y0, fb->Dirty[fb->Pending][i].Y1,
+									   fb->Cfg.FB_BandGap);
+			}
+			fb->State[fb->Pending] = LCDC_FB_BUF_FREE;
+			fb->Stats.Dropped++;
+		}
+		fb->State[Idx] = LCDC_FB_BUF_QUEUED;
+		fb->Pending = Idx;
+		fb->DirtyNum[Idx] = num;
+
+		if (num == 0) {
+			/* nothing changed, nothing to push */
+			fb->State[Idx] = LCDC_FB_BUF_FREE;
+			fb->Pending = LCDC_FB_INVALID;
+		} else if (!fb->Busy) {
+			lcdc_fb_mcu_start(fb);
+		}
+	}
+
+	__set_PRIMASK(PrevStatus);
+}
+
+/**
+  * @brief  Presenter interrupt service, call it from the LCDC IRQ handler.
+  * @param  fb: presenter instance.
+  * @note   Only the line interrupt (RGB) and refresh done interrupt (MCU) are cleared here.
+  * @retval None
+  */
+void LCDC_FB_IRQHandler(LCDC_FB_TypeDef *fb)
+{
+	u32 status = LCDC_GetINTStatus(fb->Cfg.LCDCx);
+
+	if (fb->Cfg.FB_Mode == LCDC_FB_MODE_RGB) {
+		if (status & LCDC_BIT_LCD_LIN_INTS) {
+			LCDC_ClearINT(fb->Cfg.LCDCx, LCDC_BIT_LCD_LIN_INTS);
+			lcdc_fb_rgb_vsync(fb);
+		}
+	} else {
+		if (status & LCDC_BIT_LCD_FRD_INTS) {
+			LCDC_ClearINT(fb->Cfg.LCDCx, LCDC_BIT_LCD_FRD_INTS);
+			lcdc_fb_mcu_done(fb);
+		}
+	}
+}
+
+/**
+  * @brief  Get the presenter statistics.
+  * @param  fb: presenter instance.
+  * @param  Stats: pointer to the structure that receives the statistics.
+  * @retval None
+  */
+void LCDC_FB_GetStats(LCDC_FB_TypeDef *fb, LCDC_FB_StatsTypeDef *Stats)
+{
+	u32 PrevStatus = __get_PRIMASK();
+
+	__disable_irq();
+	*Stats = fb->Stats;
+	__set_PRIMASK(PrevStatus);
+}
+
+/** @} */
+
+/** @} */
+
+/** @} */
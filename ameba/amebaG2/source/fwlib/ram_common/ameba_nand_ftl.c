@@ -0,0 +1,679 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ameba_soc.h"
+
+static const char *const TAG = "NANDFTL";
+
+#define NAND_FTL_PPN(blk, page)		(((blk) << NAND_BLOCK_PAGE_CNT_BIT_EXP) | (page))
+#define NAND_FTL_PPN_BLK(ppn)		((ppn) >> NAND_BLOCK_PAGE_CNT_BIT_EXP)
+#define NAND_FTL_PPN_PAGE(ppn)		((ppn) & NAND_BLOCK_PAGE_MASK)
+
+/** @addtogroup Ameba_Periph_Driver
+  * @{
+  */
+
+/** @defgroup NAND_FTL
+  * @brief NAND_FTL driver modules
+  * @{
+  */
+
+static u32 nand_ftl_page_addr(NAND_FTL_TypeDef *ftl, u32 ppn)
+{
+	return NAND_BLOCK_ID_TO_PAGE_ADDR(ftl->Cfg.FTL_StartBlock + NAND_FTL_PPN_BLK(ppn)) + NAND_FTL_PPN_PAGE(ppn);
+}
+
+static void nand_ftl_tag_fill(NAND_FTL_Tag *tag, u32 lpn, u32 seq, u32 erase_cnt)
+{
+	tag->Lpn = lpn;
+	tag->Seq = seq;
+	tag->EraseCnt = erase_cnt;
+	tag->Check = lpn ^ seq ^ erase_cnt ^ NAND_FTL_TAG_MAGIC;
+}
+
+static bool nand_ftl_tag_valid(NAND_FTL_Tag *tag)
+{
+	return tag->Check == (tag->Lpn ^ tag->Seq ^ tag->EraseCnt ^ NAND_FTL_TAG_MAGIC);
+}
+
+static bool nand_ftl_tag_erased(NAND_FTL_Tag *tag)
+{
+	return (tag->Lpn & tag->Seq & tag->EraseCnt & tag->Check) == 0xFFFFFFFF;
+}
+
+/* Load one page into the NAND cache and fetch its spare tag. Returns the page status. */
+static u8 nand_ftl_read_tag(NAND_FTL_TypeDef *ftl, u32 ppn, NAND_FTL_Tag *tag)
+{
+	u8 status;
+
+	status = DATA_NAND_Page_Read_ArrayToCache(nand_ftl_page_addr(ftl, ppn));
+	DATA_NAND_Page_Read_FromCache(data_flash_init_para.FLASH_cur_cmd, ftl->PageSize + NAND_FTL_TAG_OFFSET,
+								  sizeof(NAND_FTL_Tag), (u8 *)tag);
+
+	return status;
+}
+
+static void nand_ftl_check_ecc(NAND_FTL_TypeDef *ftl, u32 blk, u8 status)
+{
+	if ((status & NAND_STATUS_ECC_MASK) == NAND_STATUS_ECC_HAS_BITFLIPS) {
+		ftl->Stats.EccCorrected++;
+		ftl->Cfg.FTL_BlockInfo[blk].Flag |= NAND_FTL_FLAG_SCRUB;
+	}
+}
+
+static void nand_ftl_invalidate(NAND_FTL_TypeDef *ftl, u32 lpn)
+{
+	u32 ppn = ftl->Cfg.FTL_L2P[lpn];
+
+	if (ppn != NAND_FTL_UNMAPPED) {
+		if (ppn != NAND_FTL_UNREADABLE) {
+			ftl->Cfg.FTL_BlockInfo[NAND_FTL_PPN_BLK(ppn)].ValidCnt--;
+		}
+		ftl->Cfg.FTL_L2P[lpn] = NAND_FTL_UNMAPPED;
+	}
+}
+
+/* Load a mapped page to the NAND cache, unmapped and unreadable pages read nothing */
+static u8 nand_ftl_load(NAND_FTL_TypeDef *ftl, u32 ppn)
+{
+	if (ppn == NAND_FTL_UNMAPPED || ppn == NAND_FTL_UNREADABLE) {
+		return 0;
+	}
+
+	return DATA_NAND_Page_Read_ArrayToCache(nand_ftl_page_addr(ftl, ppn));
+}
+
+/* Retire a failing block. Blocks still holding data are retired by the next GC after relocation. */
+static void nand_ftl_retire(NAND_FTL_TypeDef *ftl, u32 blk)
+{
+	NAND_FTL_BlockInfo *info = &ftl->Cfg.FTL_BlockInfo[blk];
+
+	RTK_LOGW(TAG, "Retire block %lu\n", ftl->Cfg.FTL_StartBlock + blk);
+
+	if (info->State == NAND_FTL_BLOCK_FREE) {
+		ftl->FreeBlocks--;
+	}
+	if (ftl->ActiveBlock == blk) {
+		ftl->ActiveBlock = NAND_FTL_UNMAPPED;
+	}
+
+	if (info->ValidCnt) {
+		info->State = NAND_FTL_BLOCK_USED;
+		info->Flag |= NAND_FTL_FLAG_SCRUB | NAND_FTL_FLAG_RETIRE;
+		return;
+	}
+
+	info->State = NAND_FTL_BLOCK_BAD;
+	ftl->Stats.RuntimeBadBlocks++;
+}
+
+static int nand_ftl_gc_one(NAND_FTL_TypeDef *ftl, bool background);
+
+/* Pick the free block with the lowest erase count (dynamic wear leveling) and erase it. */
+static int nand_ftl_alloc_block(NAND_FTL_TypeDef *ftl)
+{
+	NAND_FTL_BlockInfo *info;
+	u32 blk, best;
+	u8 status;
+
+	if (!ftl->InGC) {
+		while (ftl->FreeBlocks <= ftl->Cfg.FTL_GCThreshold) {
+			if (nand_ftl_gc_one(ftl, FALSE) != RTK_SUCCESS) {
+				break;
+			}
+		}
+	}
+
+	while (ftl->FreeBlocks) {
+		best = NAND_FTL_UNMAPPED;
+		for (blk = 0; blk < ftl->Cfg.FTL_BlockNum; blk++) {
+			info = &ftl->Cfg.FTL_BlockInfo[blk];
+			if (info->State != NAND_FTL_BLOCK_FREE) {
+				continue;
+			}
+			if (best == NAND_FTL_UNMAPPED || info->EraseCnt < ftl->Cfg.FTL_BlockInfo[best].EraseCnt) {
+				best = blk;
+			}
+		}
+
+		info = &ftl->Cfg.FTL_BlockInfo[best];
+		if (info->WritePtr != 0) {
+			status = DATA_NAND_Erase(NAND_BLOCK_ID_TO_PAGE_ADDR(ftl->Cfg.FTL_StartBlock + best));
+			ftl->Stats.NandErases++;
+			info->EraseCnt++;
+			if (status & NAND_STATUS_ERASE_FAILED) {
+				nand_ftl_retire(ftl, best);
+				continue;
+			}
+		}
+
+		ftl->FreeBlocks--;
+		info->State = NAND_FTL_BLOCK_ACTIVE;
+		info->WritePtr = 0;
+		info->ValidCnt = 0;
+		info->Flag = 0;
+		ftl->ActiveBlock = best;
+
+		return RTK_SUCCESS;
+	}
+
+	RTK_LOGE(TAG, "No free block\n");
+
+	return RTK_ERR_NOMEM;
+}
+
+/* Reserve the next page of the active block, open a new block when it is full. */
+static int nand_ftl_next_page(NAND_FTL_TypeDef *ftl, u32 *ppn)
+{
+	NAND_FTL_BlockInfo *info;
+	int ret;
+
+	if (ftl->ActiveBlock != NAND_FTL_UNMAPPED) {
+		info = &ftl->Cfg.FTL_BlockInfo[ftl->ActiveBlock];
+		if (info->WritePtr >= NAND_BLOCK_PAGE_CNT) {
+			info->State = NAND_FTL_BLOCK_USED;
+			ftl->ActiveBlock = NAND_FTL_UNMAPPED;
+		}
+	}
+
+	if (ftl->ActiveBlock == NAND_FTL_UNMAPPED) {
+		ret = nand_ftl_alloc_block(ftl);
+		if (ret != RTK_SUCCESS) {
+			return ret;
+		}
+	}
+
+	info = &ftl->Cfg.FTL_BlockInfo[ftl->ActiveBlock];
+	*ppn = NAND_FTL_PPN(ftl->ActiveBlock, info->WritePtr);
+	info->WritePtr++;
+
+	return RTK_SUCCESS;
+}
+
+/*
+ * Program one logical page. With pData == NULL the NAND cache already holds the
+ * main area (copy-back from GC), only the tag is loaded without resetting the cache.
+ */
+static int nand_ftl_program(NAND_FTL_TypeDef *ftl, u32 lpn, u8 *pData)
+{
+	NAND_FTL_Tag tag;
+	u32 ppn, blk;
+	u8 status;
+	int ret;
+
+	while (1) {
+		ret = nand_ftl_next_page(ftl, &ppn);
+		if (ret != RTK_SUCCESS) {
+			return ret;
+		}
+		blk = NAND_FTL_PPN_BLK(ppn);
+
+		nand_ftl_tag_fill(&tag, lpn, ftl->Seq++, ftl->Cfg.FTL_BlockInfo[blk].EraseCnt);
+
+		if (pData) {
+			DATA_NAND_Page_Write_Data_Xfer(data_flash_init_para.FLASH_cmd_page_write, 0, ftl->PageSize, pData);
+		}
+		DATA_NAND_Page_Write_Data_Xfer(NAND_CMD_PP_RANDOM, ftl->PageSize + NAND_FTL_TAG_OFFSET, sizeof(tag), (u8 *)&tag);
+		status = DATA_NAND_Page_Write_Program_Execute(nand_ftl_page_addr(ftl, ppn));
+		ftl->Stats.NandProgPages++;
+
+		if ((status & NAND_STATUS_PROG_FAILED) == 0) {
+			break;
+		}
+
+		/* Copy-back data lives in the NAND cache and is lost once another page is read */
+		nand_ftl_retire(ftl, blk);
+		if (pData == NULL) {
+			return RTK_FAIL;
+		}
+	}
+
+	nand_ftl_invalidate(ftl, lpn);
+	ftl->Cfg.FTL_L2P[lpn] = ppn;
+	ftl->Cfg.FTL_BlockInfo[blk].ValidCnt++;
+
+	return RTK_SUCCESS;
+}
+
+/* Select a GC victim: scrub requests first, then static wear leveling, then fewest valid pages. */
+static u32 nand_ftl_pick_victim(NAND_FTL_TypeDef *ftl, bool background, bool *wl)
+{
+	NAND_FTL_BlockInfo *info;
+	u32 blk, greedy = NAND_FTL_UNMAPPED, cold = NAND_FTL_UNMAPPED;
+	u32 max_erase = 0;
+
+	*wl = FALSE;
+
+	for (blk = 0; blk < ftl->Cfg.FTL_BlockNum; blk++) {
+		info = &ftl->Cfg.FTL_BlockInfo[blk];
+		if (info->State == NAND_FTL_BLOCK_BAD) {
+			continue;
+		}
+		if (info->EraseCnt > max_erase) {
+			max_erase = info->EraseCnt;
+		}
+		if (info->State != NAND_FTL_BLOCK_USED) {
+			continue;
+		}
+		if (info->Flag & NAND_FTL_FLAG_SCRUB) {
+			return blk;
+		}
+		if (greedy == NAND_FTL_UNMAPPED || info->ValidCnt < ftl->Cfg.FTL_BlockInfo[greedy].ValidCnt) {
+			greedy = blk;
+		}
+		if (cold == NAND_FTL_UNMAPPED || info->EraseCnt < ftl->Cfg.FTL_BlockInfo[cold].EraseCnt) {
+			cold = blk;
+		}
+	}
+
+	/* static wear leveling gains no space, keep it out of the write path */
+	if (background && cold != NAND_FTL_UNMAPPED && max_erase - ftl->Cfg.FTL_BlockInfo[cold].EraseCnt > ftl->Cfg.FTL_WearLevelDelta) {
+		*wl = TRUE;
+		return cold;
+	}
+
+	if (greedy == NAND_FTL_UNMAPPED || ftl->Cfg.FTL_BlockInfo[greedy].ValidCnt >= NAND_BLOCK_PAGE_CNT) {
+		return NAND_FTL_UNMAPPED;
+	}
+
+	/* Idle time GC only reclaims blocks that give back at least half of their pages */
+	if (background && ftl->Cfg.FTL_BlockInfo[greedy].ValidCnt > NAND_BLOCK_PAGE_CNT / 2) {
+		return NAND_FTL_UNMAPPED;
+	}
+
+	return greedy;
+}
+
+static int nand_ftl_gc_one(NAND_FTL_TypeDef *ftl, bool background)
+{
+	NAND_FTL_BlockInfo *info;
+	NAND_FTL_Tag tag;
+	u32 victim, page, ppn;
+	u8 status;
+	bool wl;
+	int ret = RTK_SUCCESS;
+
+	victim = nand_ftl_pick_victim(ftl, background, &wl);
+	if (victim == NAND_FTL_UNMAPPED) {
+		return RTK_FAIL;
+	}
+
+	info = &ftl->Cfg.FTL_BlockInfo[victim];
+	ftl->InGC = 1;
+
+	for (page = 0; page < info->WritePtr && info->ValidCnt; page++) {
+		ppn = NAND_FTL_PPN(victim, page);
+		status = nand_ftl_read_tag(ftl, ppn, &tag);
+
+		if (!nand_ftl_tag_valid(&tag) || tag.Lpn >= ftl->Cfg.FTL_LogicalPageNum ||
+			ftl->Cfg.FTL_L2P[tag.Lpn] != ppn) {
+			continue;
+		}
+
+		if ((status & NAND_STATUS_ECC_MASK) == NAND_STATUS_ECC_UNCOR_ERROR) {
+			/* copy-back would give the bad data a fresh ECC, leave it behind and let reads fail */
+			ftl->Stats.EccUncorrectable++;
+			info->ValidCnt--;
+			ftl->Cfg.FTL_L2P[tag.Lpn] = NAND_FTL_UNREADABLE;
+			continue;
+		}
+
+		/* page is in the NAND cache now, program it to the new location */
+		ret = nand_ftl_program(ftl, tag.Lpn, NULL);
+		if (ret != RTK_SUCCESS) {
+			break;
+		}
+		ftl->Stats.GcCopyPages++;
+	}
+
+	ftl->InGC = 0;
+
+	if (ret != RTK_SUCCESS) {
+		return ret;
+	}
+
+	/* leave the victim unerased, it is erased on allocation so the count stays in its tags until reuse */
+	if (info->Flag & NAND_FTL_FLAG_RETIRE) {
+		info->State = NAND_FTL_BLOCK_BAD;
+		ftl->Stats.RuntimeBadBlocks++;
+	} else {
+		info->State = NAND_FTL_BLOCK_FREE;
+		ftl->FreeBlocks++;
+	}
+	info->Flag = 0;
+	ftl->Stats.GcRuns++;
+	if (wl) {
+		ftl->Stats.WlMoves++;
+	}
+
+	return RTK_SUCCESS;
+}
+
+/* Exported functions --------------------------------------------------------*/
+/** @defgroup NAND_FTL_Exported_Functions NAND_FTL Exported Functions
+  * @{
+  */
+
+/**
+  * @brief  Fill each FTL_InitStruct member with its default value.
+  * @param  FTL_InitStruct: pointer to a NAND_FTL_InitTypeDef structure which will be initialized.
+  * @retval None
+  */
+void NAND_FTL_StructInit(NAND_FTL_InitTypeDef *FTL_InitStruct)
+{
+	_memset((void *)FTL_InitStruct, 0, sizeof(NAND_FTL_InitTypeDef));
+
+	FTL_InitStruct->FTL_GCThreshold = NAND_FTL_GC_THRESHOLD_DEF;
+	FTL_InitStruct->FTL_BGCThreshold = NAND_FTL_BGC_THRESHOLD_DEF;
+	FTL_InitStruct->FTL_WearLevelDelta = NAND_FTL_WL_DELTA_DEF;
+}
+
+/**
+  * @brief  Scan the managed blocks and rebuild the bad block table and the mapping table.
+  * @param  ftl: FTL instance.
+  * @param  FTL_InitStruct: pointer to a NAND_FTL_InitTypeDef structure that contains the
+  *         block range and table buffers. Tables are owned by the FTL until it is dropped.
+  * @retval RTK_SUCCESS, or RTK_ERR_NOMEM if the good blocks can not hold the logical pages.
+  * @note   Erase counts of blocks without valid tags are set to the average of the others.
+  */
+int NAND_FTL_Mount(NAND_FTL_TypeDef *ftl, NAND_FTL_InitTypeDef *FTL_InitStruct)
+{
+	NAND_FTL_BlockInfo *info;
+	NAND_FTL_Tag tag, old;
+	u32 blk, page, ppn, good = 0, known = 0;
+	u64 erase_sum = 0;
+	u8 status;
+
+	assert_param(FTL_InitStruct->FTL_L2P != NULL);
+	assert_param(FTL_InitStruct->FTL_BlockInfo != NULL);
+	assert_param(FTL_InitStruct->FTL_BlockNum > FTL_InitStruct->FTL_GCThreshold + 1);
+
+	_memset((void *)ftl, 0, sizeof(NAND_FTL_TypeDef));
+	ftl->Cfg = *FTL_InitStruct;
+	ftl->PageSize = DATA_NAND_PAGE_SIZE_MAIN;
+	ftl->ActiveBlock = NAND_FTL_UNMAPPED;
+
+	_memset((void *)ftl->Cfg.FTL_L2P, 0xFF, ftl->Cfg.FTL_LogicalPageNum * sizeof(u32));
+	_memset((void *)ftl->Cfg.FTL_BlockInfo, 0, ftl->Cfg.FTL_BlockNum * sizeof(NAND_FTL_BlockInfo));
+
+	for (blk = 0; blk < ftl->Cfg.FTL_BlockNum; blk++) {
+		info = &ftl->Cfg.FTL_BlockInfo[blk];
+
+		if (DATA_NAND_CheckBadBlock(ftl->Cfg.FTL_StartBlock + blk)) {
+			info->State = NAND_FTL_BLOCK_BAD;
+			ftl->Stats.FactoryBadBlocks++;
+			continue;
+		}
+		good++;
+
+		for (page = 0; page < NAND_BLOCK_PAGE_CNT; page++) {
+			ppn = NAND_FTL_PPN(blk, page);
+			status = nand_ftl_read_tag(ftl, ppn, &tag);
+
+			if (nand_ftl_tag_erased(&tag)) {
+				break;
+			}
+			/* torn or foreign page, the slot is consumed but carries no data */
+			if (!nand_ftl_tag_valid(&tag)) {
+				continue;
+			}
+
+			nand_ftl_check_ecc(ftl, blk, status);
+			info->EraseCnt = tag.EraseCnt;
+			if ((u32)(tag.Seq - ftl->Seq) < 0x80000000U) {
+				ftl->Seq = tag.Seq + 1;
+			}
+			if (tag.Lpn >= ftl->Cfg.FTL_LogicalPageNum) {
+				continue;
+			}
+
+			if (ftl->Cfg.FTL_L2P[tag.Lpn] != NAND_FTL_UNMAPPED) {
+				/* keep the newer copy, only happens for stale data not yet collected */
+				nand_ftl_read_tag(ftl, ftl->Cfg.FTL_L2P[tag.Lpn], &old);
+				if ((s32)(tag.Seq - old.Seq) < 0) {
+					continue;
+				}
+				nand_ftl_invalidate(ftl, tag.Lpn);
+			}
+			ftl->Cfg.FTL_L2P[tag.Lpn] = ppn;
+			info->ValidCnt++;
+		}
+
+		info->WritePtr = page;
+		if (page == 0) {
+			info->State = NAND_FTL_BLOCK_FREE;
+			ftl->FreeBlocks++;
+		} else {
+			/* never append to a block found open, the last program may have been interrupted */
+			info->State = NAND_FTL_BLOCK_USED;
+			erase_sum += info->EraseCnt;
+			known++;
+		}
+	}
+
+	if (known) {
+		for (blk = 0; blk < ftl->Cfg.FTL_BlockNum; blk++) {
+			info = &ftl->Cfg.FTL_BlockInfo[blk];
+			if (info->State == NAND_FTL_BLOCK_FREE) {
+				info->EraseCnt = (u32)(erase_sum / known);
+			}
+		}
+	}
+
+	if (good <= ftl->Cfg.FTL_GCThreshold + 1 ||
+		ftl->Cfg.FTL_LogicalPageNum > (good - ftl->Cfg.FTL_GCThreshold - 1) * NAND_BLOCK_PAGE_CNT) {
+		RTK_LOGE(TAG, "%lu good blocks can not hold %lu pages\n", good, ftl->Cfg.FTL_LogicalPageNum);
+		return RTK_ERR_NOMEM;
+	}
+
+	ftl->Mounted = 1;
+	RTK_LOGI(TAG, "Mounted: %lu good, %lu free blocks, seq %lu\n", good, ftl->FreeBlocks, ftl->Seq);
+
+	return RTK_SUCCESS;
+}
+
+/**
+  * @brief  Drop all logical data and erase every good block managed by the FTL.
+  * @param  ftl: mounted FTL instance.
+  * @retval RTK_SUCCESS
+  */
+int NAND_FTL_Format(NAND_FTL_TypeDef *ftl)
+{
+	NAND_FTL_BlockInfo *info;
+	u32 blk;
+
+	_memset((void *)ftl->Cfg.FTL_L2P, 0xFF, ftl->Cfg.FTL_LogicalPageNum * sizeof(u32));
+	ftl->ActiveBlock = NAND_FTL_UNMAPPED;
+	ftl->FreeBlocks = 0;
+
+	for (blk = 0; blk < ftl->Cfg.FTL_BlockNum; blk++) {
+		info = &ftl->Cfg.FTL_BlockInfo[blk];
+		if (info->State == NAND_FTL_BLOCK_BAD) {
+			continue;
+		}
+
+		info->EraseCnt++;
+		ftl->Stats.NandErases++;
+		info->ValidCnt = 0;
+		info->WritePtr = 0;
+		info->Flag = 0;
+
+		if (DATA_NAND_Erase(NAND_BLOCK_ID_TO_PAGE_ADDR(ftl->Cfg.FTL_StartBlock + blk)) & NAND_STATUS_ERASE_FAILED) {
+			RTK_LOGW(TAG, "Retire block %lu\n", ftl->Cfg.FTL_StartBlock + blk);
+			info->State = NAND_FTL_BLOCK_BAD;
+			ftl->Stats.RuntimeBadBlocks++;
+			continue;
+		}
+
+		info->State = NAND_FTL_BLOCK_FREE;
+		ftl->FreeBlocks++;
+	}
+
+	return RTK_SUCCESS;
+}
+
+/**
+  * @brief  Read logical pages. Unwritten pages read back as 0xFF.
+  * @param  ftl: mounted FTL instance.
+  * @param  Lpn: first logical page.
+  * @param  PageCnt: number of pages to read.
+  * @param  pData: destination, PageCnt * page size bytes.
+  * @retval RTK_SUCCESS, RTK_ERR_BADARG, or RTK_FAIL on uncorrectable ECC error.
+  * @note   A page GC found uncorrectable keeps failing until it is rewritten. The marker is
+  *         not stored: after the next mount the rescan maps the newest copy left on the flash,
+  *         i.e. an older copy of the page not yet collected, which reads back as that old
+  *         data, or the uncorrectable page itself while its block is not erased. The page
+  *         reads back as unwritten only when no copy is left.
+  */
+int NAND_FTL_Read(NAND_FTL_TypeDef *ftl, u32 Lpn, u32 PageCnt, u8 *pData)
+{
+	u32 ppn;
+	u8 status;
+	int ret = RTK_SUCCESS;
+
+	if (!ftl->Mounted || Lpn + PageCnt > ftl->Cfg.FTL_LogicalPageNum || Lpn + PageCnt < Lpn) {
+		return RTK_ERR_BADARG;
+	}
+
+	if (PageCnt == 0) {
+		return RTK_SUCCESS;
+	}
+
+	ppn = ftl->Cfg.FTL_L2P[Lpn];
+	status = nand_ftl_load(ftl, ppn);
+
+	while (PageCnt--) {
+		if (ppn == NAND_FTL_UNMAPPED) {
+			_memset(pData, 0xFF, ftl->PageSize);
+		} else if (ppn == NAND_FTL_UNREADABLE || (status & NAND_STATUS_ECC_MASK) == NAND_STATUS_ECC_UNCOR_ERROR) {
+			ftl->Stats.EccUncorrectable++;
+			ret = RTK_FAIL;
+		} else {
+			nand_ftl_check_ecc(ftl, NAND_FTL_PPN_BLK(ppn), status);
+			DATA_NAND_Page_Read_FromCache(data_flash_init_para.FLASH_cur_cmd, 0, ftl->PageSize, pData);
+		}
+
+		ftl->Stats.HostReadPages++;
+		pData += ftl->PageSize;
+		Lpn++;
+
+		if (PageCnt) {
+			ppn = ftl->Cfg.FTL_L2P[Lpn];
+			status = nand_ftl_load(ftl, ppn);
+		}
+	}
+
+	return ret;
+}
+
+/**
+  * @brief  Write logical pages out of place.
+  * @param  ftl: mounted FTL instance.
+  * @param  Lpn: first logical page.
+  * @param  PageCnt: number of pages to write.
+  * @param  pData: source, PageCnt * page size bytes.
+  * @retval RTK_SUCCESS, RTK_ERR_BADARG, or RTK_ERR_NOMEM when no block can be reclaimed.
+  */
+int NAND_FTL_Write(NAND_FTL_TypeDef *ftl, u32 Lpn, u32 PageCnt, u8 *pData)
+{
+	int ret;
+
+	if (!ftl->Mounted || Lpn + PageCnt > ftl->Cfg.FTL_LogicalPageNum || Lpn + PageCnt < Lpn) {
+		return RTK_ERR_BADARG;
+	}
+
+	while (PageCnt--) {
+		ret = nand_ftl_program(ftl, Lpn, pData);
+		if (ret != RTK_SUCCESS) {
+			return ret;
+		}
+
+		ftl->Stats.HostWritePages++;
+		pData += ftl->PageSize;
+		Lpn++;
+	}
+
+	return RTK_SUCCESS;
+}
+
+/**
+  * @brief  Discard logical pages so GC does not relocate them.
+  * @param  ftl: mounted FTL instance.
+  * @param  Lpn: first logical page.
+  * @param  PageCnt: number of pages to discard.
+  * @retval RTK_SUCCESS or RTK_ERR_BADARG.
+  * @note   Trim is not persistent, the discarded data may come back after the next mount
+  *         until its block is collected.
+  */
+int NAND_FTL_Trim(NAND_FTL_TypeDef *ftl, u32 Lpn, u32 PageCnt)
+{
+	if (!ftl->Mounted || Lpn + PageCnt > ftl->Cfg.FTL_LogicalPageNum || Lpn + PageCnt < Lpn) {
+		return RTK_ERR_BADARG;
+	}
+
+	while (PageCnt--) {
+		nand_ftl_invalidate(ftl, Lpn++);
+	}
+
+	return RTK_SUCCESS;
+}
+
+/**
+  * @brief  Reclaim blocks ahead of writes, call it from an idle context.
+  * @param  ftl: mounted FTL instance.
+  * @param  MaxBlocks: upper bound of victim blocks collected by this call.
+  * @retval number of blocks reclaimed.
+  */
+int NAND_FTL_BackgroundGC(NAND_FTL_TypeDef *ftl, u32 MaxBlocks)
+{
+	u32 victim;
+	int cnt = 0;
+	bool wl;
+
+	if (!ftl->Mounted) {
+		return 0;
+	}
+
+	while (MaxBlocks--) {
+		/* scrub and wear leveling work is done even if enough blocks are free */
+		if (ftl->FreeBlocks >= ftl->Cfg.FTL_BGCThreshold) {
+			victim = nand_ftl_pick_victim(ftl, TRUE, &wl);
+			if (victim == NAND_FTL_UNMAPPED ||
+				(!wl && !(ftl->Cfg.FTL_BlockInfo[victim].Flag & NAND_FTL_FLAG_SCRUB))) {
+				break;
+			}
+		}
+		if (nand_ftl_gc_one(ftl, TRUE) != RTK_SUCCESS) {
+			break;
+		}
+		cnt++;
+	}
+
+	return cnt;
+}
+
+/**
+  * @brief  Get the FTL statistics.
+  * @param  ftl: FTL instance.
+  * @param  Stats: pointer to the structure that receives the statistics.
+  * @retval None
+  */
+void NAND_FTL_GetStats(NAND_FTL_TypeDef *ftl, NAND_FTL_StatsTypeDef *Stats)
+{
+	*Stats = ftl->Stats;
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ameba_soc.h"
+
+static const char *const TAG = "OTP";
+
+/* RAM image of the logical map, OTP_LogicalMap_Read resolves every packet of the
+ * physical map on each call, so boot code reading many small fields pays one scan
+ * here and a memcpy afterwards. */
+static u8 otp_lmap_cache[OTP_LMAP_LEN];
+static u8 otp_lmap_valid;
+
+/* merged image of a batch, too large for the caller stack */
+static u8 otp_lmap_batch[OTP_LMAP_LEN];
+
+/** @addtogroup Ameba_Periph_Driver
+  * @{
+  */
+
+/** @defgroup OTPC
+  * @brief OTPC driver modules
+  * @{
+  */
+
+/* Build the new value of one logical section, return the mask of 2-byte words that change. */
+static u32 otp_lmap_section_merge(u32 Section, const OTP_LMapFieldDef *Fields, u32 Num, u8 *pbuf)
+{
+	u32 base = Section * PGPKT_DATA_SIZE;
+	u32 i, start, end, word, mask = 0;
+
+	_memcpy(pbuf, otp_lmap_cache + base, PGPKT_DATA_SIZE);
+
+	/* fields are applied in order, a later field wins on overlap */
+	for (i = 0; i < Num; i++) {
+		start = MAX(Fields[i].Addr, base);
+		end = MIN(Fields[i].Addr + Fields[i].Len, base + PGPKT_DATA_SIZE);
+		if (start < end) {
+			_memcpy(pbuf + start - base, Fields[i].Data + start - Fields[i].Addr, end - start);
+		}
+	}
+
+	for (word = 0; word < PGPKT_DATA_SIZE / OTP_LMAP_WORD_LEN; word++) {
+		if (_memcmp(pbuf + word * OTP_LMAP_WORD_LEN, otp_lmap_cache + base + word * OTP_LMAP_WORD_LEN, OTP_LMAP_WORD_LEN)) {
+			mask |= BIT(word);
+		}
+	}
+
+	return mask;
+}
+
+static bool otp_lmap_fields_valid(const OTP_LMapFieldDef *Fields, u32 Num)
+{
+	u32 i;
+
+	for (i = 0; i < Num; i++) {
+		if (Fields[i].Data == NULL || (u32)Fields[i].Addr + Fields[i].Len > OTP_LMAP_LEN) {
+			return FALSE;
+		}
+	}
+
+	return TRUE;
+}
+
+/**
+  * @brief  Load the whole logical map into the RAM cache with a single scan.
+  * @retval RTK_SUCCESS or RTK_FAIL
+  * @note   Call it once early in boot, later cache reads do not touch the OTP.
+  */
+int OTP_LMapCache_Init(void)
+{
+	otp_lmap_valid = 0;
+
+	if (OTP_LogicalMap_Read(otp_lmap_cache, 0, OTP_LMAP_LEN) != RTK_SUCCESS) {
+		RTK_LOGE(TAG, "Logical map load fail\n");
+		return RTK_FAIL;
+	}
+
+	otp_lmap_valid = 1;
+
+	return RTK_SUCCESS;
+}
+
+/**
+  * @brief  Drop the RAM cache, the next cache access reloads it.
+  * @note   Call it after the logical map was written without OTP_LMapCache_WriteBatch,
+  *         e.g. by another core.
+  * @retval None
+  */
+void OTP_LMapCache_Invalidate(void)
+{
+	otp_lmap_valid = 0;
+}
+
+/**
+  * @brief  Read logical map bytes from the RAM cache.
+  * @param  pbuf: destination buffer.
+  * @param  addr: logical map address.
+  * @param  len: length in byte.
+  * @retval RTK_SUCCESS, RTK_ERR_BADARG or RTK_FAIL if the cache can not be loaded.
+  */
+int OTP_LMapCache_Read(u8 *pbuf, u32 addr, u32 len)
+{
+	if (addr + len > OTP_LMAP_LEN || addr + len < addr) {
+		return RTK_ERR_BADARG;
+	}
+
+	if (!otp_lmap_valid && OTP_LMapCache_Init() != RTK_SUCCESS) {
+		return RTK_FAIL;
+	}
+
+	_memcpy(pbuf, otp_lmap_cache + addr, len);
+
+	return RTK_SUCCESS;
+}
+
+/**
+  * @brief  Get the physical OTP bytes a batch write would consume.
+  * @param  Fields: fields to write.
+  * @param  Num: number of fields.
+  * @retval bytes needed, 0 if the batch does not change the logical map.
+  * @note   Each changed section costs one packet header plus one entry per changed word.
+  */
+u32 OTP_LMapCache_WriteCost(const OTP_LMapFieldDef *Fields, u32 Num)
+{
+	u8 buf[PGPKT_DATA_SIZE];
+	u32 sec, mask, cost = 0;
+
+	if (!otp_lmap_fields_valid(Fields, Num)) {
+		return 0;
+	}
+
+	if (!otp_lmap_valid && OTP_LMapCache_Init() != RTK_SUCCESS) {
+		return 0;
+	}
+
+	for (sec = 0; sec < OTP_MAX_SECTION; sec++) {
+		mask = otp_lmap_section_merge(sec, Fields, Num, buf);
+		if (mask) {
+			cost += OTP_LMAP_PKT_HDR_LEN + __builtin_popcount(mask) * OTP_LMAP_WORD_LEN;
+		}
+	}
+
+	return cost;
+}
+
+/**
+  * @brief  Write several logical map fields in one pass.
+  * @param  Fields: fields to write, a later field wins when fields overlap.
+  * @param  Num: number of fields.
+  * @retval RTK_SUCCESS, RTK_ERR_BADARG, RTK_ERR_NOMEM if the remaining OTP space can not
+  *         hold the batch (nothing is written), or RTK_FAIL on write failure.
+  * @note   The space check is done before the first write so a batch is not left half
+  *         programmed for lack of space. The fields are merged over the cached map and
+  *         written by a single OTP_LogicalMap_Write() from the first to the last changed
+  *         word, so the physical map is scanned once per batch, not once per section.
+  *         Unchanged words in between are equal to the map and not programmed.
+  */
+int OTP_LMapCache_WriteBatch(const OTP_LMapFieldDef *Fields, u32 Num)
+{
+	u32 sec, mask, first = OTP_LMAP_LEN, last = 0, cost, remain;
+
+	if (!otp_lmap_fields_valid(Fields, Num)) {
+		return RTK_ERR_BADARG;
+	}
+
+	if (!otp_lmap_valid && OTP_LMapCache_Init() != RTK_SUCCESS) {
+		return RTK_FAIL;
+	}
+
+	cost = 0;
+	for (sec = 0; sec < OTP_MAX_SECTION; sec++) {
+		mask = otp_lmap_section_merge(sec, Fields, Num, otp_lmap_batch + sec * PGPKT_DATA_SIZE);
+		if (mask == 0) {
+			continue;
+		}
+
+		cost += OTP_LMAP_PKT_HDR_LEN + __builtin_popcount(mask) * OTP_LMAP_WORD_LEN;
+		first = MIN(first, sec * PGPKT_DATA_SIZE + __builtin_ctz(mask) * OTP_LMAP_WORD_LEN);
+		last = sec * PGPKT_DATA_SIZE + (32 - __builtin_clz(mask)) * OTP_LMAP_WORD_LEN;
+	}
+
+	if (cost == 0) {
+		return RTK_SUCCESS;
+	}
+
+	remain = otp_logical_remain();
+	if (cost > remain) {
+		RTK_LOGE(TAG, "Batch needs %lu bytes, %lu left\n", cost, remain);
+		return RTK_ERR_NOMEM;
+	}
+
+	if (OTP_LogicalMap_Write(first, last - first, otp_lmap_batch + first) != RTK_SUCCESS) {
+		RTK_LOGE(TAG, "Logical map write fail at 0x%lx~0x%lx\n", first, last);
+		otp_lmap_valid = 0;
+		return RTK_FAIL;
+	}
+
+	_memcpy(otp_lmap_cache + first, otp_lmap_batch + first, last - first);
+
+	return RTK_SUCCESS;
+}
+
+/** @} */
+
+/** @} */
@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ameba_soc.h"
+
+static const char *const TAG = "PI2CBAT";
+
+/** @addtogroup Ameba_Periph_Driver
+  * @{
+  */
+
+/** @defgroup PSEUDO_I2C_BATCH
+  * @brief PSEUDO_I2C_BATCH driver modules
+  * @{
+  */
+
+/* RAM words of a transfer of Num bytes, command byte included */
+#define PSEUDO_I2C_WORDS(Num)		(((Num) + 3) / 4)
+
+static PSEUDO_I2C_BatchTypeDef pseudo_i2c_cache[PSEUDO_I2C_CACHE_NUM];
+
+static PSEUDO_I2C_BatchTypeDef *pseudo_i2c_cache_find(u32 id)
+{
+	u32 i;
+
+	for (i = 0; i < PSEUDO_I2C_CACHE_NUM; i++) {
+		if (pseudo_i2c_cache[i].Id == id) {
+			return &pseudo_i2c_cache[i];
+		}
+	}
+
+	return NULL;
+}
+
+/**
+  * @brief  Compile transfers to their sequencer RAM images.
+  * @param  batch: compiled batch.
+  * @param  xfer: transfers, in sending order.
+  * @param  num: transfer number, 1 ~ PSEUDO_I2C_XFER_MAX.
+  * @retval RTK_SUCCESS, or RTK_ERR_BADARG if a transfer does not fit the sequencer RAM
+  *         or the transfers do not fit the batch.
+  */
+int pseudo_i2c_batch_build(PSEUDO_I2C_BatchTypeDef *batch, const PSEUDO_I2C_XferTypeDef *xfer, u32 num)
+{
+	u8 *img;
+	u32 i, words = 0;
+
+	if (num == 0 || num > PSEUDO_I2C_XFER_MAX) {
+		RTK_LOGE(TAG, "Invalid transfer number %lu\n", num);
+		return RTK_ERR_BADARG;
+	}
+
+	for (i = 0; i < num; i++) {
+		if (xfer[i].Len > PSEUDO_I2C_DATA_MAX || (xfer[i].Len && xfer[i].Data == NULL)) {
+			RTK_LOGE(TAG, "Transfer %lu does not fit the sequencer RAM\n", i);
+			return RTK_ERR_BADARG;
+		}
+		words += PSEUDO_I2C_WORDS(xfer[i].Len + 1);
+	}
+
+	if (words > PSEUDO_I2C_BATCH_WORDS) {
+		RTK_LOGE(TAG, "Batch of %lu words over %d\n", words, PSEUDO_I2C_BATCH_WORDS);
+		return RTK_ERR_BADARG;
+	}
+
+	_memset((void *)batch, 0, sizeof(PSEUDO_I2C_BatchTypeDef));
+	batch->XferNum = num;
+
+	/* the RAM is byte addressed from the command byte on, the words are little endian */
+	img = (u8 *)batch->Ram;
+	for (i = 0; i < num; i++) {
+		batch->Num[i] = xfer[i].Len + 1;
+		img[0] = xfer[i].Cmd;
+		if (xfer[i].Len) {
+			_memcpy(img + 1, xfer[i].Data, xfer[i].Len);
+		}
+		img += PSEUDO_I2C_WORDS(batch->Num[i]) * 4;
+	}
+
+	return RTK_SUCCESS;
+}
+
+/**
+  * @brief  Send the transfers of a batch, one after another.
+  * @param  batch: compiled batch.
+  * @retval None
+  * @note   The pseudo I2C shall be initialized by pseudo_i2c_init(). Returns once the last
+  *         transfer is out.
+  */
+void pseudo_i2c_batch_run(const PSEUDO_I2C_BatchTypeDef *batch)
+{
+	LEDC_PRO_TypeDef *pseudo_i2c_ctrl = PSEUDO_I2C_DEV;
+	const u32 *img = batch->Ram;
+	u32 ctl, i, j, words;
+
+	// dsiable control register portect, for the whole batch
+	pseudo_i2c_protect(REG_PROTECT_DISABLE);
+
+	ctl = pseudo_i2c_ctrl->LEDC_PRO_PSDO_I2C_CTL & ~(LEDC_PRO_MASK_R_I2C_DATA_NUM | LEDC_PRO_BIT_R_I2C_TX_STATUS);
+
+	for (i = 0; i < batch->XferNum; i++) {
+		//polling i2c status, until the previous transfer is out
+		while ((pseudo_i2c_ctrl->LEDC_PRO_PSDO_I2C_CTL & LEDC_PRO_BIT_R_I2C_TX_STATUS) == 0);
+
+		pseudo_i2c_ctrl->LEDC_PRO_LED_PALY_CTL0 |= LEDC_PRO_BIT_R_LED_BUF_CLEAR;
+
+		/* LEDC_PRO_LED_RAM is a R/W 32 bit window over the 128 bytes RAM, word writes are
+		 * allowed and fill the command and data bytes in address order */
+		words = PSEUDO_I2C_WORDS(batch->Num[i]);
+		for (j = 0; j < words; j++) {
+			HAL_WRITE32(LEDC_REG_BASE, RAM_CMD_OFFSET + 4 * j, img[j]);
+		}
+		img += words;
+
+		pseudo_i2c_ctrl->LEDC_PRO_PSDO_I2C_CTL = ctl | LEDC_PRO_R_I2C_DATA_NUM(batch->Num[i]);
+
+		//trigger i2c tx data
+		pseudo_i2c_ctrl->LEDC_PRO_SEQUENCE_CHECK0 = TRIGGER_SEQUENCE1;
+		pseudo_i2c_ctrl->LEDC_PRO_SEQUENCE_CHECK0 = TRIGGER_SEQUENCE2;
+
+		//polling sequence pass
+		while ((pseudo_i2c_ctrl->LEDC_PRO_LED_PALY_CTL0 & LEDC_PRO_BIT_R_SEQ_PASS_FLAG) == 0);
+	}
+
+	while ((pseudo_i2c_ctrl->LEDC_PRO_PSDO_I2C_CTL & LEDC_PRO_BIT_R_I2C_TX_STATUS) == 0);
+
+	//enable control register portect
+	pseudo_i2c_protect(REG_PROTECT_ENABLE);
+}
+
+/**
+  * @brief  Compile transfers to the cache, replacing a batch of the same id.
+  * @param  id: caller chosen key, not 0.
+  * @param  xfer: transfers, in sending order.
+  * @param  num: transfer number, 1 ~ PSEUDO_I2C_XFER_MAX.
+  * @retval RTK_SUCCESS, RTK_ERR_BADARG, or RTK_FAIL if the cache is full.
+  * @note   The cache is not locked, calls shall not run concurrently.
+  */
+int pseudo_i2c_cache_put(u32 id, const PSEUDO_I2C_XferTypeDef *xfer, u32 num)
+{
+	PSEUDO_I2C_BatchTypeDef *batch;
+	int ret;
+
+	if (id == 0) {
+		return RTK_ERR_BADARG;
+	}
+
+	batch = pseudo_i2c_cache_find(id);
+	if (batch == NULL) {
+		batch = pseudo_i2c_cache_find(0);
+	}
+
+	if (batch == NULL) {
+		RTK_LOGE(TAG, "Cache full\n");
+		return RTK_FAIL;
+	}
+
+	ret = pseudo_i2c_batch_build(batch, xfer, num);
+	batch->Id = ret == RTK_SUCCESS ? id : 0;
+
+	return ret;
+}
+
+/**
+  * @brief  Send a cached batch.
+  * @param  id: key given to pseudo_i2c_cache_put().
+  * @retval RTK_SUCCESS, or RTK_FAIL if no batch has this id.
+  */
+int pseudo_i2c_cache_run(u32 id)
+{
+	PSEUDO_I2C_BatchTypeDef *batch = id ? pseudo_i2c_cache_find(id) : NULL;
+
+	if (batch == NULL) {
+		return RTK_FAIL;
+	}
+
+	pseudo_i2c_batch_run(batch);
+
+	return RTK_SUCCESS;
+}
+
+/**
+  * @brief  Free the cache entry of a batch.
+  * @param  id: key given to pseudo_i2c_cache_put().
+  * @retval None
+  */
+void pseudo_i2c_cache_drop(u32 id)
+{
+	PSEUDO_I2C_BatchTypeDef *batch = id ? pseudo_i2c_cache_find(id) : NULL;
+
+	if (batch != NULL) {
+		batch->Id = 0;
+	}
+}
+
+/** @} */
+
+/** @} */
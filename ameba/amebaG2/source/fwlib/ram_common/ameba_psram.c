@@ -754,33 +754,42 @@ u32 PSRAM_PATTEN_CHECK(u32 group, u32 *data)
 	return TRUE;
 }
 
-/**
-  * @brief PSRAM SW calibration function
-  * @param DQnum: psram dq number select
-  * @retval TRUE/FALSE
-  * @note cache will be disable during calibration
-  */
-u32 PSRAM_SW_Calibration(u32 DQnum)
+/* Program one (phase, CalN) point and run the pattern test, cache lines of the pattern are bypassed. */
+static u32 psram_cal_probe(u32 DQnum, u32 tempPHYPara, u32 phase, u32 caltempN)
 {
 	PSPHY_TypeDef *psram_phy = PSRAMPHY_DEV;
-
-	u32 caltempN = 0;
-	u32 phase = 0;
-	u32 tempPHYPara, calres;
 	u32 *tempdatawr = PSRAM_CALIB_PATTERN;
 	u32 tempdatard[6] = {0, 0, 0, 0, 0, 0};
-	int window_start = -1;
-	int window_end = -1;
-	int window_size = 0;
 
-	int windowt_start = -1;
-	int windowt_size = 0;
-	int windowt_end = -1;
+	if ((DQnum == PSRAM_DQ16_SL0) || (DQnum == PSRAM_DQ8_SL0)) {
+		psram_phy->PSPHY_PRE_CAL_PAR = PSPHY_PRE_CAL_PHASE(phase);
+		psram_phy->PSPHY_CAL_PAR = tempPHYPara | caltempN;
+	} else {
+		psram_phy->PSPHY_SL1_PRE_CAL_PAR = PSPHY_SL1_PRE_CAL_PHASE(phase);
+		psram_phy->PSPHY_SL1_CAL_PAR = tempPHYPara | caltempN;
+	}
 
-	int phase_cnt = -1;
-	u32 phase_num = 8;
+	for (int i = 0; i < 6; i += 1) {
+		HAL_WRITE32(PSRAM_BASE, i * 0x50000, tempdatawr[i]);
+		DCache_CleanInvalidate(PSRAM_BASE + i * 0x50000, CACHE_LINE_SIZE);
+		tempdatard[i] = HAL_READ32(PSRAM_BASE, i * 0x50000);
+	}
+
+	if (DQnum == PSRAM_DQ16_SL0) {
+		return (PSRAM_PATTEN_CHECK((u32)PSRAM_CAL_DQ0_7, tempdatard) == TRUE) & (PSRAM_PATTEN_CHECK((u32)PSRAM_CAL_DQ16_23, tempdatard) == TRUE);
+	} else if (DQnum == PSRAM_DQ16_SL1) {
+		return (PSRAM_PATTEN_CHECK((u32)PSRAM_CAL_DQ8_15, tempdatard) == TRUE) & (PSRAM_PATTEN_CHECK((u32)PSRAM_CAL_DQ24_31, tempdatard) == TRUE);
+	} else {
+		return (_memcmp(tempdatard, PSRAM_CALIB_PATTERN, 24) == 0 ? 1 : 0);
+	}
+}
+
+/* Disable HW calibration of the slice, return CAL_PAR without CalN. */
+static u32 psram_cal_stop(u32 DQnum)
+{
+	PSPHY_TypeDef *psram_phy = PSRAMPHY_DEV;
+	u32 tempPHYPara;
 
-	/*Disable HW calibration*/
 	if ((DQnum == PSRAM_DQ16_SL0) || (DQnum == PSRAM_DQ8_SL0)) {
 		psram_phy->PSPHY_CAL_CTRL &= (~PSPHY_BIT_CFG_CAL_EN);
 		tempPHYPara = psram_phy->PSPHY_CAL_PAR & (~PSPHY_MASK_CFG_CAL_N);
@@ -791,45 +800,66 @@ u32 PSRAM_SW_Calibration(u32 DQnum)
 		psram_phy->PSPHY_SL1_PRE_CAL_PAR &= (~PSPHY_MASK_SL1_PRE_CAL_PHASE);
 	}
 
+	return tempPHYPara;
+}
+
+/* Center CalN in the window, let J track half of it and restart HW calibration. */
+static void psram_cal_apply(u32 DQnum, u32 tempPHYPara, u32 phase, int window_start, int window_end)
+{
+	PSPHY_TypeDef *psram_phy = PSRAMPHY_DEV;
+
+	tempPHYPara &= (~0xfffff);
+	tempPHYPara |= PSPHY_CFG_CAL_JMAX((window_end - window_start) / 2 - 2) | \
+				   PSPHY_CFG_CAL_J((window_end - window_start) / 2 - 2)	| \
+				   PSPHY_CFG_CAL_N((window_end + window_start) / 2);
+
+	if ((DQnum == PSRAM_DQ16_SL0) || (DQnum == PSRAM_DQ8_SL0)) {
+		psram_phy->PSPHY_CAL_PAR = tempPHYPara;
+		psram_phy->PSPHY_PRE_CAL_PAR = phase;
+		/*start HW calibration*/
+		psram_phy->PSPHY_CAL_CTRL |= PSPHY_BIT_CFG_CAL_EN;
+	} else {
+		psram_phy->PSPHY_SL1_CAL_PAR = tempPHYPara;
+		psram_phy->PSPHY_SL1_PRE_CAL_PAR = phase;
+		psram_phy->PSPHY_SL1_CAL_CTRL |= PSPHY_BIT_SL1_CFG_CAL_EN;
+	}
+}
+
+/* Sweep all (phase, CalN) points, keep the largest passing CalN window. */
+static void psram_cal_sweep(u32 DQnum, u32 tempPHYPara, PSRAM_CalSlice *Slice)
+{
+	u32 caltempN = 0;
+	u32 phase = 0;
+	u32 calres;
+	int window_start = -1;
+	int window_end = -1;
+	int window_size = 0;
+
+	int windowt_start = -1;
+	int windowt_size = 0;
+	int windowt_end = -1;
+
+	int phase_cnt = -1;
+	u32 phase_num = PSRAM_CAL_PHASE_NUM;
+
 	for (phase = 0x0; phase < phase_num; phase ++) {
 		windowt_size = 0;
 		windowt_start = -1;
 		windowt_end = -1;
 		// RTK_LOGI(TAG, "===phase %x =====\n", phase);
 
-		for (caltempN = 0; caltempN < 32; caltempN++) {
-
-			if ((DQnum == PSRAM_DQ16_SL0) || (DQnum == PSRAM_DQ8_SL0)) {
-				psram_phy->PSPHY_PRE_CAL_PAR = PSPHY_PRE_CAL_PHASE(phase);
-				psram_phy->PSPHY_CAL_PAR = tempPHYPara | caltempN;
-			} else {
-				psram_phy->PSPHY_SL1_PRE_CAL_PAR = PSPHY_SL1_PRE_CAL_PHASE(phase);
-				psram_phy->PSPHY_SL1_CAL_PAR = tempPHYPara | caltempN;
-			}
+		for (caltempN = 0; caltempN < PSRAM_CAL_TAP_NUM; caltempN++) {
 
-			for (int i = 0; i < 6; i += 1) {
-				HAL_WRITE32(PSRAM_BASE, i * 0x50000, tempdatawr[i]);
-				DCache_CleanInvalidate(PSRAM_BASE + i * 0x50000, CACHE_LINE_SIZE);
-				tempdatard[i] = HAL_READ32(PSRAM_BASE, i * 0x50000);
-			}
-
-			if (DQnum == PSRAM_DQ16_SL0) {
-				calres = (PSRAM_PATTEN_CHECK((u32)PSRAM_CAL_DQ0_7, tempdatard) == TRUE) & (PSRAM_PATTEN_CHECK((u32)PSRAM_CAL_DQ16_23, tempdatard) == TRUE);
-			} else if (DQnum == PSRAM_DQ16_SL1) {
-				calres = (PSRAM_PATTEN_CHECK((u32)PSRAM_CAL_DQ8_15, tempdatard) == TRUE) & (PSRAM_PATTEN_CHECK((u32)PSRAM_CAL_DQ24_31, tempdatard) == TRUE);
-			} else {
-				calres = (_memcmp(tempdatard, PSRAM_CALIB_PATTERN, 24) == 0 ? 1 : 0);
-			}
+			calres = psram_cal_probe(DQnum, tempPHYPara, phase, caltempN);
 
 			if (calres) {
-				//RTK_LOGI(TAG, "ok %x %x %x %x %x %x %x\n", caltempN, tempdatard[0], tempdatard[1], tempdatard[2], tempdatard[3], tempdatard[4], tempdatard[5]);
 				if (windowt_start < 0) {
 					windowt_start = caltempN;
 				}
 				windowt_end = windowt_start + windowt_size;
 				windowt_size ++;
 
-				if (caltempN == (32 - 1)) {
+				if (caltempN == (PSRAM_CAL_TAP_NUM - 1)) {
 					if (windowt_size > window_size) {
 						window_start = windowt_start;
 						window_end = windowt_end;
@@ -838,7 +868,6 @@ u32 PSRAM_SW_Calibration(u32 DQnum)
 					}
 				}
 			} else {
-				//RTK_LOGI(TAG, "fail %x %x %x %x %x %x %x\n", caltempN, tempdatard[0], tempdatard[1], tempdatard[2], tempdatard[3], tempdatard[4], tempdatard[5]);
 				if (windowt_start >= 0) {
 					if (windowt_size > window_size) {
 						window_start = windowt_start;
@@ -855,27 +884,162 @@ u32 PSRAM_SW_Calibration(u32 DQnum)
 		}
 	}
 
-	RTK_LOGI(TAG, "CalNmin = %x CalNmax = %x WindowSize = %x phase: %x \n", window_start, window_end, window_size, phase_cnt);
+	Slice->Phase = (u8)phase_cnt;
+	Slice->CalNMin = (u8)window_start;
+	Slice->CalNMax = (u8)window_end;
+	Slice->WindowSize = (u8)window_size;
+}
+
+/* Probe a tap once per phase, Known/Pass cache the results as tap bitmaps. */
+static u32 psram_cal_tap(u32 DQnum, u32 tempPHYPara, u32 phase, u32 tap, u32 *Known, u32 *Pass)
+{
+	if (!(*Known & BIT(tap))) {
+		*Known |= BIT(tap);
+		if (psram_cal_probe(DQnum, tempPHYPara, phase, tap)) {
+			*Pass |= BIT(tap);
+		}
+	}
+
+	return (*Pass & BIT(tap)) ? 1 : 0;
+}
+
+/*
+ * Same window as psram_cal_sweep with fewer probes. Every run of PSRAM_CAL_STRIDE or more
+ * passing taps holds a stride tap, so each phase is probed at the stride taps first and only
+ * runs through a passing stride tap are expanded tap by tap. A run is not expanded, or not
+ * expanded to the right, once the failing taps around it leave no room to beat the best
+ * window, ties keep the earlier window like the sweep does. If the best window is shorter
+ * than the stride a run between stride taps may have been missed, the full sweep decides.
+ */
+static void psram_cal_search(u32 DQnum, u32 tempPHYPara, PSRAM_CalSlice *Slice)
+{
+	int window_start = -1;
+	int window_end = -1;
+	int window_size = 0;
+	int phase_cnt = -1;
+	int explored_end, lo, hi, l, r, t;
+	u32 phase, known, pass, fail, probes = 0;
+
+	for (phase = 0; phase < PSRAM_CAL_PHASE_NUM; phase++) {
+		known = 0;
+		pass = 0;
+		explored_end = -1;
+
+		for (t = 0; t < PSRAM_CAL_TAP_NUM; t += PSRAM_CAL_STRIDE) {
+			psram_cal_tap(DQnum, tempPHYPara, phase, t, &known, &pass);
+		}
+
+		for (t = 0; t < PSRAM_CAL_TAP_NUM; t += PSRAM_CAL_STRIDE) {
+			if (!(pass & BIT(t)) || t <= explored_end) {
+				continue;
+			}
+
+			/* room left between the nearest known failing taps */
+			fail = known & ~pass;
+			for (lo = t; lo > 0 && !(fail & BIT(lo - 1)); lo--);
+			for (hi = t; hi < PSRAM_CAL_TAP_NUM - 1 && !(fail & BIT(hi + 1)); hi++);
+			if (hi - lo + 1 <= window_size) {
+				continue;
+			}
+
+			for (l = t; l > lo && psram_cal_tap(DQnum, tempPHYPara, phase, l - 1, &known, &pass); l--);
+			if (hi - l + 1 <= window_size) {
+				continue;
+			}
 
-	if ((window_size) < 9) {
+			for (r = t; r < hi && psram_cal_tap(DQnum, tempPHYPara, phase, r + 1, &known, &pass); r++);
+			explored_end = r;
+
+			if (r - l + 1 > window_size) {
+				window_start = l;
+				window_end = r;
+				window_size = r - l + 1;
+				phase_cnt = phase;
+			}
+		}
+
+		probes += __builtin_popcount(known);
+	}
+
+	if (window_size < PSRAM_CAL_STRIDE) {
+		RTK_LOGI(TAG, "search window %x too small, full sweep\n", window_size);
+		psram_cal_sweep(DQnum, tempPHYPara, Slice);
+		return;
+	}
+
+	RTK_LOGI(TAG, "search probes %lu of %d\n", probes, PSRAM_CAL_PHASE_NUM * PSRAM_CAL_TAP_NUM);
+
+	Slice->Phase = (u8)phase_cnt;
+	Slice->CalNMin = (u8)window_start;
+	Slice->CalNMax = (u8)window_end;
+	Slice->WindowSize = (u8)window_size;
+}
+
+/**
+  * @brief PSRAM SW calibration function
+  * @param DQnum: psram dq number select
+  * @retval TRUE/FALSE
+  * @note cache will be disable during calibration
+  */
+u32 PSRAM_SW_Calibration(u32 DQnum)
+{
+	PSRAM_CalSlice Slice;
+
+	return PSRAM_SW_CalibrationSlice(DQnum, &Slice);
+}
+
+/**
+  * @brief PSRAM SW calibration function that reports the window found
+  * @param DQnum: psram dq number select
+  * @param Slice: output, window found by the sweep
+  * @retval TRUE/FALSE
+  * @note cache will be disable during calibration
+  */
+u32 PSRAM_SW_CalibrationSlice(u32 DQnum, PSRAM_CalSlice *Slice)
+{
+	u32 tempPHYPara = psram_cal_stop(DQnum);
+
+	psram_cal_search(DQnum, tempPHYPara, Slice);
+
+	RTK_LOGI(TAG, "CalNmin = %x CalNmax = %x WindowSize = %x phase: %x \n", Slice->CalNMin, Slice->CalNMax, Slice->WindowSize, Slice->Phase);
+
+	if (Slice->WindowSize < PSRAM_CAL_WINDOW_MIN) {
 		return FALSE;
 	}
-	tempPHYPara &= (~0xfffff);
-	tempPHYPara |= PSPHY_CFG_CAL_JMAX((window_end - window_start) / 2 - 2) | \
-				   PSPHY_CFG_CAL_J((window_end - window_start) / 2 - 2)	| \
-				   PSPHY_CFG_CAL_N((window_end + window_start) / 2);
 
-	if ((DQnum == PSRAM_DQ16_SL0) || (DQnum == PSRAM_DQ8_SL0)) {
-		psram_phy->PSPHY_CAL_PAR = tempPHYPara;
-		psram_phy->PSPHY_PRE_CAL_PAR = phase_cnt;
-		/*start HW calibration*/
-		psram_phy->PSPHY_CAL_CTRL |= PSPHY_BIT_CFG_CAL_EN;
-	} else {
-		psram_phy->PSPHY_SL1_CAL_PAR = tempPHYPara;
-		psram_phy->PSPHY_SL1_PRE_CAL_PAR = phase_cnt;
-		psram_phy->PSPHY_SL1_CAL_CTRL |= PSPHY_BIT_CFG_CAL_EN;
+	psram_cal_apply(DQnum, tempPHYPara, Slice->Phase, Slice->CalNMin, Slice->CalNMax);
+
+	return TRUE;
+}
+
+/**
+  * @brief Revalidate a stored calibration window without a sweep
+  * @param DQnum: psram dq number select
+  * @param Slice: window from a previous PSRAM_SW_CalibrationSlice()
+  * @retval TRUE if both window edges and the center still pass, the window is then applied
+  * @note cache will be disable during calibration
+  */
+u32 PSRAM_SW_CalibrationCheck(u32 DQnum, const PSRAM_CalSlice *Slice)
+{
+	u32 tempPHYPara;
+	u32 mid = (Slice->CalNMin + Slice->CalNMax) / 2;
+
+	if (Slice->Phase >= PSRAM_CAL_PHASE_NUM || Slice->CalNMax >= PSRAM_CAL_TAP_NUM ||
+		Slice->CalNMin > Slice->CalNMax || Slice->WindowSize < PSRAM_CAL_WINDOW_MIN) {
+		return FALSE;
+	}
+
+	tempPHYPara = psram_cal_stop(DQnum);
+
+	/* the eye is contiguous, passing edges mean the window did not shrink */
+	if (!psram_cal_probe(DQnum, tempPHYPara, Slice->Phase, Slice->CalNMin) ||
+		!psram_cal_probe(DQnum, tempPHYPara, Slice->Phase, mid) ||
+		!psram_cal_probe(DQnum, tempPHYPara, Slice->Phase, Slice->CalNMax)) {
+		return FALSE;
 	}
 
+	psram_cal_apply(DQnum, tempPHYPara, Slice->Phase, Slice->CalNMin, Slice->CalNMax);
+
 	return TRUE;
 }
 
@@ -888,6 +1052,82 @@ u32 PSRAM_calibration(void)
 	}
 }
 
+static u32 psram_cal_record_key(u8 TempBand)
+{
+	return ((u32)PsramInfo.Psram_Vendor << 24) | ((u32)PsramInfo.Psram_Type << 16) |
+		   ((u32)PsramInfo.Psram_DQ16 << 8) | TempBand;
+}
+
+static u32 psram_cal_record_check(const PSRAM_CalRecord *Rec)
+{
+	u32 i, sum = PSRAM_CAL_REC_MAGIC ^ Rec->Key ^ Rec->ClkSet;
+
+	for (i = 0; i < 2; i++) {
+		sum = (sum << 5 | sum >> 27) ^ Rec->Slice[i].Phase ^ (Rec->Slice[i].CalNMin << 8) ^
+			  (Rec->Slice[i].CalNMax << 16) ^ ((u32)Rec->Slice[i].WindowSize << 24);
+	}
+
+	return sum;
+}
+
+/**
+  * @brief PSRAM calibration with a stored window
+  * @param Rec: calibration record kept by the caller across boots
+  * @param TempBand: temperature band of this boot, e.g. degree / 16, 0 if unknown
+  * @param Updated: output, TRUE when Rec changed and should be written back to its storage
+  * @retval TRUE/FALSE
+  * @note The record is used when it was made for the same PSRAM device, PSRAM clock and
+  *       temperature band. Each slice is then revalidated at its window edges and center,
+  *       a full sweep runs only when that fails.
+  */
+u32 PSRAM_calibration_fast(PSRAM_CalRecord *Rec, u8 TempBand, bool *Updated)
+{
+	u32 slice_dq[2];
+	u32 slice_num, i, ret = TRUE;
+	bool hit;
+
+	if (PsramInfo.Psram_DQ16 == MCM_PSRAM_DQ16) {
+		slice_dq[0] = PSRAM_DQ16_SL0;
+		slice_dq[1] = PSRAM_DQ16_SL1;
+		slice_num = 2;
+	} else {
+		slice_dq[0] = PSRAM_DQ8_SL0;
+		slice_num = 1;
+	}
+
+	hit = (Rec->Key == psram_cal_record_key(TempBand)) && (Rec->ClkSet == PsramInfo.Psram_Clk_Set) &&
+		  (Rec->Check == psram_cal_record_check(Rec));
+
+	*Updated = FALSE;
+
+	for (i = 0; i < slice_num; i++) {
+		if (hit && PSRAM_SW_CalibrationCheck(slice_dq[i], &Rec->Slice[i])) {
+			continue;
+		}
+
+		RTK_LOGI(TAG, "slice %lu: %s, full sweep\n", i, hit ? "revalidation fail" : "no record");
+		*Updated = TRUE;
+		if (PSRAM_SW_CalibrationSlice(slice_dq[i], &Rec->Slice[i]) != TRUE) {
+			ret = FALSE;
+		}
+	}
+
+	if (*Updated == FALSE) {
+		return TRUE;
+	}
+
+	if (ret == TRUE) {
+		Rec->Key = psram_cal_record_key(TempBand);
+		Rec->ClkSet = PsramInfo.Psram_Clk_Set;
+		Rec->Check = psram_cal_record_check(Rec);
+	} else {
+		/* never keep a window that did not pass */
+		Rec->Check = ~psram_cal_record_check(Rec);
+	}
+
+	return ret;
+}
+
 /**
   * @brief  set psram into half sleep mode.
   * @param  type: 0:apm psram type 1: winbond psram type
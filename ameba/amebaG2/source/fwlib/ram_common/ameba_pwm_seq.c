@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ameba_soc.h"
+#include <math.h>
+
+static const char *const TAG = "PWMSEQ";
+
+/** @addtogroup Ameba_Periph_Driver
+  * @{
+  */
+
+/** @defgroup PWM_SEQ
+  * @brief PWM_SEQ driver modules
+  * @{
+  */
+
+#define PWM_SEQ_PI					3.14159265f
+
+/* write the next step to the CCRx preload registers and move on */
+static u32 pwm_seq_load(PWM_SEQ_TypeDef *seq)
+{
+	RTIM_TypeDef *TIMx = seq->TIMx;
+	const u16 *p = seq->Next;
+	u32 evt = 0;
+	u32 i;
+
+	for (i = 0; i < seq->ChnNum; i++) {
+		TIMx->CCRx[seq->Chn[i]] = seq->Ctrl[i] | p[i];
+	}
+	p += seq->ChnNum;
+	seq->Stats.Steps++;
+
+	if (p == seq->Half) {
+		evt |= PWM_SEQ_EVT_HALF;
+	}
+
+	if (p == seq->End) {
+		if (seq->Cfg.PWM_SeqMode == PWM_SEQ_RING) {
+			p = seq->Cfg.PWM_SeqBuf;
+			seq->Stats.Wraps++;
+			evt |= PWM_SEQ_EVT_WRAP;
+		} else {
+			/* one more update event, the one ending the last step */
+			seq->Repeat++;
+		}
+	}
+
+	seq->Next = p;
+
+	return evt;
+}
+
+/**
+  * @brief  Fill each PWM_SEQ_InitTypeDef member with its default value.
+  * @param  PWM_SeqInitStruct: pointer to a PWM_SEQ_InitTypeDef structure.
+  * @retval None
+  */
+void PWM_SEQ_StructInit(PWM_SEQ_InitTypeDef *PWM_SeqInitStruct)
+{
+	_memset((void *)PWM_SeqInitStruct, 0, sizeof(PWM_SEQ_InitTypeDef));
+	PWM_SeqInitStruct->PWM_SeqTimIdx = 4;
+	PWM_SeqInitStruct->PWM_SeqChnMask = BIT(TIM_Channel_0);
+	PWM_SeqInitStruct->PWM_SeqMode = PWM_SEQ_RING;
+	PWM_SeqInitStruct->PWM_SeqRepeat = 1;
+}
+
+/**
+  * @brief  Initialize a sequencer and enable the CCRx preload of its channels.
+  * @param  seq: sequencer instance.
+  * @param  PWM_SeqInitStruct: pointer to a PWM_SEQ_InitTypeDef structure.
+  * @retval RTK_SUCCESS or RTK_ERR_BADARG.
+  * @note   The timer and its channels shall be initialized before, the channel mode,
+  *         polarity and enable bits are kept.
+  */
+int PWM_SEQ_Init(PWM_SEQ_TypeDef *seq, PWM_SEQ_InitTypeDef *PWM_SeqInitStruct)
+{
+	u32 idx = PWM_SeqInitStruct->PWM_SeqTimIdx;
+	u32 mask = PWM_SeqInitStruct->PWM_SeqChnMask;
+	RTIM_TypeDef *TIM;
+	u32 ch, ccr;
+
+	if (idx < 4 || idx > 7 || mask == 0 || mask >= BIT(PWM_CHAN_MAX) || PWM_SeqInitStruct->PWM_SeqBuf == NULL ||
+		PWM_SeqInitStruct->PWM_SeqLen == 0 || PWM_SeqInitStruct->PWM_SeqRepeat == 0 ||
+		PWM_SeqInitStruct->PWM_SeqMode > PWM_SEQ_RING) {
+		RTK_LOGE(TAG, "Invalid sequencer config\n");
+		return RTK_ERR_BADARG;
+	}
+
+	_memset((void *)seq, 0, sizeof(PWM_SEQ_TypeDef));
+	seq->Cfg = *PWM_SeqInitStruct;
+	seq->TIMx = TIM = TIMx[idx];
+
+	for (ch = 0; ch < PWM_CHAN_MAX; ch++) {
+		if ((mask & BIT(ch)) == 0) {
+			continue;
+		}
+
+		ccr = TIM->CCRx[ch] | TIM_BIT_OCxPE;
+		TIM->CCRx[ch] = ccr;
+		seq->Ctrl[seq->ChnNum] = ccr & ~TIM_MASK_CCRx;
+		seq->Chn[seq->ChnNum++] = ch;
+	}
+
+	seq->Half = seq->Cfg.PWM_SeqBuf + (seq->Cfg.PWM_SeqLen / 2) * seq->ChnNum;
+	seq->End = seq->Cfg.PWM_SeqBuf + seq->Cfg.PWM_SeqLen * seq->ChnNum;
+
+	return RTK_SUCCESS;
+}
+
+/**
+  * @brief  Play the buffer from its first step.
+  * @param  seq: sequencer instance.
+  * @retval None
+  * @note   Step 0 is output from the next update event of the timer, which shall be
+  *         running.
+  */
+void PWM_SEQ_Start(PWM_SEQ_TypeDef *seq)
+{
+	u32 PrevStatus = __get_PRIMASK();
+	u32 evt;
+
+	__disable_irq();
+
+	RTIM_INTConfig(seq->TIMx, TIM_IT_Update, DISABLE);
+	seq->TIMx->SR = TIM_BIT_UIF;
+
+	seq->Next = seq->Cfg.PWM_SeqBuf;
+	seq->Repeat = seq->Cfg.PWM_SeqRepeat;
+	seq->Running = TRUE;
+	evt = pwm_seq_load(seq);
+	RTIM_INTConfig(seq->TIMx, TIM_IT_Update, ENABLE);
+
+	__set_PRIMASK(PrevStatus);
+
+	if (evt && seq->Cfg.PWM_SeqCb) {
+		seq->Cfg.PWM_SeqCb(seq->Cfg.PWM_SeqCbData, evt);
+	}
+}
+
+/**
+  * @brief  Stop the sequence, the channels hold the step loaded last.
+  * @param  seq: sequencer instance.
+  * @retval None
+  */
+void PWM_SEQ_Stop(PWM_SEQ_TypeDef *seq)
+{
+	u32 PrevStatus = __get_PRIMASK();
+
+	__disable_irq();
+	seq->Running = FALSE;
+	RTIM_INTConfig(seq->TIMx, TIM_IT_Update, DISABLE);
+	__set_PRIMASK(PrevStatus);
+}
+
+/**
+  * @brief  Load the next step when the current one has been output PWM_SeqRepeat periods.
+  * @param  seq: sequencer instance.
+  * @retval None
+  * @note   Called from the timer interrupt handler, on the update event.
+  */
+void PWM_SEQ_IRQHandler(PWM_SEQ_TypeDef *seq)
+{
+	RTIM_TypeDef *TIMx = seq->TIMx;
+	u32 evt;
+
+	if ((TIMx->SR & TIM_BIT_UIF) == 0) {
+		return;
+	}
+	TIMx->SR = TIM_BIT_UIF;
+
+	if (!seq->Running) {
+		return;
+	}
+
+	seq->Stats.Periods++;
+
+	if (--seq->Repeat) {
+		return;
+	}
+
+	if (seq->Next == seq->End) {
+		/* one-shot, the last step has been output PWM_SeqRepeat periods */
+		seq->Running = FALSE;
+		RTIM_INTConfig(TIMx, TIM_IT_Update, DISABLE);
+		evt = PWM_SEQ_EVT_DONE;
+	} else {
+		seq->Repeat = seq->Cfg.PWM_SeqRepeat;
+		evt = pwm_seq_load(seq);
+	}
+
+	if (evt && seq->Cfg.PWM_SeqCb) {
+		seq->Cfg.PWM_SeqCb(seq->Cfg.PWM_SeqCbData, evt);
+	}
+
+	/* the next period already began, a step was output one period too long */
+	if (TIMx->SR & TIM_BIT_UIF) {
+		seq->Stats.Overruns++;
+	}
+}
+
+/**
+  * @brief  Get a snapshot of the sequencer statistics.
+  * @param  seq: sequencer instance.
+  * @param  Stats: pointer to the statistics copy.
+  * @retval None
+  */
+void PWM_SEQ_GetStats(PWM_SEQ_TypeDef *seq, PWM_SEQ_StatsTypeDef *Stats)
+{
+	u32 PrevStatus = __get_PRIMASK();
+
+	__disable_irq();
+	*Stats = seq->Stats;
+	__set_PRIMASK(PrevStatus);
+}
+
+/**
+  * @brief  Fill one period of a sine, starting at the middle value and going up.
+  * @param  Tbl: table, Len * Stride entries.
+  * @param  Len: steps per period.
+  * @param  Stride: distance between two steps, the channel number for an interleaved buffer.
+  * @param  Min: lowest compare value.
+  * @param  Max: highest compare value.
+  * @retval None
+  */
+void PWM_SEQ_TableSine(u16 *Tbl, u32 Len, u32 Stride, u16 Min, u16 Max)
+{
+	float mid = ((float)Min + (float)Max) / 2;
+	float amp = ((float)Max - (float)Min) / 2;
+	u32 i;
+
+	for (i = 0; i < Len; i++) {
+		Tbl[i * Stride] = (u16)(mid + amp * sinf(2 * PWM_SEQ_PI * i / Len) + 0.5f);
+	}
+}
+
+/**
+  * @brief  Fill a linear ramp, both ends included.
+  * @param  Tbl: table, Len * Stride entries.
+  * @param  Len: steps.
+  * @param  Stride: distance between two steps.
+  * @param  From: first compare value.
+  * @param  To: last compare value.
+  * @retval None
+  */
+void PWM_SEQ_TableRamp(u16 *Tbl, u32 Len, u32 Stride, u16 From, u16 To)
+{
+	s32 span = (s32)To - (s32)From;
+	s32 div = Len > 1 ? (s32)Len - 1 : 1;
+	s32 i;
+
+	for (i = 0; i < (s32)Len; i++) {
+		/* round half away from zero, for rising and falling ramps alike */
+		Tbl[i * Stride] = (u16)(From + (span * i + (span >= 0 ? div / 2 : -div / 2)) / div);
+	}
+}
+
+/**
+  * @brief  Fill a fade whose perceived brightness changes linearly, both ends included.
+  * @param  Tbl: table, Len * Stride entries.
+  * @param  Len: steps.
+  * @param  Stride: distance between two steps.
+  * @param  From: first compare value.
+  * @param  To: last compare value.
+  * @param  Gamma: display gamma, 2.2 for the usual LEDs, 1 gives a linear ramp.
+  * @retval None
+  */
+void PWM_SEQ_TableFade(u16 *Tbl, u32 Len, u32 Stride, u16 From, u16 To, float Gamma)
+{
+	float span = (float)To - (float)From;
+	float div = Len > 1 ? (float)(Len - 1) : 1.0f;
+	u32 i;
+
+	for (i = 0; i < Len; i++) {
+		/* the value lies between From and To, never negative, so +0.5 rounds both ways */
+		Tbl[i * Stride] = (u16)(From + span * powf(i / div, Gamma) + 0.5f);
+	}
+}
+
+/** @} */
+
+/** @} */
@@ -6,6 +6,16 @@
 
 #include "ameba_soc.h"
 
+/* last RTC second read by RTC_EpochGet(), dropped whenever the calendar is written */
+static struct {
+	u8 Valid;
+	u8 EdgeKnown;		/* EdgeLowUs bounds the start of the cached second */
+	u32 TR;
+	s64 Sec;
+	u64 EdgeLowUs;		/* last read still in the previous second */
+	u64 ReadUs;			/* last register read, 64 bits so no idle gap wraps into the window */
+} rtc_epoch;
+
 /**
   * @brief  Enable rtc function.
   * @param  NewState: new state of RTC.
@@ -352,6 +362,7 @@ u32 RTC_Init(RTC_InitTypeDef *RTC_InitStruct)
 
 		/* Exit Initialization mode */
 		RTC_ExitInitMode();
+		rtc_epoch.Valid = FALSE;
 
 		if (RTC_WaitForSynchro()) {
 			status = 1;
@@ -466,6 +477,7 @@ u32 RTC_SetTime(u32 RTC_Format, RTC_TimeTypeDef *RTC_TimeStruct)
 
 		/* Exit Initialization mode */
 		RTC_ExitInitMode();
+		rtc_epoch.Valid = FALSE;
 
 		if (RTC_WaitForSynchro()) {
 			status = 1;
@@ -565,6 +577,7 @@ u32 RTC_SetTimeDayYear(u32 RTC_TimeDay, u32 RTC_TimeYear)
 
 		/* Exit Initialization mode */
 		RTC_ExitInitMode();
+		rtc_epoch.Valid = FALSE;
 
 		if (RTC_WaitForSynchro()) {
 			status = 1;
@@ -1260,6 +1273,7 @@ u32 RTC_DayLightSavingConfig(u32 RTC_DayLightSaving, u32 RTC_StoreOperation)
 
 		/* Exit Initialization mode */
 		RTC_ExitInitMode();
+		rtc_epoch.Valid = FALSE;
 
 		if (RTC_WaitForSynchro()) {
 			status = 1;
@@ -1428,3 +1442,240 @@ u32 RTC_SmoothCalibConfig(u32 CalibSign, u32 Value, u32 CalibPeriod, u32 Calib_E
 
 	return status;
 }
+
+/* days from 1970-01-01 to y-m-d, proleptic Gregorian, any y */
+static s32 rtc_days_from_civil(s32 y, u32 m, u32 d)
+{
+	s32 era;
+	u32 yoe, doy, doe;
+
+	/* years start in March, so the leap day is the last day of the year */
+	y -= (m <= 2);
+	era = (y >= 0 ? y : y - 399) / 400;
+	yoe = (u32)(y - era * 400);
+	doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+	doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+
+	return era * 146097 + (s32)doe - 719468;
+}
+
+/* epoch of the calendar registers, TR and YEAR read as one */
+static s64 rtc_epoch_from_reg(u32 tr, u32 cr, u32 year)
+{
+	u32 hours = RTC_Bcd2ToByte((u8)((tr & (RTC_MASK_HT | RTC_MASK_HU)) >> RTC_SHIFT_HU));
+	u32 minutes = RTC_Bcd2ToByte((u8)((tr & (RTC_MASK_MNT | RTC_MASK_MNU)) >> RTC_SHIFT_MNU));
+	u32 seconds = RTC_Bcd2ToByte((u8)(tr & (RTC_MASK_ST | RTC_MASK_SU)));
+	s32 days;
+
+	if ((cr & RTC_BIT_FMT) != RTC_HourFormat_24) {
+		hours %= 12;
+		if (tr & RTC_BIT_PM) {
+			hours += 12;
+		}
+	}
+
+	days = rtc_days_from_civil(RTC_BASE_YEAR + RTC_GET_YEAR(year), 1, 1) + RTC_GET_DAY(tr);
+
+	return (s64)days * 86400 + hours * 3600 + minutes * 60 + seconds;
+}
+
+/**
+  * @brief  Convert a UTC calendar date to seconds since 1970-01-01 00:00:00, as timegm().
+  * @param  RTC_DateStruct: date, RTC_YearDay and RTC_WeekDay are ignored.
+  * @retval Epoch seconds, negative before 1970.
+  */
+s64 RTC_DateToEpoch(RTC_DateTypeDef *RTC_DateStruct)
+{
+	s32 days = rtc_days_from_civil(RTC_DateStruct->RTC_Year, RTC_DateStruct->RTC_Month, RTC_DateStruct->RTC_MonthDay);
+
+	return (s64)days * 86400 + RTC_DateStruct->RTC_Hours * 3600 + RTC_DateStruct->RTC_Minutes * 60 +
+		   RTC_DateStruct->RTC_Seconds;
+}
+
+/**
+  * @brief  Convert seconds since 1970-01-01 00:00:00 to a UTC calendar date, as gmtime().
+  * @param  Epoch: epoch seconds, RTC_EPOCH_MIN ~ RTC_EPOCH_MAX.
+  * @param  RTC_DateStruct: pointer to the date to fill.
+  * @retval None
+  * @note   Constant time, no loop over years or months.
+  */
+void RTC_EpochToDate(s64 Epoch, RTC_DateTypeDef *RTC_DateStruct)
+{
+	s32 days = (s32)(Epoch / 86400);
+	s32 sod = (s32)(Epoch - (s64)days * 86400);
+	s32 z, era, y;
+	u32 doe, yoe, doy, mp;
+
+	if (sod < 0) {
+		sod += 86400;
+		days--;
+	}
+
+	/* 1970-01-01 was a Thursday */
+	RTC_DateStruct->RTC_WeekDay = (u8)((days % 7 + 11) % 7);
+
+	z = days + 719468;
+	era = (z >= 0 ? z : z - 146096) / 146097;
+	doe = (u32)(z - era * 146097);
+	yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+	y = (s32)yoe + era * 400;
+	doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+	mp = (5 * doy + 2) / 153;
+
+	RTC_DateStruct->RTC_MonthDay = (u8)(doy - (153 * mp + 2) / 5 + 1);
+	RTC_DateStruct->RTC_Month = (u8)(mp < 10 ? mp + 3 : mp - 9);
+	y += (RTC_DateStruct->RTC_Month <= 2);
+
+	RTC_DateStruct->RTC_Year = (u16)y;
+	RTC_DateStruct->RTC_YearDay = (u16)(days - rtc_days_from_civil(y, 1, 1));
+	RTC_DateStruct->RTC_Hours = (u8)(sod / 3600);
+	RTC_DateStruct->RTC_Minutes = (u8)(sod / 60 % 60);
+	RTC_DateStruct->RTC_Seconds = (u8)(sod % 60);
+}
+
+/**
+  * @brief  Set the RTC calendar from epoch seconds.
+  * @param  Epoch: epoch seconds, RTC_EPOCH_MIN ~ RTC_EPOCH_MAX.
+  * @retval status value:
+  *          - 1: RTC time, day and year are configured
+  *          - 0: RTC time, day and year are not configured
+  * @note   Time, day and year are written in one initialization mode entry.
+  */
+u32 RTC_EpochSet(s64 Epoch)
+{
+	RTC_TypeDef *RTC = RTC_DEV;
+
+	if (TrustZone_IsSecure()) {
+		RTC = RTC_DEV_S;
+	}
+
+	RTC_DateTypeDef date;
+	u32 tmpreg, hours, pm = 0;
+	u32 status = 0;
+
+	if (Epoch < RTC_EPOCH_MIN || Epoch > RTC_EPOCH_MAX) {
+		return 0;
+	}
+
+	RTC_EpochToDate(Epoch, &date);
+
+	hours = date.RTC_Hours;
+	if ((RTC->RTC_CR & RTC_BIT_FMT) != RTC_HourFormat_24) {
+		pm = hours >= 12;
+		hours %= 12;
+		if (hours == 0) {
+			hours = 12;
+		}
+	}
+
+	tmpreg = RTC_DAY(date.RTC_YearDay) | RTC_PM(pm) |
+			 ((u32)RTC_ByteToBcd2((u8)hours) << RTC_SHIFT_HU) |
+			 ((u32)RTC_ByteToBcd2(date.RTC_Minutes) << RTC_SHIFT_MNU) |
+			 (u32)RTC_ByteToBcd2(date.RTC_Seconds);
+
+	/* Disable the write protection for RTC registers */
+	RTC->RTC_WPR = RTC_KEY(0xCA);
+	RTC->RTC_WPR = RTC_KEY(0x53);
+
+	/* Set Initialization mode */
+	if (RTC_EnterInitMode()) {
+		RTC->RTC_TR = (u32)(tmpreg & RTC_TR_RESERVED_MASK);
+
+		/* keep the restore flag */
+		RTC->RTC_YEAR = (RTC->RTC_YEAR & ~RTC_MASK_YEAR) | RTC_YEAR(date.RTC_Year - RTC_BASE_YEAR);
+
+		/* Exit Initialization mode */
+		RTC_ExitInitMode();
+		rtc_epoch.Valid = FALSE;
+
+		if (RTC_WaitForSynchro()) {
+			status = 1;
+		} else {
+			status = 0;
+		}
+	}
+
+	/* Enable the write protection for RTC registers */
+	RTC->RTC_WPR = RTC_KEY(0xFF);
+
+	return status;
+}
+
+/**
+  * @brief  Get the RTC time as epoch seconds.
+  * @retval Epoch seconds.
+  * @note   The calendar registers are read only until the start of the current second is
+  *         located, by two reads on both sides of it. Up to the next second, minus
+  *         RTC_EPOCH_GUARD_US, the cached second is returned after a debug timer read.
+  * @note   Call RTC_EpochSync() after leaving a low power mode.
+  */
+s64 RTC_EpochGet(void)
+{
+	RTC_TypeDef *RTC = RTC_DEV;
+
+	if (TrustZone_IsSecure()) {
+		RTC = RTC_DEV_S;
+	}
+
+	u32 PrevStatus = __get_PRIMASK();
+	u32 tr, cr, year;
+	u64 now, edge;
+	s64 sec;
+
+	__disable_irq();
+
+	now = DTimestamp64_Get();
+
+	if (rtc_epoch.Valid && rtc_epoch.EdgeKnown && now - rtc_epoch.EdgeLowUs < 1000000 - RTC_EPOCH_GUARD_US) {
+		sec = rtc_epoch.Sec;
+		__set_PRIMASK(PrevStatus);
+		return sec;
+	}
+
+	/* a second edge between the two TR reads may have moved the year */
+	do {
+		tr = RTC->RTC_TR;
+		cr = RTC->RTC_CR;
+		year = RTC->RTC_YEAR;
+	} while (RTC->RTC_TR != tr);
+
+	if (!rtc_epoch.Valid || tr != rtc_epoch.TR) {
+		sec = rtc_epoch_from_reg(tr, cr, year);
+
+		/* the new second began after the previous read only if that read saw the second before,
+		 * and not earlier than one second, less the drift, after the start of that second */
+		edge = rtc_epoch.ReadUs;
+		if (rtc_epoch.Valid && rtc_epoch.EdgeKnown && rtc_epoch.EdgeLowUs + 1000000 - RTC_EPOCH_GUARD_US > edge) {
+			edge = rtc_epoch.EdgeLowUs + 1000000 - RTC_EPOCH_GUARD_US;
+		}
+
+		rtc_epoch.EdgeKnown = rtc_epoch.Valid && sec == rtc_epoch.Sec + 1 && now - rtc_epoch.ReadUs < 1000000;
+		rtc_epoch.EdgeLowUs = edge;
+		rtc_epoch.Sec = sec;
+		rtc_epoch.TR = tr;
+		rtc_epoch.Valid = TRUE;
+	}
+
+	rtc_epoch.ReadUs = now;
+	sec = rtc_epoch.Sec;
+
+	__set_PRIMASK(PrevStatus);
+
+	return sec;
+}
+
+/**
+  * @brief  Drop the cached second of RTC_EpochGet() and wait for the shadow registers.
+  * @retval None
+  * @note   The calendar write functions of this driver drop the cache by themselves.
+  */
+void RTC_EpochSync(void)
+{
+	u32 PrevStatus = __get_PRIMASK();
+
+	__disable_irq();
+	rtc_epoch.Valid = FALSE;
+	__set_PRIMASK(PrevStatus);
+
+	RTC_WaitForSynchro();
+}
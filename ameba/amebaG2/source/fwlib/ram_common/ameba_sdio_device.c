@@ -139,77 +139,76 @@ void SPDIO_Recycle_Rx_BD(SDIO_TypeDef *SDIO, PSPDIO_ADAPTER pSPDIODev, spdio_dev
 	}
 }
 
-/**
- * @brief Spdio write function.
- * @param obj Pointer to a initialized spdio_t structure.
- * @param pbuf Pointer to a spdio_buf_t structure which carries the payload.
- * @retval RTK_SUCCESS or RTK_FAIL.
- */
-u8 SPDIO_DeviceTx(SDIO_TypeDef *SDIO, PSPDIO_ADAPTER pSPDIODev, struct spdio_buf_t *pbuf)
+/* RX_BDs a packet takes, the descriptor BD included for SDIO_WIFI */
+static u16 spdio_tx_bd_num(SDIO_TypeDef *SDIO, u16 pkt_size)
 {
-	SPDIO_RX_BD_HANDLE *pRxBdHdl;
-	SPDIO_RX_BD *pRXBD;
-	INIC_RX_DESC *pRxDesc;
-	u16 RxBdRdPtr = pSPDIODev->RXBDRPtr; // RX_BD read pointer
-	u16 pkt_size = pbuf->buf_size;
-	u16 pkt_offset = 0;
-	u8 needed_rxbd_num;
+	u16 num;
 
-	assert_param(IS_SDIO_DEVICE(SDIO));
-
-	/* check if RX_BD available */
-	if (SDIO_WIFI == SDIO) {
 #if defined(SDIO_RX_PKT_SIZE_OVER_16K) && SDIO_RX_PKT_SIZE_OVER_16K
-		needed_rxbd_num = ((pkt_size - 1) / SPDIO_MAX_RX_BD_BUF_SIZE) + SPDIO_MIN_RX_BD_SEND_PKT;
+	num = (pkt_size == 0) ? 1 : ((pkt_size - 1) / SPDIO_MAX_RX_BD_BUF_SIZE) + 1;
 #else
-		needed_rxbd_num = SPDIO_MIN_RX_BD_SEND_PKT;
+	UNUSED(pkt_size);
+	num = 1;
 #endif
-	} else {
-		needed_rxbd_num = 0x1;
+
+	if (SDIO_WIFI == SDIO) {
+		num++;
 	}
 
-	if (RxBdRdPtr == pSPDIODev->RXBDWPtr) {
-		/* Idle */
-	} else if (pSPDIODev->RXBDWPtr > RxBdRdPtr) {
-		if ((pSPDIODev->RXBDWPtr - RxBdRdPtr) >= (pSPDIODev->host_rx_bd_num - needed_rxbd_num)) {
-			RTK_LOGS(TAG, RTK_LOG_WARN, "No Available RX_BD, ReadPtr=%d WritePtr=%d\n", RxBdRdPtr, pSPDIODev->RXBDWPtr);
-			return FALSE;
-		}
+	return num;
+}
+
+/* RX_BDs the host has not consumed yet are in use, one BD is kept empty to tell a full ring from an empty one */
+static u16 spdio_tx_bd_free(PSPDIO_ADAPTER pSPDIODev)
+{
+	u16 used;
+
+	if (pSPDIODev->RXBDWPtr >= pSPDIODev->RXBDRPtr) {
+		used = pSPDIODev->RXBDWPtr - pSPDIODev->RXBDRPtr;
 	} else {
-		if ((RxBdRdPtr - pSPDIODev->RXBDWPtr) <= needed_rxbd_num) {
-			RTK_LOGS(TAG, RTK_LOG_WARN, "No Available RX_BD, ReadPtr=%d WritePtr=%d\n", RxBdRdPtr, pSPDIODev->RXBDWPtr);
-			return FALSE;
-		}
+		used = pSPDIODev->host_rx_bd_num - pSPDIODev->RXBDRPtr + pSPDIODev->RXBDWPtr;
 	}
 
-	if (SDIO_WIFI == SDIO) {
-		/* a SDIO RX packet will use at least 2 RX_BD, the 1st one is for RX_Desc, other RX_BDs are for packet payload */
-		pRxBdHdl = pSPDIODev->pRXBDHdl + pSPDIODev->RXBDWPtr;
-		pRXBD = pRxBdHdl->pRXBD;
-		if (!pRxBdHdl->isFree) {
-			RTK_LOGS(TAG, RTK_LOG_ERROR, "Allocated a non-free RX_BD\n");
-			assert_param(FALSE);
-		}
+	return pSPDIODev->host_rx_bd_num - 1 - used;
+}
 
-		pRxDesc = pRxBdHdl->pRXDESC;
-		pRxDesc->type = pbuf->type;
-		pRxDesc->pkt_len = pkt_size;
-		pRxDesc->offset = sizeof(INIC_RX_DESC);
-		DCache_CleanInvalidate((u32)pRxDesc, sizeof(INIC_RX_DESC));
+/* Fill a descriptor BD at the write pointer, cache maintenance is left to the caller */
+static void spdio_tx_fill_desc(PSPDIO_ADAPTER pSPDIODev, u8 type, u16 pkt_len, u16 agg_num, u8 first)
+{
+	SPDIO_RX_BD_HANDLE *pRxBdHdl = pSPDIODev->pRXBDHdl + pSPDIODev->RXBDWPtr;
+	SPDIO_RX_BD *pRXBD = pRxBdHdl->pRXBD;
+	INIC_RX_DESC *pRxDesc = pRxBdHdl->pRXDESC;
 
-		pRxBdHdl->isFree = FALSE;
-		pRXBD->FS = 1;
-		pRXBD->LS = 0;
-		pRXBD->PhyAddr = (u32)pRxDesc;
-		pRXBD->BuffSize = sizeof(INIC_RX_DESC);
-		DCache_CleanInvalidate((u32)pRXBD, sizeof(SPDIO_RX_BD));
-		pRxBdHdl->isPktEnd = 0;
-		SDIO_INCR_RING_IDX(pSPDIODev->RXBDWPtr, pSPDIODev->host_rx_bd_num);
+	if (!pRxBdHdl->isFree) {
+		RTK_LOGS(TAG, RTK_LOG_ERROR, "Allocated a non-free RX_BD\n");
+		assert_param(FALSE);
 	}
 
+	pRxDesc->type = type;
+	pRxDesc->pkt_len = pkt_len;
+	pRxDesc->offset = sizeof(INIC_RX_DESC);
+	pRxDesc->data_len = agg_num;
+
+	pRxBdHdl->isFree = FALSE;
+	pRxBdHdl->isPktEnd = 0;
+	pRXBD->FS = first;
+	pRXBD->LS = 0;
+	pRXBD->PhyAddr = (u32)pRxDesc;
+	pRXBD->BuffSize = sizeof(INIC_RX_DESC);
+	SDIO_INCR_RING_IDX(pSPDIODev->RXBDWPtr, pSPDIODev->host_rx_bd_num);
+}
+
+/* Fill the payload BDs of a packet at the write pointer, cache maintenance of the BDs is left to the caller */
+static void spdio_tx_fill_payload(SDIO_TypeDef *SDIO, PSPDIO_ADAPTER pSPDIODev, struct spdio_buf_t *pbuf, u8 last)
+{
+	SPDIO_RX_BD_HANDLE *pRxBdHdl;
+	SPDIO_RX_BD *pRXBD;
+	u16 pkt_size = pbuf->buf_size;
+	u16 pkt_offset = 0;
+
 	assert_param(pbuf->buf_addr % SPDIO_DMA_ALIGN_4 == 0);
 	DCache_CleanInvalidate((u32)pbuf->buf_addr, pbuf->buf_size);
-	/* Take RX_BD to transmit packet payload */
+
 	do {
 		pRxBdHdl = pSPDIODev->pRXBDHdl + pSPDIODev->RXBDWPtr;
 		pRXBD = pRxBdHdl->pRXBD;
@@ -220,6 +219,7 @@ u8 SPDIO_DeviceTx(SDIO_TypeDef *SDIO, PSPDIO_ADAPTER pSPDIODev, struct spdio_buf
 		} else {
 			pRXBD->FS = 1;
 		}
+		pRXBD->LS = 0;
 
 		pRXBD->PhyAddr = (u32)((u8 *)pbuf->buf_addr + pkt_offset);
 #if defined(SDIO_RX_PKT_SIZE_OVER_16K) && SDIO_RX_PKT_SIZE_OVER_16K
@@ -242,16 +242,138 @@ u8 SPDIO_DeviceTx(SDIO_TypeDef *SDIO, PSPDIO_ADAPTER pSPDIODev, struct spdio_buf
 		pkt_offset += pRXBD->BuffSize;
 		if (pkt_offset >= pkt_size) {
 			pRxBdHdl->dev_tx_buf = pbuf;
-			pRXBD->LS = 1;
+			pRXBD->LS = last;
 		}
-		DCache_CleanInvalidate((u32)pRXBD, sizeof(SPDIO_RX_BD));
 		SDIO_INCR_RING_IDX(pSPDIODev->RXBDWPtr, pSPDIODev->host_rx_bd_num);
 	} while (pkt_offset < pkt_size);
+}
+
+/* Write back RX_BDs (and their descriptors) [start, end) of the ring, at most two contiguous spans */
+static void spdio_tx_bd_clean(SDIO_TypeDef *SDIO, PSPDIO_ADAPTER pSPDIODev, u16 start, u16 end)
+{
+	SPDIO_RX_BD_HANDLE *pHdl = pSPDIODev->pRXBDHdl;
+	u16 num;
+
+	while (start != end) {
+		num = (end > start) ? (end - start) : (pSPDIODev->host_rx_bd_num - start);
+
+		if (SDIO_WIFI == SDIO) {
+			DCache_CleanInvalidate((u32)pHdl[start].pRXDESC, num * sizeof(INIC_RX_DESC));
+		}
+		DCache_CleanInvalidate((u32)pHdl[start].pRXBD, num * sizeof(SPDIO_RX_BD));
+
+		start += num;
+		if (start >= pSPDIODev->host_rx_bd_num) {
+			start = 0;
+		}
+	}
+}
+
+/* Consecutive frames from pbuf[idx] that go into one aggregated transfer, and the RX_BDs they take */
+static u16 spdio_tx_agg_run(struct spdio_buf_t **pbuf, u16 idx, u16 num, u16 agg_thres, u16 bd_free, u16 *bd_need, u16 *agg_len)
+{
+	u32 len = 0;
+	u16 cnt = 0;
+	u16 need = 1;	/* outer descriptor */
+
+	/* an aggregated frame takes its descriptor BD and a single payload BD */
+	agg_thres = MIN(agg_thres, SPDIO_MAX_RX_BD_BUF_SIZE);
+
+	while (idx + cnt < num && cnt < SPDIO_TX_AGG_MAX_NUM) {
+		if (pbuf[idx + cnt]->buf_size > agg_thres || pbuf[idx + cnt]->type != pbuf[idx]->type) {
+			break;
+		}
+		if (len + sizeof(INIC_RX_DESC) + pbuf[idx + cnt]->buf_size > SPDIO_TX_AGG_MAX_SIZE || need + 2 > bd_free) {
+			break;
+		}
+		len += sizeof(INIC_RX_DESC) + pbuf[idx + cnt]->buf_size;
+		need += 2;
+		cnt++;
+	}
+
+	*bd_need = need;
+	*agg_len = len;
+
+	return cnt;
+}
+
+/**
+ * @brief Spdio vectored write function, posts several packets with one RX_BD write pointer update.
+ * @param SDIO SDIO_WIFI or SDIO_BT.
+ * @param pSPDIODev Pointer to a SDIO device data structure.
+ * @param pbuf Array of spdio_buf_t pointers, sent in order.
+ * @param num Number of packets in pbuf.
+ * @param agg_thres SDIO_WIFI only, consecutive frames of the same type up to this size are aggregated into one
+ * 		transfer, 0 disables aggregation. The host shall understand the aggregated format, see SPDIO_TX_AGG_MAX_NUM.
+ * @retval Number of packets posted, the packets from the return value on did not fit in the RX_BD ring.
+ * @note The BDs and descriptors are written back with one cache maintenance over the written span, and the host
+ * 		is requested once for the whole batch. spdio_device_tx_done_cb is still called per packet.
+ */
+u16 SPDIO_DeviceTxBatch(SDIO_TypeDef *SDIO, PSPDIO_ADAPTER pSPDIODev, struct spdio_buf_t **pbuf, u16 num, u16 agg_thres)
+{
+	u16 start = pSPDIODev->RXBDWPtr;
+	u16 bd_free = spdio_tx_bd_free(pSPDIODev);
+	u16 idx = 0;
+	u16 cnt, need, agg_len, i;
+
+	assert_param(IS_SDIO_DEVICE(SDIO));
+
+	if (SDIO_WIFI != SDIO) {
+		agg_thres = 0;
+	}
+
+	while (idx < num) {
+		cnt = 0;
+		if (agg_thres) {
+			cnt = spdio_tx_agg_run(pbuf, idx, num, agg_thres, bd_free, &need, &agg_len);
+		}
+
+		if (cnt > 1) {
+			/* outer descriptor carries the frame count, each frame follows with its own descriptor */
+			spdio_tx_fill_desc(pSPDIODev, pbuf[idx]->type, agg_len, cnt, 1);
+			for (i = 0; i < cnt; i++) {
+				spdio_tx_fill_desc(pSPDIODev, pbuf[idx + i]->type, pbuf[idx + i]->buf_size, 0, 0);
+				spdio_tx_fill_payload(SDIO, pSPDIODev, pbuf[idx + i], (i == cnt - 1) ? 1 : 0);
+			}
+		} else {
+			cnt = 1;
+			need = spdio_tx_bd_num(SDIO, pbuf[idx]->buf_size);
+			if (need > bd_free) {
+				break;
+			}
+			if (SDIO_WIFI == SDIO) {
+				/* a SDIO RX packet will use at least 2 RX_BD, the 1st one is for RX_Desc, other RX_BDs are for packet payload */
+				spdio_tx_fill_desc(pSPDIODev, pbuf[idx]->type, pbuf[idx]->buf_size, 0, 1);
+			}
+			spdio_tx_fill_payload(SDIO, pSPDIODev, pbuf[idx], 1);
+		}
+
+		bd_free -= need;
+		idx += cnt;
+	}
+
+	if (idx == 0) {
+		RTK_LOGS(TAG, RTK_LOG_WARN, "No Available RX_BD, ReadPtr=%d WritePtr=%d\n", pSPDIODev->RXBDRPtr, pSPDIODev->RXBDWPtr);
+		return 0;
+	}
+
+	spdio_tx_bd_clean(SDIO, pSPDIODev, start, pSPDIODev->RXBDWPtr);
 
 	SDIO_RXBD_WPTR_Set(SDIO, pSPDIODev->RXBDWPtr);
 	SDIO_RxReq(SDIO);
 
-	return TRUE;
+	return idx;
+}
+
+/**
+ * @brief Spdio write function.
+ * @param obj Pointer to a initialized spdio_t structure.
+ * @param pbuf Pointer to a spdio_buf_t structure which carries the payload.
+ * @retval RTK_SUCCESS or RTK_FAIL.
+ */
+u8 SPDIO_DeviceTx(SDIO_TypeDef *SDIO, PSPDIO_ADAPTER pSPDIODev, struct spdio_buf_t *pbuf)
+{
+	return (SPDIO_DeviceTxBatch(SDIO, pSPDIODev, &pbuf, 1, 0) == 1) ? TRUE : FALSE;
 }
 
 /**
@@ -345,6 +467,203 @@ void SPDIO_TxBd_DataReady_DeviceRx(SDIO_TypeDef *SDIO, PSPDIO_ADAPTER pSPDIODev,
 	}
 }
 
+/**
+ * @brief Initialize a device RX buffer pool.
+ * @param pool Pointer to the pool, storage provided by the caller.
+ * @param ring Free list storage, ring_num entries.
+ * @param ring_num Free list size, power of 2 and larger than the number of spare buffers.
+ * @param spare Buffers not posted to a TX_BD, handed out as replacements.
+ * @param spare_num Number of spare buffers.
+ * @param bufsz Size of every buffer, the device_rx_bufsz of the adapter.
+ * @return None
+ * @note The TX_BDs keep the buffers given to SDIO_TxBdHdl_Init, the pool only holds the spares.
+ */
+void SPDIO_RxPool_Init(SPDIO_RX_POOL *pool, struct spdio_buf_t **ring, u16 ring_num, struct spdio_buf_t *spare, u16 spare_num, u16 bufsz)
+{
+	u16 i;
+
+	assert_param(ring_num != 0 && (ring_num & (ring_num - 1)) == 0);
+	assert_param(spare_num < ring_num);
+
+	_memset(pool, 0, sizeof(SPDIO_RX_POOL));
+	pool->Ring = ring;
+	pool->RingNum = ring_num;
+	pool->BufSize = bufsz;
+
+	for (i = 0; i < spare_num; i++) {
+		assert_param(spare[i].buf_addr % SPDIO_DMA_ALIGN_4 == 0);
+		DCache_CleanInvalidate(spare[i].buf_allocated, spare[i].size_allocated);
+		pool->Ring[i] = &spare[i];
+	}
+	pool->Head = spare_num;
+	pool->Stats.MinFree = spare_num;
+}
+
+/**
+ * @brief Return buffers delivered by SPDIO_TxBd_DataReady_DeviceRxPool to the pool.
+ * @param pool Pointer to the pool.
+ * @param buf Buffers to return.
+ * @param num Number of buffers.
+ * @retval TRUE if the RX path stalled for lack of buffers, call SPDIO_TxBd_DataReady_DeviceRxPool again.
+ * @note Single producer: call it from one task only. It does not lock against the RX path.
+ */
+u8 SPDIO_RxPool_Recycle(SPDIO_RX_POOL *pool, struct spdio_buf_t **buf, u16 num)
+{
+	u16 head = pool->Head;
+	u16 i;
+	u8 stalled;
+
+	for (i = 0; i < num; i++) {
+		assert_param((u16)(head - pool->Tail) < pool->RingNum);
+		assert_param(buf[i]->size_allocated >= pool->BufSize);
+		/* the buffer was touched by the consumer, drop its lines before the next DMA write */
+		DCache_CleanInvalidate(buf[i]->buf_allocated, buf[i]->size_allocated);
+		pool->Ring[head & (pool->RingNum - 1)] = buf[i];
+		head++;
+	}
+
+	__DMB();
+	pool->Head = head;
+	pool->Stats.Recycled += num;
+
+	stalled = pool->Stalled;
+	if (stalled && num) {
+		pool->Stalled = 0;
+		pool->Stats.StallMaxUs = MAX(pool->Stats.StallMaxUs, DTimestamp_Get() - pool->StallStart);
+	}
+
+	return stalled;
+}
+
+/**
+ * @brief Handle the SDIO FIFO data ready interrupt with zero-copy delivery.
+ * 		- Hand the buffer of each TX_BD to the consumer via callback, the consumer owns it until
+ * 		  it is returned by SPDIO_RxPool_Recycle
+ * 		- Post a spare buffer from the pool to the TX_BD
+ * @param pSPDIODev Pointer to a SDIO device data structure.
+ * @param pool Pointer to the pool of spare buffers.
+ * @return None
+ * @note The TX_BD read pointer is updated once for the whole burst. When the pool is empty the
+ * 		TX_BDs are left to the host, which backs off until buffers are recycled.
+ */
+void SPDIO_TxBd_DataReady_DeviceRxPool(SDIO_TypeDef *SDIO, PSPDIO_ADAPTER pSPDIODev, SPDIO_RX_POOL *pool,
+									   spdio_device_rx_done_cb_ptr spdio_device_rx_done_cb)
+{
+	SPDIO_TX_BD_HANDLE *pTxBdHdl;
+	SPDIO_TX_BD *pTXBD;
+	PINIC_TX_DESC pTxDesc;
+	struct spdio_buf_t *spare;
+	u16 TxBDWPtr = SDIO_TXBD_WPTR_Get(SDIO);
+	u16 start = pSPDIODev->TXBDRPtr;
+	u16 avail, num;
+	u8 *pdata;
+	u32 pkt_len;
+	u8 type;
+	s8 ret;
+
+	assert_param(IS_SDIO_DEVICE(SDIO));
+
+	if (unlikely(pSPDIODev->TxOverFlow != 0)) {
+		pSPDIODev->TxOverFlow = 0;
+		RTK_LOGS(TAG, RTK_LOG_ERROR, "SDIO TXBD Overflow Case: DMA_CTRL_REG=0x%x\n", SDIO_DMA_CTRL_Get(SDIO));
+		assert_param(FALSE);
+	}
+
+	while (pSPDIODev->TXBDRPtr != TxBDWPtr) {
+		pTxBdHdl = pSPDIODev->pTXBDHdl + pSPDIODev->TXBDRPtr;
+		pTXBD = pTxBdHdl->pTXBD;
+
+		avail = pool->Head - pool->Tail;
+		pool->Stats.MinFree = MIN(pool->Stats.MinFree, avail);
+		if (avail == 0) {
+			if (!pool->Stalled) {
+				pool->StallStart = DTimestamp_Get();
+				pool->Stalled = 1;
+			}
+			pool->Stats.Exhausted++;
+			pSPDIODev->WaitForDeviceRxbuf = TRUE;
+			break;
+		}
+		__DMB();
+		spare = pool->Ring[pool->Tail & (pool->RingNum - 1)];
+
+		if (SDIO_WIFI == SDIO) {
+			pTxDesc = (PINIC_TX_DESC)(pTXBD->Address);
+			DCache_Invalidate((u32)pTxDesc, sizeof(INIC_TX_DESC));
+			pkt_len = pTxDesc->txpktsize;
+			type = pTxDesc->type;
+			pdata = (u8 *)(pTXBD->Address + pTxDesc->offset);
+
+			if ((pTxDesc->txpktsize + pTxDesc->offset) > pSPDIODev->device_rx_bufsz) {
+				RTK_LOGS(TAG, RTK_LOG_ERROR, "Invalid TxDesc packet, Just drop it\n");
+				pool->Stats.Dropped++;
+				SDIO_INCR_RING_IDX(pSPDIODev->TXBDRPtr, pSPDIODev->host_tx_bd_num);
+				TxBDWPtr = SDIO_TXBD_WPTR_Get(SDIO);
+				continue;
+			}
+		} else {
+			pdata = (u8 *)(pTXBD->Address);
+			DCache_Invalidate((u32)pdata, sizeof(u16));
+			pkt_len = *((u16 *)pdata);
+			type = 0;
+
+			if (pkt_len > pSPDIODev->device_rx_bufsz) {
+				RTK_LOGS(TAG, RTK_LOG_ERROR, "SDIO TX packet size is over tx buf size\n");
+				pkt_len = pSPDIODev->device_rx_bufsz;
+			}
+		}
+		DCache_Invalidate((u32)pdata, pkt_len);
+
+		/* the consumer owns the buffer from here, it is not copied */
+		ret = spdio_device_rx_done_cb(pSPDIODev, pTxBdHdl->dev_rx_buf, pdata, pkt_len, type);
+		if (ret != RTK_SUCCESS) {
+			// may be is caused by TX queue is full, so we skip it and try again later
+			pSPDIODev->WaitForDeviceRxbuf = TRUE;
+			break;
+		}
+		pSPDIODev->WaitForDeviceRxbuf = FALSE;
+		pool->Tail++;
+		pool->Stats.Delivered++;
+
+		pTxBdHdl->dev_rx_buf = spare;
+		pTXBD->Address = spare->buf_addr;
+		SDIO_INCR_RING_IDX(pSPDIODev->TXBDRPtr, pSPDIODev->host_tx_bd_num);
+
+		TxBDWPtr = SDIO_TXBD_WPTR_Get(SDIO);
+	}
+
+	if (pSPDIODev->TXBDRPtr == start) {
+		return;
+	}
+
+	/* write back the re-posted TX_BDs, at most two spans of the ring */
+	while (start != pSPDIODev->TXBDRPtr) {
+		num = (pSPDIODev->TXBDRPtr > start) ? (pSPDIODev->TXBDRPtr - start) : (pSPDIODev->host_tx_bd_num - start);
+		DCache_Clean((u32)pSPDIODev->pTXBDHdl[start].pTXBD, num * sizeof(SPDIO_TX_BD));
+		start += num;
+		if (start >= pSPDIODev->host_tx_bd_num) {
+			start = 0;
+		}
+	}
+
+	SDIO_TXBD_RPTR_Set(SDIO, pSPDIODev->TXBDRPtr);
+}
+
+/**
+ * @brief Get the statistics of a device RX buffer pool.
+ * @param pool Pointer to the pool.
+ * @param Stats Pointer to the copy.
+ * @return None
+ */
+void SPDIO_RxPool_GetStats(SPDIO_RX_POOL *pool, SPDIO_RX_POOL_STATS *Stats)
+{
+	u32 PrevStatus = __get_PRIMASK();
+
+	__disable_irq();
+	_memcpy(Stats, &pool->Stats, sizeof(SPDIO_RX_POOL_STATS));
+	__set_PRIMASK(PrevStatus);
+}
+
 void SPDIO_Device_Init(SDIO_TypeDef *SDIO, PSPDIO_ADAPTER pSPDIODev)
 {
 	SDIO_InitTypeDef SDIO_InitStruct;
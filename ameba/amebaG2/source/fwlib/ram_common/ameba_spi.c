@@ -442,6 +442,92 @@ void SSI_SetBaudDiv(SPI_TypeDef *spi_dev, u32 ClockDivider)
 	SSI_Cmd(spi_dev, ENABLE);
 }
 
+static int ssi_clk_notify(void *Data, u32 Event, const CLK_RateChangeTypeDef *Change)
+{
+	SPI_ClkBindTypeDef *Bind = (SPI_ClkBindTypeDef *)Data;
+	SPI_TypeDef *spi_dev = Bind->spi_dev;
+	u32 SrcHz = Change->NewRate[Bind->ClkId];
+	u32 Div, Enable;
+
+	if (Event == CLK_EVT_PRE_CHANGE) {
+		if (CLK_DivTableLookup(Bind->Div, Bind->Num, SrcHz, &Div) != RTK_SUCCESS) {
+			RTK_LOGW(TAG, "No divider for %lu Hz\n", SrcHz);
+			return RTK_FAIL;
+		}
+		/* a frame would run on with the divider of the old clock */
+		if (SSI_Busy(spi_dev)) {
+			return RTK_FAIL;
+		}
+		return RTK_SUCCESS;
+	}
+
+	if (Event != CLK_EVT_POST_CHANGE) {
+		return RTK_SUCCESS;
+	}
+
+	CLK_DivTableLookup(Bind->Div, Bind->Num, SrcHz, &Div);
+
+	Enable = spi_dev->SPI_SSIENR & SPI_BIT_SSI_EN;
+	SSI_Cmd(spi_dev, DISABLE);
+	spi_dev->SPI_BAUDR = (Div & SPI_MASK_SCKDV);
+	if (Enable) {
+		SSI_Cmd(spi_dev, ENABLE);
+	}
+
+	return RTK_SUCCESS;
+}
+
+/**
+  * @brief  Keep the sclk_out rate of a SPI master across clock tree rate changes.
+  * @param  Bind: storage provided by the driver, owned by the clock tree until SSI_ClkUnbind().
+  * @param  spi_dev: where spi_dev can be SPI0_DEV or SPI1_DEV.
+  * @param  BaudRate: sclk_out rate in Hz, the divider of each rate is rounded up so it is never exceeded.
+  * @param  ClkId: clock tree node ssi_clk is taken from, @ref CLK_Tree_Node.
+  * @param  SrcHz: every rate of this node the application may switch to.
+  * @param  Num: number of rates, 1 ~ SPI_CLK_RATE_MAX.
+  * @retval RTK_SUCCESS or RTK_ERR_BADARG.
+  * @note   Valid only when the device is configured as a master. A change to a rate out of
+  *         the table, or while the SPI is busy, is vetoed.
+  */
+int SSI_ClkBind(SPI_ClkBindTypeDef *Bind, SPI_TypeDef *spi_dev, u32 BaudRate, u32 ClkId, const u32 *SrcHz, u32 Num)
+{
+	u32 i, Div;
+
+	if (Num == 0 || Num > SPI_CLK_RATE_MAX || ClkId >= CLK_ID_NUM || BaudRate == 0) {
+		return RTK_ERR_BADARG;
+	}
+
+	_memset((void *)Bind, 0, sizeof(SPI_ClkBindTypeDef));
+	Bind->spi_dev = spi_dev;
+	Bind->ClkId = ClkId;
+	Bind->Num = Num;
+
+	for (i = 0; i < Num; i++) {
+		/* SCKDV is even, 2 ~ 65534 */
+		Div = (SrcHz[i] + BaudRate - 1) / BaudRate;
+		Div = (Div + 1) & ~1U;
+		Bind->Div[i].SrcHz = SrcHz[i];
+		Bind->Div[i].Val = MIN(MAX(Div, 2), 65534);
+	}
+
+	Bind->Notifier.Cb = ssi_clk_notify;
+	Bind->Notifier.Data = Bind;
+	Bind->Notifier.ClkMask = BIT(ClkId);
+	CLK_NotifierRegister(&Bind->Notifier);
+
+	return RTK_SUCCESS;
+}
+
+/**
+  * @brief  Stop following the clock tree rate changes.
+  * @param  Bind: binding set up by SSI_ClkBind().
+  * @retval None
+  */
+void SSI_ClkUnbind(SPI_ClkBindTypeDef *Bind)
+{
+	CLK_NotifierUnregister(&Bind->Notifier);
+}
+
 
 
 /**
@@ -496,6 +496,25 @@ float TM_GetFdegree(u32 Data)
 	return Fdegree;
 }
 
+/**
+  * @brief  Get the current temperature in whole Celsius degrees, without float.
+  * @param  Cdegree: current temperature, rounded down to a whole degree.
+  * @retval TRUE, or FALSE if the thermal meter has no valid result.
+  */
+bool TM_GetCdegreeInt(s32 *Cdegree)
+{
+	u32 data = TM_GetTempResult();
+
+	if (data == TM_INVALID_VALUE) {
+		return FALSE;
+	}
+
+	/* TM_RESULT is 19 bits two's complement with 10 fraction bits */
+	*Cdegree = (s32)(data << 13) >> 23;
+
+	return TRUE;
+}
+
 /** @} */
 
 /** @} */
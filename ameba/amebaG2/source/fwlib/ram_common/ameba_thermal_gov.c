@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ameba_soc.h"
+
+static const char *const TAG = "TMGOV";
+
+/** @addtogroup Ameba_Periph_Driver
+  * @{
+  */
+
+/** @defgroup TM_GOV
+  * @brief TM_GOV driver modules
+  * @{
+  */
+
+static u8 tm_gov_target(TM_GOV_TypeDef *gov, s32 Temp)
+{
+	const TM_GOV_LevelDef *table = gov->Cfg.TM_GovTable;
+	u32 level = gov->Target;
+
+	while (level + 1 < gov->Cfg.TM_GovLevelNum && Temp >= table[level + 1].TempEnter) {
+		level++;
+	}
+
+	while (level > 0 && Temp <= table[level].TempEnter - (s32)gov->Cfg.TM_GovHyst) {
+		level--;
+	}
+
+	return (u8)level;
+}
+
+/* Bracket the level with the warning thresholds, only a move out of the window interrupts. */
+static void tm_gov_window(TM_GOV_TypeDef *gov, u32 Level)
+{
+	const TM_GOV_LevelDef *table = gov->Cfg.TM_GovTable;
+
+	if (Level + 1 < gov->Cfg.TM_GovLevelNum) {
+		TM_HighWtConfig(table[Level + 1].TempEnter, ENABLE);
+	} else {
+		TM_HighWtConfig(0, DISABLE);
+	}
+
+	if (Level > 0) {
+		TM_LowWtConfig(table[Level].TempEnter - gov->Cfg.TM_GovHyst, ENABLE);
+	} else {
+		TM_LowWtConfig(0, DISABLE);
+	}
+}
+
+/* The dividers change through the clock tree, drivers follow by their CLK notifiers. */
+static int tm_gov_apply(TM_GOV_TypeDef *gov, u8 Level)
+{
+	const TM_GOV_LevelDef *lv = &gov->Cfg.TM_GovTable[Level];
+	u32 start, now;
+	u8 old = gov->Level;
+	int ret;
+
+	start = DTimestamp_Get();
+	ret = CLK_DivSetNotify((gov->CpuSysPll ? IS_SYS_PLL : IS_USB_PLL) | lv->CpuDiv,
+						   (gov->HperiSysPll ? IS_SYS_PLL : IS_USB_PLL) | lv->HperiDiv);
+	if (ret != RTK_SUCCESS) {
+		gov->Stats.Vetoes++;
+		RTK_LOGW(TAG, "L%d -> L%d vetoed\n", old, Level);
+		return ret;
+	}
+
+	now = DTimestamp_Get();
+	gov->Stats.ChangeMaxUs = MAX(gov->Stats.ChangeMaxUs, now - start);
+	gov->Stats.LevelTimeUs[gov->Level] += now - gov->LevelStart;
+	gov->LevelStart = now;
+
+	if (Level > gov->Level) {
+		gov->Stats.Throttles++;
+	} else {
+		gov->Stats.Restores++;
+	}
+	gov->Level = Level;
+
+	RTK_LOGI(TAG, "L%d -> L%d at %dC, CPU %lu Hz, HPERI %lu Hz\n", old, Level, gov->TargetTemp,
+			 CLK_RateGet(CLK_ID_CPU), CLK_RateGet(CLK_ID_HPERI));
+
+	return RTK_SUCCESS;
+}
+
+/**
+  * @brief  Fill each TM_GovInitStruct member with its default value.
+  * @param  TM_GovInitStruct: pointer to a TM_GOV_InitTypeDef structure which will be initialized.
+  * @retval None
+  */
+void TM_GOV_StructInit(TM_GOV_InitTypeDef *TM_GovInitStruct)
+{
+	_memset((void *)TM_GovInitStruct, 0, sizeof(TM_GOV_InitTypeDef));
+
+	TM_GovInitStruct->TM_GovHyst = TM_GOV_HYST_DEF;
+}
+
+/**
+  * @brief  Initialize the governor, program the thermal window and enable the warning interrupts.
+  * @param  gov: governor instance.
+  * @param  TM_GovInitStruct: pointer to a TM_GOV_InitTypeDef structure with the level table.
+  * @retval RTK_SUCCESS, RTK_ERR_BADARG for an invalid table, or RTK_FAIL if the CPU runs on XTAL
+  *         or the first level change was vetoed.
+  * @note   The clocks at init are taken as level 0. If the chip is already hotter than
+  *         level 1, the matching level is applied before return.
+  */
+int TM_GOV_Init(TM_GOV_TypeDef *gov, TM_GOV_InitTypeDef *TM_GovInitStruct)
+{
+	const TM_GOV_LevelDef *table = TM_GovInitStruct->TM_GovTable;
+	u32 i;
+	s32 temp;
+
+	if (table == NULL || TM_GovInitStruct->TM_GovLevelNum < 2 || TM_GovInitStruct->TM_GovLevelNum > TM_GOV_LEVEL_MAX) {
+		return RTK_ERR_BADARG;
+	}
+
+	for (i = 0; i < TM_GovInitStruct->TM_GovLevelNum; i++) {
+		if (table[i].CpuDiv == 0 || table[i].CpuDiv > 16 || table[i].HperiDiv == 0 || table[i].HperiDiv > 16) {
+			return RTK_ERR_BADARG;
+		}
+		/* warning thresholds only support positive temperatures */
+		if (i > 0 && (table[i].TempEnter - (s32)TM_GovInitStruct->TM_GovHyst <= 0 ||
+					  (i > 1 && table[i].TempEnter <= table[i - 1].TempEnter))) {
+			return RTK_ERR_BADARG;
+		}
+	}
+
+	if (RCC_PeriphClockSourceGet(HP) == CKSL_HP_XTAL) {
+		RTK_LOGE(TAG, "CPU on XTAL, nothing to scale\n");
+		return RTK_FAIL;
+	}
+
+	_memset((void *)gov, 0, sizeof(TM_GOV_TypeDef));
+	gov->Cfg = *TM_GovInitStruct;
+	gov->CpuSysPll = (RRAM_DEV->clk_info_bk.CPU_CKD & IS_SYS_PLL) ? 1 : 0;
+	gov->HperiSysPll = (RRAM_DEV->clk_info_bk.hperi_ckd & IS_SYS_PLL) ? 1 : 0;
+	gov->LevelStart = DTimestamp_Get();
+
+	if (TM_GetCdegreeInt(&temp)) {
+		gov->Stats.TempLast = temp;
+		gov->Stats.TempMax = temp;
+		gov->TargetTemp = temp;
+		gov->Target = tm_gov_target(gov, temp);
+	}
+
+	tm_gov_window(gov, gov->Target);
+	TM_INTClearPendingBits(TM_BIT_ISR_TM_LOW_WT | TM_BIT_ISR_TM_HIGH_WT);
+	TM_INTConfig(TM_BIT_IMR_TM_LOW_WT | TM_BIT_IMR_TM_HIGH_WT, ENABLE);
+
+	return TM_GOV_Process(gov);
+}
+
+/**
+  * @brief  Handle the thermal warning interrupts.
+  * @param  gov: governor instance.
+  * @retval TRUE if a level change is pending for TM_GOV_Process().
+  * @note   The window is moved here so the warning does not fire again while the
+  *         clock change waits for the task.
+  */
+bool TM_GOV_IRQHandler(TM_GOV_TypeDef *gov)
+{
+	u32 isr = TM_GetISR() & (TM_BIT_ISR_TM_LOW_WT | TM_BIT_ISR_TM_HIGH_WT);
+	s32 temp;
+	u8 target;
+
+	if (isr == 0) {
+		return FALSE;
+	}
+
+	TM_INTClearPendingBits(isr);
+	gov->Stats.Irqs++;
+
+	if (!TM_GetCdegreeInt(&temp)) {
+		return FALSE;
+	}
+
+	gov->Stats.TempLast = temp;
+	gov->Stats.TempMax = MAX(gov->Stats.TempMax, temp);
+
+	target = tm_gov_target(gov, temp);
+	if (target != gov->Target) {
+		gov->Target = target;
+		gov->TargetTemp = temp;
+		tm_gov_window(gov, target);
+	}
+
+	if (gov->Target == gov->Level) {
+		return FALSE;
+	}
+
+	if (gov->Cfg.TM_GovPendingCb) {
+		gov->Cfg.TM_GovPendingCb(gov->Cfg.TM_GovCbData);
+	}
+
+	return TRUE;
+}
+
+/**
+  * @brief  Apply the level requested by the thermal window.
+  * @param  gov: governor instance.
+  * @retval RTK_SUCCESS, or RTK_FAIL if a clock notifier vetoed the change, call it again later.
+  * @note   Runs the clock notifiers, call it from task context.
+  */
+int TM_GOV_Process(TM_GOV_TypeDef *gov)
+{
+	u8 target = gov->Target;
+
+	if (target != gov->Level) {
+		return tm_gov_apply(gov, target);
+	}
+
+	return RTK_SUCCESS;
+}
+
+/**
+  * @brief  Get the level the clocks run at.
+  * @param  gov: governor instance.
+  * @retval Level index, 0 is the nominal clock.
+  */
+u32 TM_GOV_GetLevel(TM_GOV_TypeDef *gov)
+{
+	return gov->Level;
+}
+
+/**
+  * @brief  Get a snapshot of the throttling statistics.
+  * @param  gov: governor instance.
+  * @param  Stats: pointer to the structure that receives the statistics.
+  * @retval None
+  */
+void TM_GOV_GetStats(TM_GOV_TypeDef *gov, TM_GOV_StatsTypeDef *Stats)
+{
+	u32 PrevStatus = __get_PRIMASK();
+
+	__disable_irq();
+	*Stats = gov->Stats;
+	__set_PRIMASK(PrevStatus);
+}
+
+/** @} */
+
+/** @} */
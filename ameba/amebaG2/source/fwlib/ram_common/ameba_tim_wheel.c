@@ -0,0 +1,480 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ameba_soc.h"
+
+static const char *const TAG = "TIMWHEEL";
+
+/** @addtogroup Ameba_Periph_Driver
+  * @{
+  */
+
+/** @defgroup RTIM_WHEEL
+  * @brief RTIM_WHEEL driver modules
+  * @{
+  */
+
+#define RTIM_WHEEL_LVL_MASK			(RTIM_WHEEL_LVL_SLOTS - 1)
+#define RTIM_WHEEL_LVL_SHIFT(lvl)	((lvl) * RTIM_WHEEL_LVL_BITS)
+
+static u32 rtim_wheel_tick_hz(u32 idx)
+{
+	u32 src = 0;
+
+	switch (idx) {
+	case 0:
+		src = RCC_PeriphClockSourceGet(LTIM0);
+		break;
+	case 1:
+		src = RCC_PeriphClockSourceGet(LTIM1);
+		break;
+	case 2:
+		src = RCC_PeriphClockSourceGet(LTIM2);
+		break;
+	case 3:
+		src = RCC_PeriphClockSourceGet(LTIM3);
+		break;
+	}
+
+	return src ? 1000000 : 32768;
+}
+
+static u32 rtim_wheel_time(RTIM_WHEEL_TypeDef *wheel)
+{
+	u32 cnt = RTIM_GetCount(wheel->TIMx);
+
+	/* reload not accounted yet, the count read may be from either side of it */
+	if (RTIM_GetINTStatus(wheel->TIMx, TIM_IT_Update)) {
+		return wheel->Base + wheel->Arr + 1 + RTIM_GetCount(wheel->TIMx);
+	}
+
+	return wheel->Base + cnt;
+}
+
+/* first set bit of Map at or after slot From, as a distance in slots */
+static u32 rtim_wheel_scan(u32 Map, u32 From)
+{
+	if (From) {
+		Map = (Map >> From) | (Map << (RTIM_WHEEL_LVL_SLOTS - From));
+	}
+
+	return __CLZ(__RBIT(Map));
+}
+
+static void rtim_wheel_link(RTIM_WHEEL_TypeDef *wheel, RTIM_WHEEL_TimerTypeDef *t)
+{
+	s32 delta = (s32)(t->Expire - wheel->Now);
+	u32 expire = t->Expire;
+	u32 lvl, slot;
+
+	if (delta < 0) {
+		expire = wheel->Now;
+		delta = 0;
+	} else if ((u32)delta >= RTIM_WHEEL_RANGE) {
+		expire = wheel->Now + RTIM_WHEEL_RANGE - 1;
+		delta = RTIM_WHEEL_RANGE - 1;
+	}
+
+	/* level L holds distances 32^L ~ 32^(L+1) - 1 */
+	lvl = (31 - __CLZ((u32)delta | 1)) / RTIM_WHEEL_LVL_BITS;
+	slot = (expire >> RTIM_WHEEL_LVL_SHIFT(lvl)) & RTIM_WHEEL_LVL_MASK;
+
+	t->Next = wheel->Slot[lvl][slot];
+	if (t->Next) {
+		t->Next->Pprev = &t->Next;
+	}
+	t->Pprev = &wheel->Slot[lvl][slot];
+	wheel->Slot[lvl][slot] = t;
+	wheel->Map[lvl] |= BIT(slot);
+	t->Level = lvl;
+	t->Slot = slot;
+}
+
+static void rtim_wheel_unlink(RTIM_WHEEL_TypeDef *wheel, RTIM_WHEEL_TimerTypeDef *t)
+{
+	*t->Pprev = t->Next;
+	if (t->Next) {
+		t->Next->Pprev = t->Pprev;
+	}
+
+	if (t->Level < RTIM_WHEEL_LVL_NUM && wheel->Slot[t->Level][t->Slot] == NULL) {
+		wheel->Map[t->Level] &= ~BIT(t->Slot);
+	}
+
+	t->Level = RTIM_WHEEL_IDLE;
+}
+
+/* move a slot list out of the wheel, the timers on it stay cancellable */
+static RTIM_WHEEL_TimerTypeDef *rtim_wheel_detach(RTIM_WHEEL_TypeDef *wheel, u32 lvl, u32 slot)
+{
+	RTIM_WHEEL_TimerTypeDef *head = wheel->Slot[lvl][slot];
+	RTIM_WHEEL_TimerTypeDef *t;
+
+	wheel->Slot[lvl][slot] = NULL;
+	wheel->Map[lvl] &= ~BIT(slot);
+
+	for (t = head; t != NULL; t = t->Next) {
+		t->Level = RTIM_WHEEL_FIRING;
+	}
+
+	return head;
+}
+
+/* next tick with something to do: an expiry on level 0, or a slot to cascade above */
+static bool rtim_wheel_next(RTIM_WHEEL_TypeDef *wheel, u32 *Tick)
+{
+	u32 now = wheel->Now;
+	u32 lvl, unit, from, tick;
+	bool found = FALSE;
+
+	for (lvl = 0; lvl < RTIM_WHEEL_LVL_NUM; lvl++) {
+		if (wheel->Map[lvl] == 0) {
+			continue;
+		}
+
+		unit = 1UL << RTIM_WHEEL_LVL_SHIFT(lvl);
+		from = (now + unit - 1) & ~(unit - 1);
+		tick = from + rtim_wheel_scan(wheel->Map[lvl], (from >> RTIM_WHEEL_LVL_SHIFT(lvl)) & RTIM_WHEEL_LVL_MASK) * unit;
+
+		if (!found || (s32)(tick - *Tick) < 0) {
+			*Tick = tick;
+			found = TRUE;
+		}
+	}
+
+	return found;
+}
+
+/* set the update event to Deadline, not closer than RTIM_WHEEL_MARGIN, interrupts off */
+static void rtim_wheel_program(RTIM_WHEEL_TypeDef *wheel, u32 Deadline)
+{
+	RTIM_TypeDef *TIMx = wheel->TIMx;
+	u32 cnt, arr;
+	s32 d;
+
+	/* the handler reprograms after accounting the reload */
+	if (RTIM_GetINTStatus(TIMx, TIM_IT_Update)) {
+		return;
+	}
+
+	while (1) {
+		cnt = RTIM_GetCount(TIMx);
+		d = (s32)(Deadline - (wheel->Base + cnt));
+		d = MAX(d, RTIM_WHEEL_MARGIN);
+		d = MIN(d, (s32)RTIM_WHEEL_SLEEP_MAX);
+		arr = cnt + d - 1;
+
+		RTIM_ChangePeriod(TIMx, arr);
+
+		/* new arr is RTIM_WHEEL_MARGIN ahead, so this is the old period reloading before the write */
+		if (RTIM_GetINTStatus(TIMx, TIM_IT_Update)) {
+			RTIM_INTClearPendingBit(TIMx, TIM_IT_Update);
+			wheel->Base += wheel->Arr + 1;
+			continue;
+		}
+
+		/* the counter runs on, past arr it would wrap at 2^32 instead of reloading */
+		if (RTIM_GetCount(TIMx) < arr) {
+			break;
+		}
+	}
+
+	wheel->Arr = arr;
+	wheel->Next = wheel->Base + arr + 1;
+}
+
+/* process the ticks up to Target, interrupts off except around the callbacks */
+static void rtim_wheel_run(RTIM_WHEEL_TypeDef *wheel, u32 Target)
+{
+	RTIM_WHEEL_TimerTypeDef *list, *t;
+	u32 tick, lvl, slot, late;
+
+	while (rtim_wheel_next(wheel, &tick) && (s32)(tick - Target) <= 0) {
+		wheel->Now = tick;
+
+		for (lvl = 1; lvl < RTIM_WHEEL_LVL_NUM; lvl++) {
+			if (tick & ((1UL << RTIM_WHEEL_LVL_SHIFT(lvl)) - 1)) {
+				break;
+			}
+			slot = (tick >> RTIM_WHEEL_LVL_SHIFT(lvl)) & RTIM_WHEEL_LVL_MASK;
+			if ((wheel->Map[lvl] & BIT(slot)) == 0) {
+				continue;
+			}
+
+			list = rtim_wheel_detach(wheel, lvl, slot);
+			while ((t = list) != NULL) {
+				list = t->Next;
+				rtim_wheel_link(wheel, t);
+				wheel->Stats.Cascades++;
+			}
+		}
+
+		list = rtim_wheel_detach(wheel, 0, tick & RTIM_WHEEL_LVL_MASK);
+		if (list) {
+			list->Pprev = &list;
+		}
+
+		/* timers started by the callbacks with no delay go to the next tick */
+		wheel->Now = tick + 1;
+
+		while ((t = list) != NULL) {
+			rtim_wheel_unlink(wheel, t);
+
+			late = Target - t->Expire;
+			wheel->LateSum += late;
+			wheel->LateMax = MAX(wheel->LateMax, late);
+			if (late > wheel->LateTol) {
+				wheel->Stats.Late++;
+			}
+			wheel->Stats.Fired++;
+
+			if (t->Period) {
+				t->Expire += t->Period;
+				rtim_wheel_link(wheel, t);
+			} else {
+				wheel->Stats.Active--;
+			}
+
+			__enable_irq();
+			t->Cb(t->Data);
+			__disable_irq();
+		}
+	}
+
+	wheel->Now = Target + 1;
+}
+
+/**
+  * @brief  Fill each RTIM_WHEEL_InitTypeDef member with its default value.
+  * @param  RTIM_WheelInitStruct: pointer to a RTIM_WHEEL_InitTypeDef structure.
+  * @retval None
+  */
+void RTIM_WHEEL_StructInit(RTIM_WHEEL_InitTypeDef *RTIM_WheelInitStruct)
+{
+	RTIM_WheelInitStruct->RTIM_WheelTimIdx = 0;
+	RTIM_WheelInitStruct->RTIM_WheelLateTolUs = 100;
+}
+
+/**
+  * @brief  Initialize the wheel and start its timer.
+  * @param  wheel: wheel instance.
+  * @param  RTIM_WheelInitStruct: pointer to a RTIM_WHEEL_InitTypeDef structure.
+  * @retval RTK_SUCCESS or RTK_ERR_BADARG.
+  * @note   The timer clock source shall be selected before, the tick rate is taken from it.
+  */
+int RTIM_WHEEL_Init(RTIM_WHEEL_TypeDef *wheel, RTIM_WHEEL_InitTypeDef *RTIM_WheelInitStruct)
+{
+	RTIM_TimeBaseInitTypeDef TIM_InitStruct;
+	u32 idx = RTIM_WheelInitStruct->RTIM_WheelTimIdx;
+
+	if (idx > 3) {
+		RTK_LOGE(TAG, "TIM%lu is not a basic timer\n", idx);
+		return RTK_ERR_BADARG;
+	}
+
+	_memset((void *)wheel, 0, sizeof(RTIM_WHEEL_TypeDef));
+	wheel->Cfg = *RTIM_WheelInitStruct;
+	wheel->TIMx = TIMx[idx];
+	wheel->TickHz = rtim_wheel_tick_hz(idx);
+	wheel->LateTol = RTIM_WHEEL_UsToTicks(wheel, wheel->Cfg.RTIM_WheelLateTolUs);
+	wheel->Arr = RTIM_WHEEL_SLEEP_MAX - 1;
+	wheel->Next = RTIM_WHEEL_SLEEP_MAX;
+
+	/* no ARR preload: the period is moved while counting, and only overflows reload */
+	RTIM_TimeBaseStructInit(&TIM_InitStruct);
+	TIM_InitStruct.TIM_Idx = idx;
+	TIM_InitStruct.TIM_Period = wheel->Arr;
+	TIM_InitStruct.TIM_UpdateSource = TIM_UpdateSource_Overflow;
+	TIM_InitStruct.TIM_ARRProtection = DISABLE;
+	RTIM_TimeBaseInit(wheel->TIMx, &TIM_InitStruct, TIMx_irq[idx], (IRQ_FUN)NULL, (u32)NULL);
+
+	RTIM_INTClear(wheel->TIMx);
+	RTIM_INTConfig(wheel->TIMx, TIM_IT_Update, ENABLE);
+	RTIM_Cmd(wheel->TIMx, ENABLE);
+
+	return RTK_SUCCESS;
+}
+
+/**
+  * @brief  Stop the wheel timer.
+  * @param  wheel: wheel instance.
+  * @retval None
+  * @note   Armed timers are dropped without being called.
+  */
+void RTIM_WHEEL_DeInit(RTIM_WHEEL_TypeDef *wheel)
+{
+	RTIM_INTConfig(wheel->TIMx, TIM_IT_Update, DISABLE);
+	RTIM_Cmd(wheel->TIMx, DISABLE);
+	RTIM_INTClear(wheel->TIMx);
+}
+
+/**
+  * @brief  Get the current wheel time.
+  * @param  wheel: wheel instance.
+  * @retval Time in ticks, wraps at 2^32.
+  */
+u32 RTIM_WHEEL_GetTime(RTIM_WHEEL_TypeDef *wheel)
+{
+	u32 PrevStatus = __get_PRIMASK();
+	u32 now;
+
+	__disable_irq();
+	now = rtim_wheel_time(wheel);
+	__set_PRIMASK(PrevStatus);
+
+	return now;
+}
+
+/**
+  * @brief  Convert microseconds to wheel ticks, rounded up.
+  * @param  wheel: wheel instance.
+  * @param  Us: time in microseconds.
+  * @retval Ticks.
+  */
+u32 RTIM_WHEEL_UsToTicks(RTIM_WHEEL_TypeDef *wheel, u32 Us)
+{
+	return (u32)(((u64)Us * wheel->TickHz + 999999) / 1000000);
+}
+
+/**
+  * @brief  Set a timer up, once before its first start.
+  * @param  Timer: timer, owned by the caller.
+  * @param  Cb: expiry callback, called from the timer interrupt.
+  * @param  Data: callback argument.
+  * @retval None
+  */
+void RTIM_WHEEL_TimerInit(RTIM_WHEEL_TimerTypeDef *Timer, void (*Cb)(void *Data), void *Data)
+{
+	_memset((void *)Timer, 0, sizeof(RTIM_WHEEL_TimerTypeDef));
+	Timer->Cb = Cb;
+	Timer->Data = Data;
+	Timer->Level = RTIM_WHEEL_IDLE;
+}
+
+/**
+  * @brief  Arm a timer, re-arming it if already active.
+  * @param  wheel: wheel instance.
+  * @param  Timer: timer set up by RTIM_WHEEL_TimerInit().
+  * @param  Delay: ticks from now to the first expiry, 0 for the next tick.
+  * @param  Period: ticks between expiries, 0 for one-shot.
+  * @retval RTK_SUCCESS, or RTK_ERR_BADARG if Delay or Period exceeds RTIM_WHEEL_DELAY_MAX.
+  * @note   Periodic expiries are Period apart from the first one whatever the lateness.
+  */
+int RTIM_WHEEL_Start(RTIM_WHEEL_TypeDef *wheel, RTIM_WHEEL_TimerTypeDef *Timer, u32 Delay, u32 Period)
+{
+	u32 PrevStatus;
+
+	if (Delay > RTIM_WHEEL_DELAY_MAX || Period > RTIM_WHEEL_DELAY_MAX) {
+		return RTK_ERR_BADARG;
+	}
+
+	PrevStatus = __get_PRIMASK();
+	__disable_irq();
+
+	if (Timer->Level == RTIM_WHEEL_IDLE) {
+		wheel->Stats.Active++;
+	} else {
+		rtim_wheel_unlink(wheel, Timer);
+	}
+
+	Timer->Expire = rtim_wheel_time(wheel) + Delay;
+	Timer->Period = Period;
+	rtim_wheel_link(wheel, Timer);
+
+	if (!wheel->InIrq && (s32)(Timer->Expire - wheel->Next) < 0) {
+		rtim_wheel_program(wheel, Timer->Expire);
+	}
+
+	__set_PRIMASK(PrevStatus);
+
+	return RTK_SUCCESS;
+}
+
+/**
+  * @brief  Cancel a timer.
+  * @param  wheel: wheel instance.
+  * @param  Timer: timer, may be inactive.
+  * @retval None
+  * @note   The update event stays where it is, an early wake-up finds nothing to do.
+  */
+void RTIM_WHEEL_Stop(RTIM_WHEEL_TypeDef *wheel, RTIM_WHEEL_TimerTypeDef *Timer)
+{
+	u32 PrevStatus = __get_PRIMASK();
+
+	__disable_irq();
+	if (Timer->Level != RTIM_WHEEL_IDLE) {
+		rtim_wheel_unlink(wheel, Timer);
+		wheel->Stats.Active--;
+	}
+	__set_PRIMASK(PrevStatus);
+}
+
+/**
+  * @brief  Check whether a timer is armed.
+  * @param  Timer: timer.
+  * @retval TRUE if armed.
+  */
+bool RTIM_WHEEL_IsActive(RTIM_WHEEL_TimerTypeDef *Timer)
+{
+	return Timer->Level != RTIM_WHEEL_IDLE;
+}
+
+/**
+  * @brief  Expire the due timers and move the update event to the next tick to process.
+  * @param  wheel: wheel instance.
+  * @retval None
+  * @note   Called from the timer interrupt handler.
+  */
+void RTIM_WHEEL_IRQHandler(RTIM_WHEEL_TypeDef *wheel)
+{
+	u32 PrevStatus = __get_PRIMASK();
+	u32 tick;
+
+	__disable_irq();
+
+	if (RTIM_GetINTStatus(wheel->TIMx, TIM_IT_Update)) {
+		RTIM_INTClearPendingBit(wheel->TIMx, TIM_IT_Update);
+		wheel->Base += wheel->Arr + 1;
+		wheel->Stats.Irqs++;
+	}
+
+	wheel->InIrq = TRUE;
+	rtim_wheel_run(wheel, rtim_wheel_time(wheel));
+	wheel->InIrq = FALSE;
+
+	if (!rtim_wheel_next(wheel, &tick)) {
+		tick = wheel->Now + RTIM_WHEEL_SLEEP_MAX;
+	}
+	rtim_wheel_program(wheel, tick);
+
+	__set_PRIMASK(PrevStatus);
+}
+
+/**
+  * @brief  Get a snapshot of the wheel statistics.
+  * @param  wheel: wheel instance.
+  * @param  Stats: pointer to the statistics copy.
+  * @retval None
+  */
+void RTIM_WHEEL_GetStats(RTIM_WHEEL_TypeDef *wheel, RTIM_WHEEL_StatsTypeDef *Stats)
+{
+	u32 PrevStatus = __get_PRIMASK();
+	u64 sum;
+	u32 max;
+
+	__disable_irq();
+	*Stats = wheel->Stats;
+	sum = wheel->LateSum;
+	max = wheel->LateMax;
+	__set_PRIMASK(PrevStatus);
+
+	Stats->LateMaxUs = (u32)((u64)max * 1000000 / wheel->TickHz);
+	Stats->LateAvgUs = Stats->Fired ? (u32)(sum * 1000000 / wheel->TickHz / Stats->Fired) : 0;
+}
+
+/** @} */
+
+/** @} */
@@ -0,0 +1,297 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ameba_soc.h"
+
+static const char *const TAG = "UVCSTREAM";
+
+/** @addtogroup Ameba_Periph_Driver
+  * @{
+  */
+
+/** @defgroup UVC_STREAM
+  * @brief UVC_STREAM driver modules
+  * @{
+  */
+
+/* Events of one channel in UVC_INTR, CH1 is CH0 shifted by 8. Shifted down by the slot number,
+ * the events of a slot line up with the CH0 BUF0 bits */
+#define UVC_STREAM_CH_EVT			((u32)0x3F)
+#define UVC_STREAM_SLOT_EVT			(UVC_BIT_CH0_BUF0_FRM_DONE | UVC_BIT_CH0_BUF0_FRM_OVERSIZE | UVC_BIT_CH0_BUF0_HEADER_ERR)
+
+#define UVC_STREAM_RING(idx)		((idx) & (UVC_STREAM_BUF_MAX - 1))
+
+static void uvc_stream_arm(UVC_STREAM_TypeDef *stream, u32 slot, u8 *buf)
+{
+	stream->Armed[slot] = buf;
+	UVC_SetBufferAddr(stream->Cfg.UVC_StreamChn, slot, (u32)buf, (u32)buf + stream->Cfg.UVC_StreamBufSize - 1);
+}
+
+static void uvc_stream_timing(UVC_STREAM_TypeDef *stream, u32 now)
+{
+	UVC_STREAM_StatsTypeDef *st = &stream->Stats;
+	u32 delta, us;
+	s32 dev;
+
+	delta = now - stream->LastTime;
+	stream->LastTime = now;
+
+	if (!stream->Timed) {
+		stream->Timed = TRUE;
+		return;
+	}
+
+	if (stream->Cfg.UVC_StreamPtsHz) {
+		us = (u32)((u64)delta * 1000000 / stream->Cfg.UVC_StreamPtsHz);
+	} else {
+		us = delta;
+	}
+
+	if (st->IntervalMinUs == 0 || us < st->IntervalMinUs) {
+		st->IntervalMinUs = us;
+	}
+	st->IntervalMaxUs = MAX(st->IntervalMaxUs, us);
+
+	/* 1/8 weight moving averages of the interval and of its absolute deviation */
+	if (stream->IntervalQ4 == 0) {
+		stream->IntervalQ4 = (s32)(us << 4);
+	} else {
+		dev = (s32)(us << 4) - stream->IntervalQ4;
+		stream->IntervalQ4 += dev / 8;
+		if (dev < 0) {
+			dev = -dev;
+		}
+		stream->JitterQ4 += (dev - stream->JitterQ4) / 8;
+	}
+
+	st->IntervalUs = (u32)stream->IntervalQ4 >> 4;
+	st->JitterUs = (u32)stream->JitterQ4 >> 4;
+}
+
+/**
+  * @brief  Fill each UVC_STREAM_InitTypeDef member with its default value.
+  * @param  UVC_StreamInitStruct: pointer to an UVC_STREAM_InitTypeDef structure.
+  * @retval None
+  */
+void UVC_STREAM_StructInit(UVC_STREAM_InitTypeDef *UVC_StreamInitStruct)
+{
+	_memset((void *)UVC_StreamInitStruct, 0, sizeof(UVC_STREAM_InitTypeDef));
+}
+
+/**
+  * @brief  Initialize a stream, arm both slots of the channel and unmask its interrupts.
+  * @param  stream: stream instance.
+  * @param  UVC_StreamInitStruct: pointer to an UVC_STREAM_InitTypeDef structure.
+  * @retval RTK_SUCCESS or RTK_ERR_BADARG.
+  * @note   The channel shall be set up by UVC_ChnlInit() before, the buffer addresses given
+  *         there are replaced. Pending events of the channel are discarded.
+  */
+int UVC_STREAM_Init(UVC_STREAM_TypeDef *stream, UVC_STREAM_InitTypeDef *UVC_StreamInitStruct)
+{
+	u32 chn = UVC_StreamInitStruct->UVC_StreamChn;
+	u32 num = UVC_StreamInitStruct->UVC_StreamBufNum;
+	u32 shift = chn * 8;
+	u32 PrevStatus;
+	u32 i;
+
+	if (chn >= UVC_TOTAL_CHANNEL_NUM || UVC_StreamInitStruct->UVC_StreamBuf == NULL ||
+		num < UVC_STREAM_BUF_MIN || num > UVC_STREAM_BUF_MAX || UVC_StreamInitStruct->UVC_StreamBufSize == 0) {
+		RTK_LOGE(TAG, "Invalid stream config\n");
+		return RTK_ERR_BADARG;
+	}
+
+	_memset((void *)stream, 0, sizeof(UVC_STREAM_TypeDef));
+	stream->Cfg = *UVC_StreamInitStruct;
+
+	for (i = 0; i < num; i++) {
+		DCache_Invalidate((u32)stream->Cfg.UVC_StreamBuf[i], stream->Cfg.UVC_StreamBufSize);
+	}
+
+	uvc_stream_arm(stream, 0, stream->Cfg.UVC_StreamBuf[0]);
+	uvc_stream_arm(stream, 1, stream->Cfg.UVC_StreamBuf[1]);
+
+	for (i = UVC_MAX_BUF_NUM; i < num; i++) {
+		stream->Free[stream->FreeHead++] = stream->Cfg.UVC_StreamBuf[i];
+	}
+	stream->Stats.MinFree = stream->FreeHead;
+
+	/* UVC_INTConfig() and UVC_INTClear() write back the pending events of the other channel and clear them */
+	PrevStatus = __get_PRIMASK();
+	__disable_irq();
+	UVC->UVC_INTR = (UVC->UVC_INTR & 0xFFFF0000) | (UVC_STREAM_CH_EVT << (shift + 16)) | (UVC_STREAM_CH_EVT << shift);
+	__set_PRIMASK(PrevStatus);
+
+	return RTK_SUCCESS;
+}
+
+/**
+  * @brief  Mask the interrupts of the stream channel.
+  * @param  stream: stream instance.
+  * @retval None
+  * @note   Buffers still armed or queued belong to the caller again.
+  */
+void UVC_STREAM_DeInit(UVC_STREAM_TypeDef *stream)
+{
+	u32 shift = stream->Cfg.UVC_StreamChn * 8;
+	u32 PrevStatus = __get_PRIMASK();
+
+	__disable_irq();
+	UVC->UVC_INTR = UVC->UVC_INTR & 0xFFFF0000 & ~(UVC_STREAM_CH_EVT << (shift + 16));
+	__set_PRIMASK(PrevStatus);
+}
+
+/**
+  * @brief  Handle the events of the stream channel, queue completed frames and re-arm the slots.
+  * @param  stream: stream instance.
+  * @retval Number of frames queued to the consumer.
+  * @note   Called from the UVC interrupt handler. With both slots done in one interrupt,
+  *         the slot the channel filled first is handled first.
+  */
+u32 UVC_STREAM_IRQHandler(UVC_STREAM_TypeDef *stream)
+{
+	u32 chn = stream->Cfg.UVC_StreamChn;
+	u32 shift = chn * 8;
+	u32 status = (UVC_GetIntStatus() >> shift) & UVC_STREAM_CH_EVT;
+	u32 now = DTimestamp_Get();
+	u32 queued = 0;
+	UVC_STREAM_FrameTypeDef *frame;
+	u32 slot, evt, pts, i;
+	u16 avail;
+	u8 *next;
+
+	if (status == 0) {
+		return 0;
+	}
+
+	UVC->UVC_INTR = (UVC->UVC_INTR & 0xFFFF0000) | (status << shift);
+
+	for (i = 0; i < UVC_MAX_BUF_NUM; i++) {
+		slot = stream->Slot;
+		evt = (status >> slot) & UVC_STREAM_SLOT_EVT;
+		if (evt == 0) {
+			slot ^= 1;
+			evt = (status >> slot) & UVC_STREAM_SLOT_EVT;
+			if (evt == 0) {
+				break;
+			}
+		}
+		status &= ~(evt << slot);
+		stream->Slot = slot ^ 1;
+		stream->Seq++;
+
+		pts = UVC_GetPTS(chn, slot);
+		uvc_stream_timing(stream, stream->Cfg.UVC_StreamPtsHz ? pts : now);
+
+		if (evt & (UVC_BIT_CH0_BUF0_FRM_OVERSIZE | UVC_BIT_CH0_BUF0_HEADER_ERR)) {
+			if (evt & UVC_BIT_CH0_BUF0_FRM_OVERSIZE) {
+				stream->Stats.Oversize++;
+			}
+			if (evt & UVC_BIT_CH0_BUF0_HEADER_ERR) {
+				stream->Stats.HeaderErr++;
+			}
+			uvc_stream_arm(stream, slot, stream->Armed[slot]);
+			continue;
+		}
+
+		avail = stream->FreeHead - stream->FreeTail;
+		if (avail == 0) {
+			stream->Stats.Overflows++;
+			stream->Stats.MinFree = 0;
+			uvc_stream_arm(stream, slot, stream->Armed[slot]);
+			continue;
+		}
+
+		next = stream->Free[UVC_STREAM_RING(stream->FreeTail)];
+		stream->FreeTail++;
+		stream->Stats.MinFree = MIN(stream->Stats.MinFree, (u32)avail - 1);
+
+		frame = &stream->Ready[UVC_STREAM_RING(stream->ReadyHead)];
+		frame->Buf = stream->Armed[slot];
+		frame->Size = MIN(UVC_GetFrameSize(chn, slot), stream->Cfg.UVC_StreamBufSize);
+		frame->Seq = stream->Seq;
+		frame->PTS = pts;
+		frame->SCRFirst = UVC_GetSCRFirst(chn, slot);
+		frame->SCRLast = UVC_GetSCRLast(chn, slot);
+		frame->TimeUs = now;
+		stream->ReadyHead++;
+
+		uvc_stream_arm(stream, slot, next);
+		stream->Stats.Frames++;
+		queued++;
+	}
+
+	return queued;
+}
+
+/**
+  * @brief  Take the oldest completed frame.
+  * @param  stream: stream instance.
+  * @param  Frame: frame description, Frame->Buf is owned by the caller until UVC_STREAM_FrameRelease().
+  * @retval RTK_SUCCESS, or RTK_FAIL if no frame is ready.
+  */
+int UVC_STREAM_FrameGet(UVC_STREAM_TypeDef *stream, UVC_STREAM_FrameTypeDef *Frame)
+{
+	if (stream->ReadyTail == stream->ReadyHead) {
+		return RTK_FAIL;
+	}
+
+	*Frame = stream->Ready[UVC_STREAM_RING(stream->ReadyTail)];
+	stream->ReadyTail++;
+
+	DCache_Invalidate((u32)Frame->Buf, Frame->Size);
+
+	return RTK_SUCCESS;
+}
+
+/**
+  * @brief  Give a frame buffer back to the stream.
+  * @param  stream: stream instance.
+  * @param  Buf: Buf of a frame taken by UVC_STREAM_FrameGet().
+  * @retval RTK_SUCCESS, or RTK_ERR_BADARG if Buf is not a buffer of the stream.
+  * @note   Buffers may be released in any order. Data the caller wrote to the buffer is discarded.
+  */
+int UVC_STREAM_FrameRelease(UVC_STREAM_TypeDef *stream, u8 *Buf)
+{
+	u32 i;
+
+	for (i = 0; i < stream->Cfg.UVC_StreamBufNum; i++) {
+		if (stream->Cfg.UVC_StreamBuf[i] == Buf) {
+			break;
+		}
+	}
+
+	if (i == stream->Cfg.UVC_StreamBufNum) {
+		return RTK_ERR_BADARG;
+	}
+
+	DCache_Invalidate((u32)Buf, stream->Cfg.UVC_StreamBufSize);
+
+	stream->Free[UVC_STREAM_RING(stream->FreeHead)] = Buf;
+	stream->FreeHead++;
+
+	return RTK_SUCCESS;
+}
+
+/**
+  * @brief  Get a snapshot of the stream statistics.
+  * @param  stream: stream instance.
+  * @param  Stats: pointer to the statistics copy.
+  * @retval None
+  */
+void UVC_STREAM_GetStats(UVC_STREAM_TypeDef *stream, UVC_STREAM_StatsTypeDef *Stats)
+{
+	u32 PrevStatus = __get_PRIMASK();
+
+	__disable_irq();
+	*Stats = stream->Stats;
+	__set_PRIMASK(PrevStatus);
+
+	Stats->FpsX100 = Stats->IntervalUs ? 100000000 / Stats->IntervalUs : 0;
+}
+
+/** @} */
+
+/** @} */
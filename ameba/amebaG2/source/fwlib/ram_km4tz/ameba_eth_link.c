@@ -0,0 +1,369 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ameba_soc.h"
+
+static const char *const TAG = "ETH_LINK";
+
+#define ETH_LINK_MDIO_IDLE		0
+#define ETH_LINK_MDIO_PAGE		1	/* page select write in flight */
+#define ETH_LINK_MDIO_ACCESS	2	/* register read or write in flight */
+
+/** @addtogroup Ameba_Periph_Driver
+  * @{
+  */
+
+/** @defgroup ETH_LINK
+  * @brief ETH_LINK driver modules
+  * @{
+  */
+
+static void eth_link_event(ETH_LINK_TypeDef *link, u32 Event)
+{
+	if (link->Cfg.ETH_LinkEventCb != NULL) {
+		link->Cfg.ETH_LinkEventCb(link->Cfg.ETH_LinkCbData, Event);
+	}
+}
+
+/* Indirect MMD access through registers 13/14, same sequence as PHY_SET_MMD_REG */
+static void eth_link_mmd_queue(ETH_LINK_TypeDef *link, u16 Device, u16 Addr, u16 Data, u16 *Result)
+{
+	ETH_LINK_MdioQueue(link, FEPHY_REG_PAGE_0, FEPHY_REG_ADDR_13, Device, NULL);
+	ETH_LINK_MdioQueue(link, FEPHY_REG_PAGE_0, FEPHY_REG_ADDR_14, Addr, NULL);
+	ETH_LINK_MdioQueue(link, FEPHY_REG_PAGE_0, FEPHY_REG_ADDR_13, Device | RTK_MACR_DATA, NULL);
+	ETH_LINK_MdioQueue(link, FEPHY_REG_PAGE_0, FEPHY_REG_ADDR_14, Data, Result);
+}
+
+/* Advance the MDIO queue as far as the hardware allows, never waits */
+static void eth_link_mdio_run(ETH_LINK_TypeDef *link)
+{
+	ETHERNET_TypeDef *RMII = ((ETHERNET_TypeDef *) RMII_REG_BASE);
+	ETH_LINK_MdioXfer *xfer;
+	u32 miiar, done;
+
+	while (link->MdioTail != link->MdioHead) {
+		xfer = &link->Mdio[link->MdioTail & (ETH_LINK_MDIO_QUEUE - 1)];
+
+		if (link->MdioPhase == ETH_LINK_MDIO_IDLE) {
+			/* switch to the page by register 31, as Ethernet_Read_PhyReg/Ethernet_Write_PhyReg */
+			if (RMII->ETH_MIIAR & BIT_MDIO_BUSY) {
+				return;
+			}
+			RMII->ETH_MIIAR = (BIT_FLAG | PHYADDRESS(phy_id) | (xfer->Result ? 0 : BIT_DISABLE_AUTO_POLLING) | REGADDR4_0(0x1F) | xfer->Page);
+			link->MdioPhase = ETH_LINK_MDIO_PAGE;
+			link->MdioStart = DTimestamp_Get();
+			return;
+		}
+
+		miiar = RMII->ETH_MIIAR;
+		if (link->MdioPhase == ETH_LINK_MDIO_ACCESS && xfer->Result != NULL) {
+			done = ((miiar & BIT_MDIO_BUSY) == 0) && ((miiar & BIT_FLAG) != 0);
+		} else {
+			done = (miiar & (BIT_FLAG | BIT_MDIO_BUSY)) == 0;
+		}
+
+		if (!done) {
+			if (DTimestamp_Get() - link->MdioStart < ETH_LINK_MDIO_TMO_US) {
+				return;
+			}
+			RTK_LOGE(TAG, "MDIO timeout page %d reg %d\n", xfer->Page, xfer->Reg);
+			link->Stats.MdioTimeouts++;
+			link->MdioPhase = ETH_LINK_MDIO_IDLE;
+			link->MdioTail++;
+			continue;
+		}
+
+		if (link->MdioPhase == ETH_LINK_MDIO_PAGE) {
+			if (xfer->Result != NULL) {
+				RMII->ETH_MIIAR = (PHYADDRESS(phy_id) | REGADDR4_0(xfer->Reg));
+			} else {
+				RMII->ETH_MIIAR = (BIT_FLAG | BIT_DISABLE_AUTO_POLLING | PHYADDRESS(phy_id) | REGADDR4_0(xfer->Reg) | xfer->Data);
+			}
+			link->MdioPhase = ETH_LINK_MDIO_ACCESS;
+			link->MdioStart = DTimestamp_Get();
+			return;
+		}
+
+		if (xfer->Result != NULL) {
+			*xfer->Result = (u16)(miiar & 0xFFFF);
+		}
+		link->Stats.MdioXfers++;
+		link->MdioPhase = ETH_LINK_MDIO_IDLE;
+		link->MdioTail++;
+	}
+}
+
+static void eth_link_eee_set(ETH_LINK_TypeDef *link, u8 On)
+{
+	ETHERNET_TypeDef *RMII = ((ETHERNET_TypeDef *) RMII_REG_BASE);
+
+	if (On) {
+		RMII->ETH_EEE_CR1 |= (BIT_EN_EEE | BIT_EN_EEE_TX | BIT_EN_EEE_RX);
+		link->Stats.EeeEnables++;
+	} else {
+		RMII->ETH_EEE_CR1 &= ~(BIT_EN_EEE | BIT_EN_EEE_TX | BIT_EN_EEE_RX);
+		link->Stats.EeeDisables++;
+	}
+
+	link->EeeOn = On;
+	eth_link_event(link, On ? ETH_LINK_EVT_EEE_ON : ETH_LINK_EVT_EEE_OFF);
+}
+
+static void eth_link_check(ETH_LINK_TypeDef *link)
+{
+	ETHERNET_TypeDef *RMII = ((ETHERNET_TypeDef *) RMII_REG_BASE);
+	u32 up = (GET_LINKB(RMII->ETH_MSR) == eth_link_up);
+
+	if (up && link->State == ETH_LINK_STATE_DOWN) {
+		/* the MAC resolved speed and duplex by auto polling, read what the PHY negotiated */
+		link->State = ETH_LINK_STATE_AN;
+		link->LpEee = 0;
+		ETH_LINK_MdioQueue(link, FEPHY_REG_PAGE_0, FEPHY_REG_ADDR_1, 0, &link->Bmsr);
+		ETH_LINK_MdioQueue(link, FEPHY_REG_PAGE_0, FEPHY_REG_ADDR_5, 0, &link->Anlpar);
+		if (link->Cfg.ETH_LinkEeeEn) {
+			eth_link_mmd_queue(link, RTK_EEELPAR_DEVICE, RTK_EEELPAR_ADDRESS, 0, &link->LpEee);
+		}
+	} else if (!up && link->State != ETH_LINK_STATE_DOWN) {
+		if (link->EeeOn) {
+			eth_link_eee_set(link, 0);
+		}
+		link->State = ETH_LINK_STATE_DOWN;
+		link->EeeCap = 0;
+		link_is_up = 0;
+		link->Stats.LinkDowns++;
+		RTK_LOGI(TAG, "Link down\n");
+		eth_link_event(link, ETH_LINK_EVT_DOWN);
+	}
+}
+
+static void eth_link_resolve(ETH_LINK_TypeDef *link)
+{
+	ETHERNET_TypeDef *RMII = ((ETHERNET_TypeDef *) RMII_REG_BASE);
+
+	link->Speed = GET_SPEED(RMII->ETH_MSR);
+	link->Duplex = GET_FULLDUPREG(RMII->ETH_MSR);
+
+	/* EEE is only defined for 100BASE-TX full duplex here */
+	link->EeeCap = link->Cfg.ETH_LinkEeeEn && (link->Speed == eth_speed_100) && (link->Duplex == eth_full_duplex) &&
+				   (link->LpEee & RTK_EEEAR_ADVERTISE_EEE);
+
+	if (!(link->Bmsr & PHY_BMSR_AN_COMPLETE)) {
+		RTK_LOGW(TAG, "Link up without autonegotiation, BMSR 0x%x\n", link->Bmsr);
+	}
+
+	link->State = ETH_LINK_STATE_UP;
+	link->IdleUs = 0;
+	link->BusyRun = 0;
+	link->TxCount = link->Cfg.ETH_Init->ETH_TxPktCount;
+	link->RxCount = link->Cfg.ETH_Init->ETH_RxPktCount;
+	link_is_up = 1;
+	link->Stats.LinkUps++;
+
+	RTK_LOGI(TAG, "Link up %s Mb/s %s duplex, LPA 0x%x, EEE %s\n", (link->Speed == eth_speed_100) ? "100" : "10",
+			 (link->Duplex == eth_full_duplex) ? "full" : "half", link->Anlpar, link->EeeCap ? "capable" : "off");
+	eth_link_event(link, ETH_LINK_EVT_UP);
+}
+
+/* Packet activity since the last call decides when LPI is worth its wake latency. The free running
+ * counters are compared, not the ring indexes, a full ring wrap between two calls is still traffic */
+static void eth_link_eee_policy(ETH_LINK_TypeDef *link, u32 Elapsed)
+{
+	ETH_InitTypeDef *eth = link->Cfg.ETH_Init;
+	u32 tx = eth->ETH_TxPktCount;
+	u32 rx = eth->ETH_RxPktCount;
+	u32 active;
+
+	active = (link->TxCount != tx) || (link->RxCount != rx);
+	link->TxCount = tx;
+	link->RxCount = rx;
+
+	if (!link->EeeCap) {
+		return;
+	}
+
+	if (active) {
+		link->IdleUs = 0;
+		if (link->BusyRun < 0xFFFF) {
+			link->BusyRun++;
+		}
+	} else {
+		link->BusyRun = 0;
+		link->IdleUs = (link->IdleUs + Elapsed < link->IdleUs) ? 0xFFFFFFFF : link->IdleUs + Elapsed;
+	}
+
+	if (!link->EeeOn && link->IdleUs >= link->Cfg.ETH_LinkEeeIdleUs) {
+		eth_link_eee_set(link, 1);
+	} else if (link->EeeOn && link->BusyRun >= link->Cfg.ETH_LinkEeeBusyRuns) {
+		eth_link_eee_set(link, 0);
+	}
+}
+
+/**
+  * @brief  Fills each ETH_LinkInitStruct member with its default value.
+  * @param  ETH_LinkInitStruct: pointer to an ETH_LINK_InitTypeDef structure which will be initialized.
+  * @retval None
+  */
+void ETH_LINK_StructInit(ETH_LINK_InitTypeDef *ETH_LinkInitStruct)
+{
+	_memset(ETH_LinkInitStruct, 0, sizeof(ETH_LINK_InitTypeDef));
+	ETH_LinkInitStruct->ETH_LinkEeeEn = ENABLE;
+	ETH_LinkInitStruct->ETH_LinkEeeIdleUs = 50000;
+	ETH_LinkInitStruct->ETH_LinkEeeBusyRuns = 3;
+}
+
+/**
+  * @brief  Initialize the link manager.
+  * @param  link: instance, storage provided by the caller.
+  * @param  ETH_LinkInitStruct: pointer to an ETH_LINK_InitTypeDef structure.
+  * @retval RTK_SUCCESS or RTK_ERR_BADARG
+  * @note   With ETH_LinkEeeEn the PHY EEE advertisement is queued here and autonegotiation is
+  *         restarted, the MAC EEE stays off until the policy turns it on.
+  */
+int ETH_LINK_Init(ETH_LINK_TypeDef *link, ETH_LINK_InitTypeDef *ETH_LinkInitStruct)
+{
+	ETHERNET_TypeDef *RMII = ((ETHERNET_TypeDef *) RMII_REG_BASE);
+
+	if (ETH_LinkInitStruct->ETH_Init == NULL) {
+		return RTK_ERR_BADARG;
+	}
+
+	_memset(link, 0, sizeof(ETH_LINK_TypeDef));
+	_memcpy(&link->Cfg, ETH_LinkInitStruct, sizeof(ETH_LINK_InitTypeDef));
+	link->State = ETH_LINK_STATE_DOWN;
+	link->LastTime = DTimestamp_Get();
+
+	RMII->ETH_EEE_CR1 &= ~(BIT_EN_EEE | BIT_EN_EEE_TX | BIT_EN_EEE_RX);
+
+	if (link->Cfg.ETH_LinkEeeEn && link->Cfg.ETH_Init->ETH_Phy_Type == RTL_8721F) {
+		/* same settings as PHY_ENABLE_EEE and PHY_SET_EEE_MODE, without blocking */
+		ETH_LINK_MdioQueue(link, RTK8201F_EEE_CAPAB_PAGE, RTK8201F_EEE_CAPAB_REG, RTK8201F_EEE_CAPAB_EN, NULL);
+		eth_link_mmd_queue(link, RTK_EEEAR_DEVICE, RTK_EEEAR_ADDRESS, RTK_EEEAR_ADVERTISE_EEE, NULL);
+		ETH_LINK_MdioQueue(link, RTK8201F_EEE_MODE_PAGE, RTK8201F_EEE_MODE_REG, RTK8201F_EEE_MAC_MODE_SET, NULL);
+		ETH_LINK_MdioQueue(link, FEPHY_REG_PAGE_0, FEPHY_REG_ADDR_0, 0x1200, NULL);
+	}
+
+	return RTK_SUCCESS;
+}
+
+/**
+  * @brief  Queue a PHY register access.
+  * @param  link: instance.
+  * @param  Page: PHY page.
+  * @param  Reg: PHY register, 0 ~ 31.
+  * @param  Data: value to write, ignored for a read.
+  * @param  Result: read value destination, NULL to write Data.
+  * @retval RTK_SUCCESS, RTK_ERR_BADARG or RTK_ERR_NOMEM if the queue is full
+  * @note   Call it from the ETH_LINK_Process task, *Result is valid once ETH_LINK_Process returns FALSE.
+  */
+int ETH_LINK_MdioQueue(ETH_LINK_TypeDef *link, u8 Page, u8 Reg, u16 Data, u16 *Result)
+{
+	ETH_LINK_MdioXfer *xfer;
+
+	if (Reg > 0x1F) {
+		return RTK_ERR_BADARG;
+	}
+
+	if (link->MdioHead - link->MdioTail >= ETH_LINK_MDIO_QUEUE) {
+		RTK_LOGE(TAG, "MDIO queue full\n");
+		return RTK_ERR_NOMEM;
+	}
+
+	xfer = &link->Mdio[link->MdioHead & (ETH_LINK_MDIO_QUEUE - 1)];
+	xfer->Page = Page;
+	xfer->Reg = Reg;
+	xfer->Data = Data;
+	xfer->Result = Result;
+	link->MdioHead++;
+
+	return RTK_SUCCESS;
+}
+
+/**
+  * @brief  Link change interrupt handling.
+  * @param  link: instance.
+  * @retval None
+  * @note   Acknowledges the interrupt and wakes the ETH_LINK_Process task by ETH_LinkWakeCb,
+  *         the state is evaluated there.
+  */
+void ETH_LINK_IRQHandler(ETH_LINK_TypeDef *link)
+{
+	Ethernet_ClearINT(BIT_ISR_LINKCHG);
+
+	if (link->Cfg.ETH_LinkWakeCb != NULL) {
+		link->Cfg.ETH_LinkWakeCb(link->Cfg.ETH_LinkCbData);
+	}
+}
+
+/**
+  * @brief  Run the link manager.
+  * @param  link: instance.
+  * @retval TRUE while MDIO transactions are pending.
+  */
+bool ETH_LINK_Process(ETH_LINK_TypeDef *link)
+{
+	ETHERNET_TypeDef *RMII = ((ETHERNET_TypeDef *) RMII_REG_BASE);
+	u32 now = DTimestamp_Get();
+	u32 elapsed = now - link->LastTime;
+	u32 PrevStatus;
+
+	link->LastTime = now;
+
+	PrevStatus = __get_PRIMASK();
+	__disable_irq();
+	if (link->State == ETH_LINK_STATE_UP) {
+		link->Stats.LinkUpUs += elapsed;
+	}
+	if (link->EeeOn) {
+		link->Stats.EeeOnUs += elapsed;
+		if (RMII->ETH_EEE_CR1 & BIT_EEE_STS) {
+			link->Stats.LpiUs += elapsed;
+		}
+	}
+	__set_PRIMASK(PrevStatus);
+
+	/* the MSR link bit is cheap to read, so a missed interrupt is caught on the next call */
+	eth_link_check(link);
+	eth_link_mdio_run(link);
+
+	if (link->State == ETH_LINK_STATE_AN && link->MdioHead == link->MdioTail) {
+		eth_link_resolve(link);
+	}
+
+	if (link->State == ETH_LINK_STATE_UP) {
+		eth_link_eee_policy(link, elapsed);
+	}
+
+	return (link->MdioHead != link->MdioTail);
+}
+
+/**
+  * @brief  Get the link state.
+  * @param  link: instance.
+  * @retval @ref ETH_LINK_State
+  */
+u32 ETH_LINK_GetState(ETH_LINK_TypeDef *link)
+{
+	return link->State;
+}
+
+/**
+  * @brief  Get the link manager statistics.
+  * @param  link: instance.
+  * @param  Stats: pointer to the copy.
+  * @retval None
+  */
+void ETH_LINK_GetStats(ETH_LINK_TypeDef *link, ETH_LINK_StatsTypeDef *Stats)
+{
+	u32 PrevStatus = __get_PRIMASK();
+
+	__disable_irq();
+	_memcpy(Stats, &link->Stats, sizeof(ETH_LINK_StatsTypeDef));
+	__set_PRIMASK(PrevStatus);
+}
+
+/** @} */
+
+/** @} */
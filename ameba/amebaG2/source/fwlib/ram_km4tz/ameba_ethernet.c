@@ -51,7 +51,9 @@ __weak u32 RMII_IRQHandler(ETH_InitTypeDef *ETH_InitStruct)
 	u32 intr_status;
 	intr_status = Ethernet_GetINT();
 
-	if ((intr_status & BIT_ISR_ROK) && (intr_status & BIT_IMR_ROK)) {
+	if ((intr_status & BIT_ISR_ROK) && (intr_status & BIT_IMR_ROK) && (ETH_InitStruct->ETH_Napi != NULL)) {
+		Ethernet_NapiIRQHandler(ETH_InitStruct->ETH_Napi);
+	} else if ((intr_status & BIT_ISR_ROK) && (intr_status & BIT_IMR_ROK)) {
 		if ((ETH_InitStruct->callback) != NULL) {
 			ETH_InitStruct->callback(EthRxDone, 0);
 		}
@@ -254,6 +256,7 @@ void Ethernet_UpdateTXDESCAndSend(ETH_InitTypeDef *ETH_InitStruct, u32 size)
 	} else {
 		ETH_InitStruct->ETH_TxDescCurrentNum++;
 	}
+	ETH_InitStruct->ETH_TxPktCount++;
 }
 
 /**
@@ -312,6 +315,7 @@ void Ethernet_UpdateRXDESC(ETH_InitTypeDef *ETH_InitStruct)
 	} else {
 		ETH_InitStruct->ETH_RxDescCurrentNum++;
 	}
+	ETH_InitStruct->ETH_RxPktCount++;
 
 	RMII->ETH_ISR_AND_IMR |= BIT_ISR_ROK;
 	RMII->ETH_IO_CMD1 |= BIT_RXRING1; // TODO: no need for each pkt
@@ -440,6 +444,173 @@ u32 Ethernet_Write_PhyReg(u16 page, u16 reg_addr, u16 data)
 	return 0;
 }
 
+/* Write the IMR half only, the ISR half is write 1 to clear and stays untouched */
+static void Ethernet_RxIntMask(u32 NewState)
+{
+	ETHERNET_TypeDef *RMII = ((ETHERNET_TypeDef *) RMII_REG_BASE);
+	u32 imr = RMII->ETH_ISR_AND_IMR & 0xFFFF0000;
+
+	if (NewState == ENABLE) {
+		RMII->ETH_ISR_AND_IMR = imr | BIT_IMR_ROK;
+	} else {
+		RMII->ETH_ISR_AND_IMR = imr & ~BIT_IMR_ROK;
+	}
+}
+
+/**
+  * \brief  Initialize RX interrupt moderation, the callbacks and budget limits are set by the caller afterwards.
+  * \param  napi: The pointer to ETH_NapiTypeDef, storage provided by the caller.
+  * \param  ETH_InitStruct: The pointer to ETH_InitTypeDef, RMII_IRQHandler hands ROK to napi from now on.
+  * \return None.
+  */
+void Ethernet_NapiInit(ETH_NapiTypeDef *napi, ETH_InitTypeDef *ETH_InitStruct)
+{
+	_memset(napi, 0, sizeof(ETH_NapiTypeDef));
+	napi->Eth = ETH_InitStruct;
+	napi->BudgetMin = 4;
+	napi->BudgetMax = ETH_InitStruct->ETH_RxDescNum;
+	napi->Budget = napi->BudgetMin;
+	napi->LingerMax = 2;
+	ETH_InitStruct->ETH_Napi = napi;
+}
+
+/**
+  * \brief  RX interrupt handling in moderation mode: mask the RX interrupt and schedule polling.
+  * \param  napi: The pointer to ETH_NapiTypeDef.
+  * \return None.
+  */
+void Ethernet_NapiIRQHandler(ETH_NapiTypeDef *napi)
+{
+	ETHERNET_TypeDef *RMII = ((ETHERNET_TypeDef *) RMII_REG_BASE);
+
+	Ethernet_RxIntMask(DISABLE);
+	RMII->ETH_ISR_AND_IMR = (RMII->ETH_ISR_AND_IMR & 0xFFFF0000) | BIT_ISR_ROK;
+
+	napi->Stats.Irqs++;
+	napi->Polling = 1;
+
+	if (napi->ScheduleCb != NULL) {
+		napi->ScheduleCb(napi->CbData);
+	}
+}
+
+/**
+  * \brief  Deliver up to one budget of RX packets by RxCb.
+  * \param  napi: The pointer to ETH_NapiTypeDef.
+  * \return TRUE to poll again (after yielding if needed), FALSE when the ring is drained and
+  *         the RX interrupt is enabled again.
+  */
+bool Ethernet_NapiPoll(ETH_NapiTypeDef *napi)
+{
+	ETHERNET_TypeDef *RMII = ((ETHERNET_TypeDef *) RMII_REG_BASE);
+	ETH_InitTypeDef *eth = napi->Eth;
+	ETH_RxDescTypeDef *desc;
+	u32 done = 0;
+	u32 len, ppi;
+	u32 PrevStatus;
+
+	if (!napi->Polling) {
+		return FALSE;
+	}
+
+	while (done < napi->Budget) {
+		desc = &eth->ETH_RxDesc[eth->ETH_RxDescCurrentNum];
+		if (((volatile u32)desc->dw1) & FEMAC_TX_DSC_BIT_OWN) {
+			break;
+		}
+
+		len = desc->dw1 & 0xFFF;
+		DCache_Invalidate((u32)desc->addr, (u32)ETH_PKT_BUFF_SZ);
+		if (napi->RxCb != NULL) {
+			napi->RxCb(napi->CbData, (u8 *)(desc->addr + 2), len);
+		}
+
+		/* same as Ethernet_UpdateRXDESC, without touching the ISR bits of other events */
+		desc->dw1 &= FEMAC_TX_DSC_BIT_EOR;
+		desc->dw1 |= (FEMAC_TX_DSC_BIT_OWN | ETH_PKT_BUFF_SZ);
+		desc->dw2 = 0;
+		desc->dw3 = 0;
+		if (eth->ETH_RxDescCurrentNum == eth->ETH_RxDescNum - 1) {
+			eth->ETH_RxDescCurrentNum = 0;
+		} else {
+			eth->ETH_RxDescCurrentNum++;
+		}
+		eth->ETH_RxPktCount++;
+		done++;
+	}
+
+	if (done) {
+		RMII->ETH_IO_CMD1 |= BIT_RXRING1;
+	}
+
+	napi->Stats.Rounds++;
+	napi->Stats.Packets += done;
+	napi->RoundPkts += done;
+
+	if (done == napi->Budget) {
+		napi->Stats.BudgetHits++;
+		napi->Budget = MIN(napi->Budget * 2, napi->BudgetMax);
+		return TRUE;
+	}
+
+	if (done * 4 < napi->Budget) {
+		napi->Budget = MAX(napi->Budget / 2, napi->BudgetMin);
+	}
+
+	if (done) {
+		return TRUE;
+	}
+
+	/* the ring is empty: linger a few rounds when the rate is high, a new burst is likely */
+	if (napi->Linger) {
+		napi->Linger--;
+		return TRUE;
+	}
+
+	/* packets per interrupt, 1/8 weight per interrupt, in Q8 */
+	ppi = napi->RoundPkts << 8;
+	napi->Stats.PktPerIrqQ8 = napi->Stats.PktPerIrqQ8 - (napi->Stats.PktPerIrqQ8 >> 3) + (ppi >> 3);
+	napi->RoundPkts = 0;
+	napi->Linger = MIN((napi->Stats.PktPerIrqQ8 >> 8) / napi->BudgetMin, napi->LingerMax);
+
+	/* drop the ROK latched by the packets just polled, then re-check the ring so a packet
+	 * that landed in between is not left waiting for the next one. Polling is cleared with
+	 * the interrupt still off, a ROK taken after the restore sets it again */
+	PrevStatus = __get_PRIMASK();
+	__disable_irq();
+
+	napi->Polling = 0;
+	RMII->ETH_ISR_AND_IMR = (RMII->ETH_ISR_AND_IMR & 0xFFFF0000) | BIT_ISR_ROK;
+	Ethernet_RxIntMask(ENABLE);
+
+	if ((((volatile u32)(eth->ETH_RxDesc[eth->ETH_RxDescCurrentNum].dw1)) & FEMAC_TX_DSC_BIT_OWN) == 0) {
+		Ethernet_RxIntMask(DISABLE);
+		napi->Polling = 1;
+		__set_PRIMASK(PrevStatus);
+		return TRUE;
+	}
+
+	__set_PRIMASK(PrevStatus);
+	napi->Stats.Rearms++;
+
+	return FALSE;
+}
+
+/**
+  * \brief  Get the RX polling statistics.
+  * \param  napi: The pointer to ETH_NapiTypeDef.
+  * \param  Stats: The pointer to the copy.
+  * \return None.
+  */
+void Ethernet_NapiGetStats(ETH_NapiTypeDef *napi, ETH_NapiStatsTypeDef *Stats)
+{
+	u32 PrevStatus = __get_PRIMASK();
+
+	__disable_irq();
+	_memcpy(Stats, &napi->Stats, sizeof(ETH_NapiStatsTypeDef));
+	__set_PRIMASK(PrevStatus);
+}
+
 /**
   * \brief  Enable ethernet RX.
   * \param  None.
@@ -494,6 +665,8 @@ void Ethernet_StructInit(ETH_InitTypeDef *ETH_InitStruct)
 	ETH_InitStruct->ETH_IntMaskAndStatus = BIT_IMR_LINKCHG | BIT_IMR_TOK_TI | BIT_IMR_RER_OVF | BIT_IMR_ROK | 0xFFFF;
 	ETH_InitStruct->ETH_RxDescCurrentNum = 0;
 	ETH_InitStruct->ETH_TxDescCurrentNum = 0;
+	ETH_InitStruct->ETH_TxPktCount = 0;
+	ETH_InitStruct->ETH_RxPktCount = 0;
 	ETH_InitStruct->ETH_RxFrameStartDescIdx = 0;
 	ETH_InitStruct->ETH_RxFrameLen = 0;
 	ETH_InitStruct->ETH_RxSegmentCount = 0;
@@ -501,6 +674,7 @@ void Ethernet_StructInit(ETH_InitTypeDef *ETH_InitStruct)
 	ETH_InitStruct->ETH_RxAllocBufSize = 1600;
 	ETH_InitStruct->ETH_TxBufSize = 1524;
 	ETH_InitStruct->ETH_RxBufSize = 1524;
+	ETH_InitStruct->ETH_Napi = NULL;
 }
 
 u32 Ethernet_init(ETH_InitTypeDef *ETH_InitStruct)
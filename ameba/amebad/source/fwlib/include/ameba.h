@@ -71,7 +71,9 @@
 #include "ameba_delay.h"
 #include "ameba_ir.h"
 #include "ameba_keyscan.h"
+#include "ameba_keyscan_eng.h"
 #include "ameba_sgpio.h"
+#include "ameba_sgpio_proto.h"
 #include "ameba_qdec.h"
 #include "ameba_usi.h"
 #include "ameba_usi_uart.h"
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _AMEBA_KEYSCAN_ENG_H_
+#define _AMEBA_KEYSCAN_ENG_H_
+
+/** @addtogroup AmebaD_Periph_Driver
+  * @{
+  */
+
+/** @defgroup KeyScan_Eng
+  * @{
+  */
+
+/** @addtogroup KeyScan_Eng
+  * @verbatim
+  *****************************************************************************************
+  * Introduction
+  *****************************************************************************************
+  * KeyScan event engine, on top of the KeyScan driver:
+  *		- the interrupt handler drains the whole FIFO at once and keeps the key matrix
+  *		  as one bitmap per row: the hardware state, the debounced state and the state
+  *		  reported to the application
+  *		- software debounce profiles, selected per key, on top of the hardware debounce:
+  *		  KS_ENG_DEB_EAGER reports a change at once and ignores the key for the profile
+  *		  time, a tap shorter than that gets its release when the time ends,
+  *		  KS_ENG_DEB_DEFER reports a change once stable for the profile time
+  *		- ghost key filter for matrices without diodes: a key press completing a rectangle
+  *		  of pressed keys over two rows and two columns is held back until the rectangle
+  *		  breaks, keys already reported stay pressed
+  *		- key rollover: with KS_EngMaxKeys set, presses beyond this number are held back
+  *		  and reported when a key is released, 0 gives n-key rollover
+  *		- press and release events go to a lock-free queue, the interrupt handler is the
+  *		  only producer and one task the only consumer. When the queue is full, the
+  *		  events are kept back and reported later, none is lost
+  *		- the scan finish interrupt is only enabled while a debounce or a queued event
+  *		  is pending, and the all release interrupt resynchronizes the matrix after a
+  *		  FIFO overflow
+  *
+  * Times are in SYSTIMER ticks of 31us.
+  *
+  *****************************************************************************************
+  * How to use
+  *****************************************************************************************
+  *      1. Set the KeyScan up as usual by KeyScan_StructInit() and KeyScan_Init().
+  *
+  *      2. Fill a KeyScan_EngInitTypeDef by KeyScan_EngStructInit(), give the event queue
+  *			buffer and call KeyScan_EngInit(). It enables the interrupts it needs.
+  *
+  *      3. Call KeyScan_EngIRQHandler() from the KeyScan interrupt handler, then enable
+  *			the KeyScan by KeyScan_Cmd().
+  *
+  *      4. Read the events by KeyScan_EngGetEvent(), the KS_EngCb callback tells when new
+  *			ones are queued. In event trigger mode, or after emptying a full queue, call
+  *			KeyScan_EngPoll() to flush what is pending.
+  *
+  *****************************************************************************************
+  * @endverbatim
+  */
+
+/* Exported constants --------------------------------------------------------*/
+/** @defgroup KeyScan_Eng_Exported_Constants KeyScan_Eng Exported Constants
+  * @{
+  */
+
+#define KS_ENG_ROW_MAX				8
+#define KS_ENG_COL_MAX				8
+#define KS_ENG_KEY_MAX				(KS_ENG_ROW_MAX * KS_ENG_COL_MAX)
+#define KS_ENG_PROF_NUM				4
+#define KS_ENG_TICK_HZ				32768		/*!< SYSTIMER clock */
+
+/** @defgroup KeyScan_Eng_Debounce_Mode
+  * @{
+  */
+#define KS_ENG_DEB_NONE				0		/*!< hardware debounce only */
+#define KS_ENG_DEB_EAGER			1		/*!< report at once, then ignore the key for the profile time */
+#define KS_ENG_DEB_DEFER			2		/*!< report once stable for the profile time */
+/** @} */
+
+/** @} */
+
+/* Exported types ------------------------------------------------------------*/
+/** @defgroup KeyScan_Eng_Exported_Types KeyScan_Eng Exported Types
+  * @{
+  */
+
+/**
+  * @brief  KeyScan_Eng key event
+  */
+typedef struct {
+	u8 Row;
+	u8 Col;
+	u8 Press;					/*!< 1 for press, 0 for release */
+	u8 Rsvd;
+	u32 Time;					/*!< SYSTIMER tick of the interrupt */
+} KeyScan_EventTypeDef;
+
+/**
+  * @brief  KeyScan_Eng debounce profile
+  */
+typedef struct {
+	u16 Mode;					/*!< @ref KeyScan_Eng_Debounce_Mode */
+	u16 Ms;
+} KeyScan_EngProfTypeDef;
+
+/**
+  * @brief  KeyScan_Eng statistics
+  */
+typedef struct {
+	u32 Irqs;
+	u32 Entries;				/*!< FIFO entries drained */
+	u32 BatchMax;				/*!< most FIFO entries drained by one interrupt */
+	u32 Events;					/*!< events queued */
+	u32 Bounces;				/*!< hardware changes absorbed by the software debounce */
+	u32 Ghosts;					/*!< presses held back by the ghost key filter */
+	u32 Rollover;				/*!< presses held back by KS_EngMaxKeys */
+	u32 QueueFull;				/*!< events kept back by a full queue */
+	u32 FifoOverflow;
+	u32 Resyncs;				/*!< keys released by the all release interrupt */
+} KeyScan_EngStatsTypeDef;
+
+/**
+  * @brief  KeyScan_Eng init structure definition
+  */
+typedef struct {
+	KeyScan_EngProfTypeDef KS_EngProf[KS_ENG_PROF_NUM];	/*!< profile 0 is the default of all keys */
+	u32 KS_EngGhostFilter;		/*!< ENABLE for matrices without diodes */
+	u32 KS_EngMaxKeys;			/*!< keys reported pressed at a time, 0 for no limit */
+	KeyScan_EventTypeDef *KS_EngEvtBuf;
+	u32 KS_EngEvtNum;			/*!< queue size, power of 2 */
+	void (*KS_EngCb)(void *Data);	/*!< optional, called in ISR when events were queued */
+	void *KS_EngCbData;
+} KeyScan_EngInitTypeDef;
+
+/**
+  * @brief  KeyScan_Eng instance
+  */
+typedef struct {
+	KeyScan_EngInitTypeDef Cfg;
+	KEYSCAN_TypeDef *KeyScan;
+	u32 DebTicks[KS_ENG_PROF_NUM];
+	u8 Hw[KS_ENG_ROW_MAX];		/*!< state from the FIFO, one bit per column */
+	u8 Deb[KS_ENG_ROW_MAX];		/*!< debounced state */
+	u8 Rep[KS_ENG_ROW_MAX];		/*!< state reported by the events */
+	u8 Blocked[KS_ENG_ROW_MAX];	/*!< debounced presses held back */
+	u8 Prof[KS_ENG_KEY_MAX];
+	u32 Stamp[KS_ENG_KEY_MAX];	/*!< tick of the last change, debounce reference */
+	u32 RepNum;					/*!< keys reported pressed */
+	u32 FinishOn;				/*!< scan finish interrupt enabled */
+	volatile u32 Head;			/*!< written by the producer only */
+	volatile u32 Tail;			/*!< written by the consumer only */
+	KeyScan_EngStatsTypeDef Stats;
+} KeyScan_EngTypeDef;
+
+/** @} */
+
+/* Exported functions --------------------------------------------------------*/
+/** @defgroup KeyScan_Eng_Exported_Functions KeyScan_Eng Exported Functions
+  * @{
+  */
+_LONG_CALL_ void KeyScan_EngStructInit(KeyScan_EngInitTypeDef *KeyScan_EngInitStruct);
+_LONG_CALL_ int KeyScan_EngInit(KeyScan_EngTypeDef *eng, KeyScan_EngInitTypeDef *KeyScan_EngInitStruct);
+_LONG_CALL_ int KeyScan_EngSetProfile(KeyScan_EngTypeDef *eng, u32 Row, u32 Col, u32 Prof);
+_LONG_CALL_ void KeyScan_EngIRQHandler(KeyScan_EngTypeDef *eng);
+_LONG_CALL_ void KeyScan_EngPoll(KeyScan_EngTypeDef *eng);
+_LONG_CALL_ bool KeyScan_EngGetEvent(KeyScan_EngTypeDef *eng, KeyScan_EventTypeDef *Evt);
+_LONG_CALL_ void KeyScan_EngGetState(KeyScan_EngTypeDef *eng, u8 *Matrix);
+_LONG_CALL_ void KeyScan_EngGetStats(KeyScan_EngTypeDef *eng, KeyScan_EngStatsTypeDef *Stats);
+/** @} */
+
+/** @} */
+
+/** @} */
+
+#endif
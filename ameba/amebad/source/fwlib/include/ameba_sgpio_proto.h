@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _AMEBA_SGPIO_PROTO_H_
+#define _AMEBA_SGPIO_PROTO_H_
+
+/** @addtogroup AmebaD_Periph_Driver
+  * @{
+  */
+
+/** @defgroup SGPIO_Proto
+  * @{
+  */
+
+/** @addtogroup SGPIO_Proto
+  * @verbatim
+  *****************************************************************************************
+  * Introduction
+  *****************************************************************************************
+  * Serial protocol layer on top of the SGPIO driver, the protocol is described once and
+  * compiled at init, no register is touched per bit:
+  *		- transmit: the waveform of bit 0 and bit 1 is given as up to three level edges
+  *		  and a bit period. They are compiled to the two match register groups of the
+  *		  multiple timer, TXDATA[0] selects the group of each bit in hardware. MULMR0 ends
+  *		  the bit and shifts the data, MULMR1~3 drive the edges, and MUL_MCNT stops the
+  *		  timer after the last bit. The CPU only refills MULDATA_DP every 32 bits
+  *		- receive: the RX timer measures the line and each capture goes to an interrupt
+  *		  ring, either the interval between two edges into SGPIO_ProtoRxLevel or the width
+  *		  of a pulse at this level. A line idle for SGPIO_ProtoRxGapNs ends the frame
+  *		- decode: a lookup table turns a capture into an interval class, then a table of
+  *		  rules per decoder state and class gives the bits to emit and the next state,
+  *		  both are built or checked at init
+  *		- framing: start bits sent before the data, checked and stripped on receive, trail
+  *		  bits sent after the data, and the frame length or the gap ending a frame
+  *		- presets for Manchester, pulse width (one-wire like) and pulse distance codes
+  *
+  * The multiple timer drives the SGPIO pin and the RX timer samples it, on an open-drain
+  * bus the receiver also sees the frames sent. The SGPIO has no RX DMA request, the
+  * receive ring is filled by the interrupt handler, one entry per capture.
+  * Times are in ns, rounded to the timer tick: 500ns times the prescaler, which is set
+  * from the longest bit period or from the gap.
+  *
+  *****************************************************************************************
+  * How to use
+  *****************************************************************************************
+  *      1. Configure the SGPIO pinmux and pull the SGPIO pin up, as for the SGPIO driver.
+  *
+  *      2. Fill a SGPIO_ProtoInitTypeDef by SGPIO_ProtoStructInit(), then by one of the
+  *			presets or by hand, give the receive ring and call SGPIO_ProtoInit().
+  *
+  *      3. Call SGPIO_ProtoIRQHandler() from the SGPIO interrupt handler.
+  *
+  *      4. Send a frame by SGPIO_ProtoSend(), SGPIO_PROTO_EVT_TX_DONE tells when it is out.
+  *
+  *      5. Start the receiver by SGPIO_ProtoRxCmd(), then read the frames by
+  *			SGPIO_ProtoReceive() when SGPIO_PROTO_EVT_RX is signaled.
+  *
+  *****************************************************************************************
+  * @endverbatim
+  */
+
+/* Exported constants --------------------------------------------------------*/
+/** @defgroup SGPIO_Proto_Exported_Constants SGPIO_Proto Exported Constants
+  * @{
+  */
+
+#define SGPIO_PROTO_EDGE_MAX		3		/*!< MULMR1~3 */
+#define SGPIO_PROTO_BITS_MAX		255		/*!< MUL_MCNT, start and trail bits included */
+#define SGPIO_PROTO_WORD_MAX		((SGPIO_PROTO_BITS_MAX + 31) / 32)
+#define SGPIO_PROTO_CLASS_NUM		4
+#define SGPIO_PROTO_STATE_NUM		4
+#define SGPIO_PROTO_LUT_SIZE		128
+#define SGPIO_PROTO_CLK_NS			500		/*!< SGPIO clock 2MHz */
+
+/** @defgroup SGPIO_Proto_Rx_Mode
+  * @{
+  */
+#define SGPIO_PROTO_RX_NONE			0
+#define SGPIO_PROTO_RX_INTERVAL		1		/*!< time between two edges into SGPIO_ProtoRxLevel */
+#define SGPIO_PROTO_RX_WIDTH		2		/*!< width of a pulse at SGPIO_ProtoRxLevel */
+/** @} */
+
+/** @defgroup SGPIO_Proto_Rule_Action
+  * @{
+  */
+#define SGPIO_PROTO_ACT_ERR			0		/*!< invalid, the frame is dropped */
+#define SGPIO_PROTO_ACT_BITS		1		/*!< emit the bits */
+#define SGPIO_PROTO_ACT_SYNC		2		/*!< restart the frame, then emit the bits */
+#define SGPIO_PROTO_ACT_END			3		/*!< emit the bits, then end the frame */
+/** @} */
+
+/** @defgroup SGPIO_Proto_Event
+  * @{
+  */
+#define SGPIO_PROTO_EVT_TX_DONE		((u32)0x01)
+#define SGPIO_PROTO_EVT_RX			((u32)0x02)	/*!< gap seen, or SGPIO_ProtoRxFrameBits captures in width mode */
+/** @} */
+
+/** @} */
+
+/* Exported types ------------------------------------------------------------*/
+/** @defgroup SGPIO_Proto_Exported_Types SGPIO_Proto Exported Types
+  * @{
+  */
+
+/**
+  * @brief  SGPIO_Proto waveform of one bit value
+  */
+typedef struct {
+	u32 PeriodNs;
+	u32 EdgeNum;				/*!< 0 ~ SGPIO_PROTO_EDGE_MAX */
+	u32 EdgeNs[SGPIO_PROTO_EDGE_MAX];	/*!< from the bit start, increasing and below PeriodNs */
+	u8 Level[SGPIO_PROTO_EDGE_MAX];		/*!< level driven from the edge on, 0 or 1 */
+	u8 Rsvd;
+} SGPIO_ProtoSymTypeDef;
+
+/**
+  * @brief  SGPIO_Proto decoder rule, for one state and interval class
+  */
+typedef struct {
+	u8 Act;						/*!< @ref SGPIO_Proto_Rule_Action */
+	u8 Bits;					/*!< bits emitted, 0 ~ 8 */
+	u8 Value;					/*!< bits emitted, the first one in bit 0 */
+	u8 Next;					/*!< next decoder state */
+} SGPIO_ProtoRuleTypeDef;
+
+/**
+  * @brief  SGPIO_Proto statistics
+  */
+typedef struct {
+	u32 TxFrames;
+	u32 TxBits;					/*!< start and trail bits included */
+	u32 RxCaptures;
+	u32 RxFrames;
+	u32 RxErrors;				/*!< frames dropped by the decoder */
+	u32 RxOverflow;				/*!< captures lost to a full ring */
+} SGPIO_ProtoStatsTypeDef;
+
+/**
+  * @brief  SGPIO_Proto init structure definition
+  */
+typedef struct {
+	SGPIO_ProtoSymTypeDef SGPIO_ProtoSym[2];	/*!< waveform of bit 0 and bit 1 */
+	u32 SGPIO_ProtoIdle;		/*!< line level out of the frames, 0 or 1 */
+	u32 SGPIO_ProtoBiOut;		/*!< MUL_ENABLE_BIOUT for an open-drain bus */
+	u32 SGPIO_ProtoMsbFirst;	/*!< ENABLE to send bit 7 of each byte first */
+	u32 SGPIO_ProtoInvert;		/*!< ENABLE to invert the data bits on the line */
+	u8 SGPIO_ProtoStartBits;	/*!< 0 ~ 8, sent before the data, checked on receive */
+	u8 SGPIO_ProtoStartVal;		/*!< the first one in bit 0 */
+	u8 SGPIO_ProtoTrailBits;	/*!< 0 ~ 8, sent after the data */
+	u8 SGPIO_ProtoTrailVal;
+	u32 SGPIO_ProtoRxTrim;		/*!< bits dropped from the end of a decoded frame */
+	u32 SGPIO_ProtoRxMode;		/*!< @ref SGPIO_Proto_Rx_Mode */
+	u32 SGPIO_ProtoRxLevel;		/*!< 0 or 1 */
+	u32 SGPIO_ProtoRxClassNs[SGPIO_PROTO_CLASS_NUM];	/*!< nominal capture of each class, 0 if unused */
+	u32 SGPIO_ProtoRxTol;		/*!< class tolerance, percent of the nominal capture */
+	u32 SGPIO_ProtoRxGapNs;		/*!< idle line ending a frame, above all classes */
+	u32 SGPIO_ProtoRxFrameBits;	/*!< bits ending a frame, 0 for gap or rule delimited frames, not 0 in width mode */
+	SGPIO_ProtoRuleTypeDef SGPIO_ProtoRxFirst;	/*!< applied on the first edge, interval mode */
+	SGPIO_ProtoRuleTypeDef SGPIO_ProtoRxRule[SGPIO_PROTO_STATE_NUM][SGPIO_PROTO_CLASS_NUM];
+	u16 *SGPIO_ProtoRxBuf;
+	u32 SGPIO_ProtoRxNum;		/*!< ring size, power of 2 */
+	void (*SGPIO_ProtoCb)(void *Data, u32 Event);	/*!< optional, @ref SGPIO_Proto_Event, called in ISR */
+	void *SGPIO_ProtoCbData;
+} SGPIO_ProtoInitTypeDef;
+
+/**
+  * @brief  SGPIO_Proto instance
+  */
+typedef struct {
+	SGPIO_ProtoInitTypeDef Cfg;
+	SGPIO_TypeDef *SGPIOx;
+	u16 TxMr[2][4];				/*!< MULMR0~3 of group 0 and 1 */
+	u32 TxEmc;					/*!< MULMR1~3 output control */
+	u32 TxPr;
+	u32 TxWord[SGPIO_PROTO_WORD_MAX];
+	u32 TxWordNum;
+	u32 TxIdx;					/*!< next word for MULDATA_DP */
+	volatile u32 TxBusy;
+	u32 RxPr;
+	u32 RxGap;
+	u32 RxMin;					/*!< shortest capture of a class */
+	u32 RxShift;				/*!< capture to RxLut index */
+	u8 RxLut[SGPIO_PROTO_LUT_SIZE];	/*!< class of a capture */
+	u32 RxOn;
+	u32 RxDrop;					/*!< producer dropping captures until the next gap */
+	u32 RxCount;				/*!< captures since the last event, width mode */
+	u32 RxState;
+	u32 RxSkip;					/*!< decoder dropping captures until the next gap */
+	u32 RxCnt;					/*!< bits in RxWord */
+	u32 RxWord[SGPIO_PROTO_WORD_MAX];
+	volatile u32 Head;			/*!< written by the producer only */
+	volatile u32 Tail;			/*!< written by the consumer only */
+	SGPIO_ProtoStatsTypeDef Stats;
+} SGPIO_ProtoTypeDef;
+
+/** @} */
+
+/* Exported functions --------------------------------------------------------*/
+/** @defgroup SGPIO_Proto_Exported_Functions SGPIO_Proto Exported Functions
+  * @{
+  */
+void SGPIO_ProtoStructInit(SGPIO_ProtoInitTypeDef *SGPIO_ProtoInitStruct);
+void SGPIO_ProtoManchester(SGPIO_ProtoInitTypeDef *SGPIO_ProtoInitStruct, u32 BitNs);
+void SGPIO_ProtoPulseWidth(SGPIO_ProtoInitTypeDef *SGPIO_ProtoInitStruct, u32 BitNs, u32 ZeroNs, u32 OneNs, u32 Level);
+void SGPIO_ProtoPulseDistance(SGPIO_ProtoInitTypeDef *SGPIO_ProtoInitStruct, u32 MarkNs, u32 ZeroNs, u32 OneNs, u32 Level);
+int SGPIO_ProtoInit(SGPIO_ProtoTypeDef *proto, SGPIO_ProtoInitTypeDef *SGPIO_ProtoInitStruct);
+int SGPIO_ProtoSend(SGPIO_ProtoTypeDef *proto, const u8 *Data, u32 Bits);
+void SGPIO_ProtoRxCmd(SGPIO_ProtoTypeDef *proto, u32 NewState);
+void SGPIO_ProtoIRQHandler(SGPIO_ProtoTypeDef *proto);
+u32 SGPIO_ProtoReceive(SGPIO_ProtoTypeDef *proto, u8 *Buf, u32 Len);
+void SGPIO_ProtoGetStats(SGPIO_ProtoTypeDef *proto, SGPIO_ProtoStatsTypeDef *Stats);
+/** @} */
+
+/** @} */
+
+/** @} */
+
+#endif
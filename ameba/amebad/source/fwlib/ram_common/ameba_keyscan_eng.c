@@ -0,0 +1,423 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ameba_soc.h"
+
+static const char *const TAG = "KSENG";
+
+#define KS_ENG_FIFO_DEPTH		16
+#define KS_ENG_DRAIN_MAX		(KS_ENG_FIFO_DEPTH * 4)	/* bounds the drain loop of one interrupt */
+
+/* next set bit of a row, lowest first */
+#define KS_ENG_LOWEST(m)		(__CLZ(__RBIT(m)))
+
+static bool ks_eng_push(KeyScan_EngTypeDef *eng, u32 Row, u32 Col, u32 Press, u32 Now)
+{
+	u32 head = eng->Head;
+	KeyScan_EventTypeDef *evt;
+
+	if (head - eng->Tail >= eng->Cfg.KS_EngEvtNum) {
+		eng->Stats.QueueFull++;
+		return FALSE;
+	}
+
+	evt = &eng->Cfg.KS_EngEvtBuf[head & (eng->Cfg.KS_EngEvtNum - 1)];
+	evt->Row = Row;
+	evt->Col = Col;
+	evt->Press = Press;
+	evt->Rsvd = 0;
+	evt->Time = Now;
+
+	/* the entry shall be visible before the new head */
+	__DMB();
+	eng->Head = head + 1;
+	eng->Stats.Events++;
+
+	return TRUE;
+}
+
+/* bring the reported state to the debounced one, less the held back presses */
+static bool ks_eng_report(KeyScan_EngTypeDef *eng, u32 Now)
+{
+	u8 ghost[KS_ENG_ROW_MAX] = {0};
+	u32 r, r2, c, m, common, blocked;
+
+	if (eng->Cfg.KS_EngGhostFilter) {
+		/* two rows sharing two columns or more: the four corners are ambiguous */
+		for (r = 0; r < KS_ENG_ROW_MAX; r++) {
+			for (r2 = r + 1; r2 < KS_ENG_ROW_MAX; r2++) {
+				common = eng->Deb[r] & eng->Deb[r2];
+				if (common & (common - 1)) {
+					ghost[r] |= common;
+					ghost[r2] |= common;
+				}
+			}
+		}
+	}
+
+	/* releases first, they free rollover slots */
+	for (r = 0; r < KS_ENG_ROW_MAX; r++) {
+		m = eng->Rep[r] & ~eng->Deb[r];
+		while (m) {
+			c = KS_ENG_LOWEST(m);
+			if (!ks_eng_push(eng, r, c, 0, Now)) {
+				return FALSE;
+			}
+			eng->Rep[r] &= ~BIT(c);
+			eng->RepNum--;
+			m &= m - 1;
+		}
+	}
+
+	for (r = 0; r < KS_ENG_ROW_MAX; r++) {
+		m = eng->Deb[r] & ~eng->Rep[r];
+		blocked = m & ghost[r];
+		m &= ~ghost[r];
+
+		while (m) {
+			c = KS_ENG_LOWEST(m);
+			if (eng->Cfg.KS_EngMaxKeys && eng->RepNum >= eng->Cfg.KS_EngMaxKeys) {
+				blocked |= m;
+				break;
+			}
+			if (!ks_eng_push(eng, r, c, 1, Now)) {
+				return FALSE;
+			}
+			eng->Rep[r] |= BIT(c);
+			eng->RepNum++;
+			m &= m - 1;
+		}
+
+		/* count each press once when it gets held back */
+		m = blocked & ~eng->Blocked[r];
+		while (m) {
+			c = KS_ENG_LOWEST(m);
+			if (ghost[r] & BIT(c)) {
+				eng->Stats.Ghosts++;
+			} else {
+				eng->Stats.Rollover++;
+			}
+			m &= m - 1;
+		}
+		eng->Blocked[r] = blocked;
+	}
+
+	return TRUE;
+}
+
+/* one FIFO entry: track the hardware state and debounce the change */
+static void ks_eng_entry(KeyScan_EngTypeDef *eng, u32 Row, u32 Col, u32 Press, u32 Now)
+{
+	u32 bit = BIT(Col);
+	u32 k, prof;
+
+	if (Row >= KS_ENG_ROW_MAX || Col >= KS_ENG_COL_MAX) {
+		return;
+	}
+
+	k = Row * KS_ENG_COL_MAX + Col;
+	prof = eng->Prof[k];
+
+	if (((eng->Hw[Row] & bit) != 0) == (Press != 0)) {
+		return;
+	}
+	eng->Hw[Row] ^= bit;
+
+	switch (eng->Cfg.KS_EngProf[prof].Mode) {
+	case KS_ENG_DEB_DEFER:
+		/* the stable window restarts on every change, ks_eng_update() commits */
+		if (((eng->Hw[Row] ^ eng->Deb[Row]) & bit) == 0) {
+			eng->Stats.Bounces++;
+		}
+		eng->Stamp[k] = Now;
+		return;
+
+	case KS_ENG_DEB_EAGER:
+		if (Now - eng->Stamp[k] < eng->DebTicks[prof]) {
+			/* inside the lockout, ks_eng_update() commits the final state */
+			eng->Stats.Bounces++;
+			return;
+		}
+		break;
+
+	default:
+		break;
+	}
+
+	eng->Deb[Row] ^= bit;
+	eng->Stamp[k] = Now;
+
+	/* report at once, without software debounce a tap drained in one batch gives its press
+	   and its release. With KS_ENG_DEB_EAGER the release falls in the lockout of the press,
+	   ks_eng_update() reports it once the profile time elapsed */
+	ks_eng_report(eng, Now);
+}
+
+/* commit the debounce windows elapsed, return TRUE while something is pending */
+static bool ks_eng_update(KeyScan_EngTypeDef *eng, u32 Now)
+{
+	bool pending = FALSE;
+	u32 r, c, k, m, prof;
+
+	for (r = 0; r < KS_ENG_ROW_MAX; r++) {
+		m = eng->Hw[r] ^ eng->Deb[r];
+		while (m) {
+			c = KS_ENG_LOWEST(m);
+			k = r * KS_ENG_COL_MAX + c;
+			prof = eng->Prof[k];
+
+			if (Now - eng->Stamp[k] >= eng->DebTicks[prof]) {
+				eng->Deb[r] ^= BIT(c);
+				if (eng->Cfg.KS_EngProf[prof].Mode == KS_ENG_DEB_EAGER) {
+					eng->Stamp[k] = Now;
+				}
+			} else {
+				pending = TRUE;
+			}
+			m &= m - 1;
+		}
+	}
+
+	if (!ks_eng_report(eng, Now)) {
+		pending = TRUE;
+	}
+
+	return pending;
+}
+
+/* the scan finish interrupt drives the pending work, and only it */
+static void ks_eng_finish_int(KeyScan_EngTypeDef *eng, bool Pending)
+{
+	if (Pending == (eng->FinishOn != 0)) {
+		return;
+	}
+
+	if (Pending) {
+		KeyScan_ClearINT(eng->KeyScan, BIT_KS_SCAN_FINISH_INT_CLR);
+	}
+	KeyScan_INTConfig(eng->KeyScan, BIT_KS_SCAN_FINISH_INT_MSK, Pending ? ENABLE : DISABLE);
+	eng->FinishOn = Pending;
+}
+
+/**
+  * @brief  Fills each KeyScan_EngInitStruct member with its default value.
+  * @param  KeyScan_EngInitStruct: pointer to a KeyScan_EngInitTypeDef structure.
+  * @retval None
+  */
+void KeyScan_EngStructInit(KeyScan_EngInitTypeDef *KeyScan_EngInitStruct)
+{
+	_memset((void *)KeyScan_EngInitStruct, 0, sizeof(KeyScan_EngInitTypeDef));
+
+	KeyScan_EngInitStruct->KS_EngProf[0].Mode = KS_ENG_DEB_EAGER;
+	KeyScan_EngInitStruct->KS_EngProf[0].Ms = 5;
+	KeyScan_EngInitStruct->KS_EngGhostFilter = ENABLE;
+}
+
+/**
+  * @brief  Initializes the KeyScan event engine and enables the KeyScan interrupts it uses.
+  * @param  eng: engine instance.
+  * @param  KeyScan_EngInitStruct: pointer to a KeyScan_EngInitTypeDef structure.
+  * @retval RTK_SUCCESS or RTK_ERR_BADARG.
+  * @note   The KeyScan shall be initialized by KeyScan_Init() before.
+  */
+int KeyScan_EngInit(KeyScan_EngTypeDef *eng, KeyScan_EngInitTypeDef *KeyScan_EngInitStruct)
+{
+	u32 num = KeyScan_EngInitStruct->KS_EngEvtNum;
+	u32 i;
+
+	if (KeyScan_EngInitStruct->KS_EngEvtBuf == NULL || num == 0 || (num & (num - 1))) {
+		RTK_LOGE(TAG, "Event queue shall be a power of 2\n");
+		return RTK_ERR_BADARG;
+	}
+
+	for (i = 0; i < KS_ENG_PROF_NUM; i++) {
+		if (KeyScan_EngInitStruct->KS_EngProf[i].Mode > KS_ENG_DEB_DEFER) {
+			RTK_LOGE(TAG, "Invalid debounce profile\n");
+			return RTK_ERR_BADARG;
+		}
+	}
+
+	_memset((void *)eng, 0, sizeof(KeyScan_EngTypeDef));
+	eng->Cfg = *KeyScan_EngInitStruct;
+	eng->KeyScan = KEYSCAN_DEV;
+
+	for (i = 0; i < KS_ENG_PROF_NUM; i++) {
+		if (eng->Cfg.KS_EngProf[i].Mode != KS_ENG_DEB_NONE) {
+			eng->DebTicks[i] = (eng->Cfg.KS_EngProf[i].Ms * KS_ENG_TICK_HZ + 999) / 1000;
+		}
+	}
+
+	/* no lockout on the first change of a key */
+	for (i = 0; i < KS_ENG_KEY_MAX; i++) {
+		eng->Stamp[i] = SYSTIMER_TickGet() - eng->DebTicks[0];
+	}
+
+	KeyScan_ClearFIFOData(eng->KeyScan);
+	KeyScan_ClearINT(eng->KeyScan, BIT_KS_ALL_INT_CLR);
+	KeyScan_INTConfig(eng->KeyScan, BIT_KS_ALL_INT_MSK, DISABLE);
+	KeyScan_INTConfig(eng->KeyScan, BIT_KS_SCAN_EVENT_INT_MSK | BIT_KS_FIFO_OVERFLOW_INT_MSK |
+					  BIT_KS_ALL_RELEASE_INT_MSK, ENABLE);
+
+	return RTK_SUCCESS;
+}
+
+/**
+  * @brief  Selects the debounce profile of one key.
+  * @param  eng: engine instance.
+  * @param  Row: key row.
+  * @param  Col: key column.
+  * @param  Prof: profile index, 0 ~ KS_ENG_PROF_NUM - 1.
+  * @retval RTK_SUCCESS or RTK_ERR_BADARG.
+  */
+int KeyScan_EngSetProfile(KeyScan_EngTypeDef *eng, u32 Row, u32 Col, u32 Prof)
+{
+	u32 PrevStatus;
+	u32 k;
+
+	if (Row >= KS_ENG_ROW_MAX || Col >= KS_ENG_COL_MAX || Prof >= KS_ENG_PROF_NUM) {
+		return RTK_ERR_BADARG;
+	}
+
+	k = Row * KS_ENG_COL_MAX + Col;
+
+	PrevStatus = __get_PRIMASK();
+	__disable_irq();
+	eng->Prof[k] = Prof;
+	eng->Stamp[k] = SYSTIMER_TickGet() - eng->DebTicks[Prof];
+	__set_PRIMASK(PrevStatus);
+
+	return RTK_SUCCESS;
+}
+
+/**
+  * @brief  Drains the KeyScan FIFO and queues the resulting key events.
+  * @param  eng: engine instance.
+  * @retval None
+  * @note   Called from the KeyScan interrupt handler.
+  */
+void KeyScan_EngIRQHandler(KeyScan_EngTypeDef *eng)
+{
+	KEYSCAN_TypeDef *KeyScan = eng->KeyScan;
+	u32 buf[KS_ENG_FIFO_DEPTH];
+	u32 head = eng->Head;
+	u32 now = SYSTIMER_TickGet();
+	u32 isr = KeyScan_GetINT(KeyScan);
+	u32 total = 0;
+	u32 num, i, r, m;
+
+	eng->Stats.Irqs++;
+
+	if (isr & BIT_KS_FIFO_OVERFLOW_INT_STATUS) {
+		eng->Stats.FifoOverflow++;
+	}
+
+	/* read the FIFO in bursts, entries arriving meanwhile are taken too */
+	while ((num = KeyScan_GetDataNum(KeyScan)) != 0 && total < KS_ENG_DRAIN_MAX) {
+		num = MIN(num, KS_ENG_FIFO_DEPTH);
+		KeyScan_Read(KeyScan, buf, num);
+
+		for (i = 0; i < num; i++) {
+			ks_eng_entry(eng, (buf[i] & BIT_KS_ROW_INDEX) >> 4, buf[i] & BIT_KS_COL_INDEX,
+						 buf[i] & BIT_KS_PRESS_EVENT, now);
+		}
+		total += num;
+	}
+
+	eng->Stats.Entries += total;
+	eng->Stats.BatchMax = MAX(eng->Stats.BatchMax, total);
+
+	/* the hardware saw every key up after its own release time, drop at once what a
+	   lost release left pressed, held back presses shall not get reported meanwhile */
+	if (isr & BIT_KS_ALL_RELEASE_INT_STATUS) {
+		for (r = 0; r < KS_ENG_ROW_MAX; r++) {
+			for (m = eng->Hw[r]; m; m &= m - 1) {
+				eng->Stats.Resyncs++;
+			}
+			eng->Hw[r] = 0;
+			eng->Deb[r] = 0;
+		}
+	}
+
+	KeyScan_ClearINT(KeyScan, isr & (BIT_KS_FIFO_LIMIT_INT_STATUS | BIT_KS_FIFO_OVERFLOW_INT_STATUS |
+									 BIT_KS_SCAN_FINISH_INT_STATUS | BIT_KS_ALL_RELEASE_INT_STATUS));
+
+	ks_eng_finish_int(eng, ks_eng_update(eng, now));
+
+	if (eng->Head != head && eng->Cfg.KS_EngCb) {
+		eng->Cfg.KS_EngCb(eng->Cfg.KS_EngCbData);
+	}
+}
+
+/**
+  * @brief  Commits the debounce windows elapsed and queues the events kept back.
+  * @param  eng: engine instance.
+  * @retval None
+  * @note   Needed in event trigger mode, which has no scan finish interrupt when idle,
+  *         and after the consumer emptied a full queue.
+  */
+void KeyScan_EngPoll(KeyScan_EngTypeDef *eng)
+{
+	u32 PrevStatus = __get_PRIMASK();
+
+	__disable_irq();
+	ks_eng_finish_int(eng, ks_eng_update(eng, SYSTIMER_TickGet()));
+	__set_PRIMASK(PrevStatus);
+}
+
+/**
+  * @brief  Takes the oldest event from the queue.
+  * @param  eng: engine instance.
+  * @param  Evt: pointer to the event copy.
+  * @retval TRUE when an event was taken, FALSE when the queue is empty.
+  * @note   Lock-free, to be called by a single consumer.
+  */
+bool KeyScan_EngGetEvent(KeyScan_EngTypeDef *eng, KeyScan_EventTypeDef *Evt)
+{
+	u32 tail = eng->Tail;
+
+	if (tail == eng->Head) {
+		return FALSE;
+	}
+
+	/* read the entry after the head it was published with */
+	__DMB();
+	*Evt = eng->Cfg.KS_EngEvtBuf[tail & (eng->Cfg.KS_EngEvtNum - 1)];
+	__DMB();
+	eng->Tail = tail + 1;
+
+	return TRUE;
+}
+
+/**
+  * @brief  Gets the reported key matrix.
+  * @param  eng: engine instance.
+  * @param  Matrix: KS_ENG_ROW_MAX bytes, bit c of byte r set when key (r, c) is pressed.
+  * @retval None
+  */
+void KeyScan_EngGetState(KeyScan_EngTypeDef *eng, u8 *Matrix)
+{
+	u32 PrevStatus = __get_PRIMASK();
+
+	__disable_irq();
+	_memcpy(Matrix, eng->Rep, KS_ENG_ROW_MAX);
+	__set_PRIMASK(PrevStatus);
+}
+
+/**
+  * @brief  Gets a snapshot of the engine statistics.
+  * @param  eng: engine instance.
+  * @param  Stats: pointer to the statistics copy.
+  * @retval None
+  */
+void KeyScan_EngGetStats(KeyScan_EngTypeDef *eng, KeyScan_EngStatsTypeDef *Stats)
+{
+	u32 PrevStatus = __get_PRIMASK();
+
+	__disable_irq();
+	*Stats = eng->Stats;
+	__set_PRIMASK(PrevStatus);
+}
+/******************* (C) COPYRIGHT 2024 Realtek Semiconductor *****END OF FILE****/
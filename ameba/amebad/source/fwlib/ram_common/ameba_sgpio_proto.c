@@ -0,0 +1,783 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ameba_soc.h"
+
+static const char *const TAG = "SGPROTO";
+
+#define SGPIO_PROTO_TICK_MAX		0xFFFD	/* 0xFFFE and 0xFFFF mark the ring */
+#define SGPIO_PROTO_MARK_ERR		0xFFFE	/* captures were lost before this gap */
+#define SGPIO_PROTO_MARK_GAP		0xFFFF
+#define SGPIO_PROTO_CLASS_BAD		0xFF
+#define SGPIO_PROTO_STATE_START		0xFF	/* waiting for the first edge of a frame */
+#define SGPIO_PROTO_NEVER			0xFFFF	/* MULMRx beyond MULMR0, never matches */
+
+/* Manchester decoder states, on the falling edges */
+#define SGPIO_PROTO_MAN_MID			0		/* last edge in the middle of a 1 */
+#define SGPIO_PROTO_MAN_BOUND		1		/* last edge between two 0 */
+
+static u32 sgpio_proto_pr(u32 MaxNs, u32 MaxTicks)
+{
+	return MaxNs / (SGPIO_PROTO_CLK_NS * MaxTicks);
+}
+
+static u32 sgpio_proto_ticks(u32 Ns, u32 Pr)
+{
+	u32 tick = SGPIO_PROTO_CLK_NS * (Pr + 1);
+
+	return (Ns + tick / 2) / tick;
+}
+
+/* Word shall be cleared beforehand and Val fit in Num bits */
+static void sgpio_proto_put(u32 *Word, u32 Pos, u32 Val, u32 Num)
+{
+	u32 sft = Pos % 32;
+
+	Word[Pos / 32] |= Val << sft;
+	if (sft + Num > 32) {
+		Word[Pos / 32 + 1] |= Val >> (32 - sft);
+	}
+}
+
+static u32 sgpio_proto_get(const u32 *Word, u32 Pos, u32 Num)
+{
+	u32 sft = Pos % 32;
+	u32 val = Word[Pos / 32] >> sft;
+
+	if (sft + Num > 32) {
+		val |= Word[Pos / 32 + 1] << (32 - sft);
+	}
+
+	return val & (BIT(Num) - 1);
+}
+
+/* data byte to line bits, the first one in bit 0, and back */
+static u32 sgpio_proto_line(SGPIO_ProtoTypeDef *proto, u32 Val)
+{
+	if (proto->Cfg.SGPIO_ProtoInvert) {
+		Val ^= 0xFF;
+	}
+
+	if (proto->Cfg.SGPIO_ProtoMsbFirst) {
+		Val = __RBIT(Val) >> 24;
+	}
+
+	return Val;
+}
+
+/* assign the edges of both bit values to MULMR1~3: the output control of a match
+ * register is shared by both groups, only the match values differ, so each level
+ * gets as many match registers as the bit value having the most edges to it */
+static int sgpio_proto_compile(SGPIO_ProtoTypeDef *proto)
+{
+	SGPIO_ProtoSymTypeDef *sym;
+	u32 low = 0, high = 0;
+	u32 s, e, n, t, mr, period, last, maxns = 0;
+	u32 next[2];
+
+	for (s = 0; s < 2; s++) {
+		sym = &proto->Cfg.SGPIO_ProtoSym[s];
+		if (sym->EdgeNum > SGPIO_PROTO_EDGE_MAX || sym->PeriodNs == 0) {
+			return RTK_ERR_BADARG;
+		}
+
+		for (e = 0, n = 0; e < sym->EdgeNum; e++) {
+			if (sym->Level[e] > 1) {
+				return RTK_ERR_BADARG;
+			}
+			n += sym->Level[e];
+		}
+
+		low = MAX(low, sym->EdgeNum - n);
+		high = MAX(high, n);
+		maxns = MAX(maxns, sym->PeriodNs);
+	}
+
+	if (low + high > SGPIO_PROTO_EDGE_MAX) {
+		return RTK_ERR_BADARG;
+	}
+
+	for (mr = 1; mr <= low + high; mr++) {
+		proto->TxEmc |= (mr <= low ? MUL_EMC1_OUTPUT_LOW : MUL_EMC1_OUTPUT_HIGH) << ((mr - 1) * 2);
+	}
+
+	proto->TxPr = sgpio_proto_pr(maxns, SGPIO_PROTO_NEVER - 1);
+
+	for (s = 0; s < 2; s++) {
+		sym = &proto->Cfg.SGPIO_ProtoSym[s];
+		period = sgpio_proto_ticks(sym->PeriodNs, proto->TxPr);
+		if (period < 2) {
+			return RTK_ERR_BADARG;
+		}
+
+		proto->TxMr[s][0] = period - 1;
+		for (mr = 1; mr <= SGPIO_PROTO_EDGE_MAX; mr++) {
+			proto->TxMr[s][mr] = SGPIO_PROTO_NEVER;
+		}
+
+		next[0] = 1;
+		next[1] = 1 + low;
+		last = 0;
+		for (e = 0; e < sym->EdgeNum; e++) {
+			t = sgpio_proto_ticks(sym->EdgeNs[e], proto->TxPr);
+			/* edges merged by the rounding would lose their order */
+			if ((e && t <= last) || t >= period) {
+				return RTK_ERR_BADARG;
+			}
+			last = t;
+			proto->TxMr[s][next[sym->Level[e]]++] = t;
+		}
+	}
+
+	return RTK_SUCCESS;
+}
+
+/* capture to class table, nearest nominal capture within the tolerance */
+static int sgpio_proto_lut(SGPIO_ProtoTypeDef *proto)
+{
+	SGPIO_ProtoInitTypeDef *cfg = &proto->Cfg;
+	u32 nom[SGPIO_PROTO_CLASS_NUM];
+	u32 c, i, t, d, best, bestd, hi = 0;
+
+	proto->RxPr = sgpio_proto_pr(cfg->SGPIO_ProtoRxGapNs, SGPIO_PROTO_TICK_MAX);
+	proto->RxGap = sgpio_proto_ticks(cfg->SGPIO_ProtoRxGapNs, proto->RxPr);
+	proto->RxMin = SGPIO_PROTO_TICK_MAX;
+
+	for (c = 0; c < SGPIO_PROTO_CLASS_NUM; c++) {
+		nom[c] = sgpio_proto_ticks(cfg->SGPIO_ProtoRxClassNs[c], proto->RxPr);
+		if (nom[c] == 0) {
+			continue;
+		}
+		hi = MAX(hi, nom[c] + nom[c] * cfg->SGPIO_ProtoRxTol / 100);
+		proto->RxMin = MIN(proto->RxMin, MAX(nom[c] - nom[c] * cfg->SGPIO_ProtoRxTol / 100, 1));
+	}
+
+	if (hi == 0 || hi >= proto->RxGap) {
+		return RTK_ERR_BADARG;
+	}
+
+	while ((hi >> proto->RxShift) >= SGPIO_PROTO_LUT_SIZE) {
+		proto->RxShift++;
+	}
+
+	for (i = 0; i < SGPIO_PROTO_LUT_SIZE; i++) {
+		t = (i << proto->RxShift) + (BIT(proto->RxShift) >> 1);
+		best = SGPIO_PROTO_CLASS_BAD;
+		bestd = 0xFFFFFFFF;
+
+		for (c = 0; c < SGPIO_PROTO_CLASS_NUM; c++) {
+			if (nom[c] == 0) {
+				continue;
+			}
+			d = t > nom[c] ? t - nom[c] : nom[c] - t;
+			if (d * 100 <= nom[c] * cfg->SGPIO_ProtoRxTol && d < bestd) {
+				best = c;
+				bestd = d;
+			}
+		}
+
+		proto->RxLut[i] = best;
+	}
+
+	return RTK_SUCCESS;
+}
+
+static bool sgpio_proto_rule_ok(SGPIO_ProtoRuleTypeDef *rule)
+{
+	return rule->Act > SGPIO_PROTO_ACT_END ? FALSE :
+		   rule->Act == SGPIO_PROTO_ACT_ERR ? TRUE :
+		   rule->Bits <= 8 && rule->Next < SGPIO_PROTO_STATE_NUM;
+}
+
+static void sgpio_proto_set_rule(SGPIO_ProtoRuleTypeDef *Rule, u32 Act, u32 Bits, u32 Value, u32 Next)
+{
+	Rule->Act = Act;
+	Rule->Bits = Bits;
+	Rule->Value = Value;
+	Rule->Next = Next;
+}
+
+/**
+  * @brief  Fill each SGPIO_ProtoInitTypeDef member with its default value.
+  * @param  SGPIO_ProtoInitStruct: pointer to a SGPIO_ProtoInitTypeDef structure.
+  * @retval None
+  * @note   The defaults describe no protocol, use a preset or fill the waveforms.
+  */
+void SGPIO_ProtoStructInit(SGPIO_ProtoInitTypeDef *SGPIO_ProtoInitStruct)
+{
+	_memset((void *)SGPIO_ProtoInitStruct, 0, sizeof(SGPIO_ProtoInitTypeDef));
+	SGPIO_ProtoInitStruct->SGPIO_ProtoIdle = 1;
+	SGPIO_ProtoInitStruct->SGPIO_ProtoBiOut = MUL_DISABLE_BIOUT;
+	SGPIO_ProtoInitStruct->SGPIO_ProtoRxTol = 25;
+}
+
+/**
+  * @brief  Describe Manchester code, 1 is high then low, idle high.
+  * @param  SGPIO_ProtoInitStruct: pointer to a SGPIO_ProtoInitTypeDef structure.
+  * @param  BitNs: bit period.
+  * @retval None
+  * @note   A start bit 1 gives the decoder its first falling edge in the middle of a bit, a
+  *         trail bit 1 flushes the last data bits. Both are stripped on receive. Set
+  *         SGPIO_ProtoInvert for the IEEE 802.3 convention.
+  */
+void SGPIO_ProtoManchester(SGPIO_ProtoInitTypeDef *SGPIO_ProtoInitStruct, u32 BitNs)
+{
+	SGPIO_ProtoInitTypeDef *cfg = SGPIO_ProtoInitStruct;
+	u32 s;
+
+	for (s = 0; s < 2; s++) {
+		cfg->SGPIO_ProtoSym[s].PeriodNs = BitNs;
+		cfg->SGPIO_ProtoSym[s].EdgeNum = 2;
+		cfg->SGPIO_ProtoSym[s].EdgeNs[0] = 0;
+		cfg->SGPIO_ProtoSym[s].EdgeNs[1] = BitNs / 2;
+		cfg->SGPIO_ProtoSym[s].Level[0] = s;
+		cfg->SGPIO_ProtoSym[s].Level[1] = !s;
+	}
+
+	cfg->SGPIO_ProtoIdle = 1;
+	cfg->SGPIO_ProtoStartBits = 1;
+	cfg->SGPIO_ProtoStartVal = 1;
+	cfg->SGPIO_ProtoTrailBits = 1;
+	cfg->SGPIO_ProtoTrailVal = 1;
+	cfg->SGPIO_ProtoRxTrim = 1;
+
+	/* falling edges: in the middle of a 1 and between two 0, 1, 1.5 or 2 bits apart */
+	cfg->SGPIO_ProtoRxMode = SGPIO_PROTO_RX_INTERVAL;
+	cfg->SGPIO_ProtoRxLevel = 0;
+	cfg->SGPIO_ProtoRxClassNs[0] = BitNs;
+	cfg->SGPIO_ProtoRxClassNs[1] = BitNs + BitNs / 2;
+	cfg->SGPIO_ProtoRxClassNs[2] = BitNs * 2;
+	cfg->SGPIO_ProtoRxClassNs[3] = 0;
+	cfg->SGPIO_ProtoRxGapNs = BitNs * 4;
+	cfg->SGPIO_ProtoRxFrameBits = 0;
+	_memset((void *)cfg->SGPIO_ProtoRxRule, 0, sizeof(cfg->SGPIO_ProtoRxRule));
+
+	sgpio_proto_set_rule(&cfg->SGPIO_ProtoRxFirst, SGPIO_PROTO_ACT_BITS, 1, 0x1, SGPIO_PROTO_MAN_MID);
+	sgpio_proto_set_rule(&cfg->SGPIO_ProtoRxRule[SGPIO_PROTO_MAN_MID][0], SGPIO_PROTO_ACT_BITS, 1, 0x1, SGPIO_PROTO_MAN_MID);
+	sgpio_proto_set_rule(&cfg->SGPIO_ProtoRxRule[SGPIO_PROTO_MAN_MID][1], SGPIO_PROTO_ACT_BITS, 2, 0x0, SGPIO_PROTO_MAN_BOUND);
+	sgpio_proto_set_rule(&cfg->SGPIO_ProtoRxRule[SGPIO_PROTO_MAN_MID][2], SGPIO_PROTO_ACT_BITS, 2, 0x2, SGPIO_PROTO_MAN_MID);
+	sgpio_proto_set_rule(&cfg->SGPIO_ProtoRxRule[SGPIO_PROTO_MAN_BOUND][0], SGPIO_PROTO_ACT_BITS, 1, 0x0, SGPIO_PROTO_MAN_BOUND);
+	sgpio_proto_set_rule(&cfg->SGPIO_ProtoRxRule[SGPIO_PROTO_MAN_BOUND][1], SGPIO_PROTO_ACT_BITS, 1, 0x1, SGPIO_PROTO_MAN_MID);
+}
+
+/**
+  * @brief  Describe a pulse width code: each bit begins with a pulse at Level whose width
+  *         gives the bit value, then the line is idle up to the bit period.
+  * @param  SGPIO_ProtoInitStruct: pointer to a SGPIO_ProtoInitTypeDef structure.
+  * @param  BitNs: bit period.
+  * @param  ZeroNs: pulse width of bit 0.
+  * @param  OneNs: pulse width of bit 1.
+  * @param  Level: pulse level, 0 for a one-wire bus.
+  * @retval None
+  * @note   The RX timer only runs during the pulses, frames end after
+  *         SGPIO_ProtoRxFrameBits bits, to be set by the caller, SGPIO_ProtoInit()
+  *         rejects 0.
+  */
+void SGPIO_ProtoPulseWidth(SGPIO_ProtoInitTypeDef *SGPIO_ProtoInitStruct, u32 BitNs, u32 ZeroNs, u32 OneNs, u32 Level)
+{
+	SGPIO_ProtoInitTypeDef *cfg = SGPIO_ProtoInitStruct;
+	u32 s;
+
+	for (s = 0; s < 2; s++) {
+		cfg->SGPIO_ProtoSym[s].PeriodNs = BitNs;
+		cfg->SGPIO_ProtoSym[s].EdgeNum = 2;
+		cfg->SGPIO_ProtoSym[s].EdgeNs[0] = 0;
+		cfg->SGPIO_ProtoSym[s].EdgeNs[1] = s ? OneNs : ZeroNs;
+		cfg->SGPIO_ProtoSym[s].Level[0] = Level;
+		cfg->SGPIO_ProtoSym[s].Level[1] = !Level;
+	}
+
+	cfg->SGPIO_ProtoIdle = !Level;
+	cfg->SGPIO_ProtoRxMode = SGPIO_PROTO_RX_WIDTH;
+	cfg->SGPIO_ProtoRxLevel = Level;
+	cfg->SGPIO_ProtoRxClassNs[0] = ZeroNs;
+	cfg->SGPIO_ProtoRxClassNs[1] = OneNs;
+	cfg->SGPIO_ProtoRxClassNs[2] = 0;
+	cfg->SGPIO_ProtoRxClassNs[3] = 0;
+	cfg->SGPIO_ProtoRxGapNs = BitNs * 2;
+	_memset((void *)cfg->SGPIO_ProtoRxRule, 0, sizeof(cfg->SGPIO_ProtoRxRule));
+
+	sgpio_proto_set_rule(&cfg->SGPIO_ProtoRxFirst, SGPIO_PROTO_ACT_BITS, 0, 0, 0);
+	for (s = 0; s < 2; s++) {
+		sgpio_proto_set_rule(&cfg->SGPIO_ProtoRxRule[0][s], SGPIO_PROTO_ACT_BITS, 1, s, 0);
+	}
+}
+
+/**
+  * @brief  Describe a pulse distance code: each bit begins with a mark at Level, the time
+  *         to the next mark gives the bit value.
+  * @param  SGPIO_ProtoInitStruct: pointer to a SGPIO_ProtoInitTypeDef structure.
+  * @param  MarkNs: mark width.
+  * @param  ZeroNs: bit period of bit 0, mark included.
+  * @param  OneNs: bit period of bit 1, mark included.
+  * @param  Level: mark level.
+  * @retval None
+  * @note   A trail bit 0 sends the mark closing the last bit. A leader can be added as
+  *         one more class whose rules restart the frame by SGPIO_PROTO_ACT_SYNC.
+  */
+void SGPIO_ProtoPulseDistance(SGPIO_ProtoInitTypeDef *SGPIO_ProtoInitStruct, u32 MarkNs, u32 ZeroNs, u32 OneNs, u32 Level)
+{
+	SGPIO_ProtoInitTypeDef *cfg = SGPIO_ProtoInitStruct;
+	u32 s;
+
+	for (s = 0; s < 2; s++) {
+		cfg->SGPIO_ProtoSym[s].PeriodNs = s ? OneNs : ZeroNs;
+		cfg->SGPIO_ProtoSym[s].EdgeNum = 2;
+		cfg->SGPIO_ProtoSym[s].EdgeNs[0] = 0;
+		cfg->SGPIO_ProtoSym[s].EdgeNs[1] = MarkNs;
+		cfg->SGPIO_ProtoSym[s].Level[0] = Level;
+		cfg->SGPIO_ProtoSym[s].Level[1] = !Level;
+	}
+
+	cfg->SGPIO_ProtoIdle = !Level;
+	cfg->SGPIO_ProtoTrailBits = 1;
+	cfg->SGPIO_ProtoTrailVal = 0;
+	cfg->SGPIO_ProtoRxTrim = 0;
+	cfg->SGPIO_ProtoRxMode = SGPIO_PROTO_RX_INTERVAL;
+	cfg->SGPIO_ProtoRxLevel = Level;
+	cfg->SGPIO_ProtoRxClassNs[0] = ZeroNs;
+	cfg->SGPIO_ProtoRxClassNs[1] = OneNs;
+	cfg->SGPIO_ProtoRxClassNs[2] = 0;
+	cfg->SGPIO_ProtoRxClassNs[3] = 0;
+	cfg->SGPIO_ProtoRxGapNs = MAX(ZeroNs, OneNs) * 2;
+	cfg->SGPIO_ProtoRxFrameBits = 0;
+	_memset((void *)cfg->SGPIO_ProtoRxRule, 0, sizeof(cfg->SGPIO_ProtoRxRule));
+
+	sgpio_proto_set_rule(&cfg->SGPIO_ProtoRxFirst, SGPIO_PROTO_ACT_BITS, 0, 0, 0);
+	for (s = 0; s < 2; s++) {
+		sgpio_proto_set_rule(&cfg->SGPIO_ProtoRxRule[0][s], SGPIO_PROTO_ACT_BITS, 1, s, 0);
+	}
+}
+
+/**
+  * @brief  Compile the protocol and set the multiple timer up, the receiver stays off.
+  * @param  proto: protocol instance.
+  * @param  SGPIO_ProtoInitStruct: pointer to a SGPIO_ProtoInitTypeDef structure.
+  * @retval RTK_SUCCESS or RTK_ERR_BADARG.
+  */
+int SGPIO_ProtoInit(SGPIO_ProtoTypeDef *proto, SGPIO_ProtoInitTypeDef *SGPIO_ProtoInitStruct)
+{
+	SGPIO_ProtoInitTypeDef *cfg = SGPIO_ProtoInitStruct;
+	SGPIO_MULInitTypeDef MulInit;
+	SGPIO_TypeDef *SGPIOx = SGPIO_DEV;
+	u32 num = cfg->SGPIO_ProtoRxNum;
+	u32 s, c;
+
+	if (cfg->SGPIO_ProtoStartBits > 8 || cfg->SGPIO_ProtoTrailBits > 8 || cfg->SGPIO_ProtoRxTrim > 8 ||
+		cfg->SGPIO_ProtoIdle > 1 || cfg->SGPIO_ProtoRxMode > SGPIO_PROTO_RX_WIDTH) {
+		RTK_LOGE(TAG, "Invalid framing\n");
+		return RTK_ERR_BADARG;
+	}
+
+	if (cfg->SGPIO_ProtoRxMode != SGPIO_PROTO_RX_NONE) {
+		if (cfg->SGPIO_ProtoRxBuf == NULL || num == 0 || (num & (num - 1)) ||
+			cfg->SGPIO_ProtoRxTol == 0 || cfg->SGPIO_ProtoRxTol > 50 || cfg->SGPIO_ProtoRxLevel > 1 ||
+			cfg->SGPIO_ProtoRxFrameBits > SGPIO_PROTO_BITS_MAX || !sgpio_proto_rule_ok(&cfg->SGPIO_ProtoRxFirst)) {
+			RTK_LOGE(TAG, "Invalid receiver config\n");
+			return RTK_ERR_BADARG;
+		}
+
+		/* the width mode timer only runs during the pulses, no gap ends a frame */
+		if (cfg->SGPIO_ProtoRxMode == SGPIO_PROTO_RX_WIDTH && cfg->SGPIO_ProtoRxFrameBits == 0) {
+			RTK_LOGE(TAG, "Width mode needs frame bits\n");
+			return RTK_ERR_BADARG;
+		}
+
+		for (s = 0; s < SGPIO_PROTO_STATE_NUM; s++) {
+			for (c = 0; c < SGPIO_PROTO_CLASS_NUM; c++) {
+				if (!sgpio_proto_rule_ok(&cfg->SGPIO_ProtoRxRule[s][c])) {
+					RTK_LOGE(TAG, "Invalid decoder rule\n");
+					return RTK_ERR_BADARG;
+				}
+			}
+		}
+	}
+
+	_memset((void *)proto, 0, sizeof(SGPIO_ProtoTypeDef));
+	proto->Cfg = *cfg;
+	proto->SGPIOx = SGPIOx;
+	proto->RxState = SGPIO_PROTO_STATE_START;
+
+	if (sgpio_proto_compile(proto) != RTK_SUCCESS) {
+		RTK_LOGE(TAG, "Waveform not supported by the match registers\n");
+		return RTK_ERR_BADARG;
+	}
+
+	if (cfg->SGPIO_ProtoRxMode != SGPIO_PROTO_RX_NONE && sgpio_proto_lut(proto) != RTK_SUCCESS) {
+		RTK_LOGE(TAG, "Classes shall be below the gap\n");
+		return RTK_ERR_BADARG;
+	}
+
+	SGPIO_MUL_StructInit(&MulInit);
+	MulInit.BiOut = cfg->SGPIO_ProtoBiOut;
+	MulInit.MulPRVal = proto->TxPr;
+	MulInit.MulData_Dir = MUL_DATA_DIR_LSB;
+	MulInit.MulPosTC = 32 - 1;
+	MulInit.MulPosRST = 32 - 1;
+	SGPIO_MUL_Init(SGPIOx, &MulInit);
+
+	SGPIO_MULMRxGP0ValConfig(SGPIOx, proto->TxMr[0][0], proto->TxMr[0][1], proto->TxMr[0][2], proto->TxMr[0][3]);
+	SGPIO_MULMRxGP1ValConfig(SGPIOx, proto->TxMr[1][0], proto->TxMr[1][1], proto->TxMr[1][2], proto->TxMr[1][3]);
+	SGPIO_MULMRxTXCtlConfig(SGPIOx, BIT_SGPIO_MUL_MR0RST_EN | BIT_SGPIO_MUL_MR0SCLK_EN,
+							proto->TxEmc & BIT_SGPIO_MULEMC1, proto->TxEmc & BIT_SGPIO_MULEMC2,
+							proto->TxEmc & BIT_SGPIO_MULEMC3);
+	SGPIO_OutputConfig(SGPIOx, cfg->SGPIO_ProtoIdle);
+	SGPIO_INTConfig(SGPIOx, BIT_SGPIO_MULLOAD_IE, ENABLE);
+
+	return RTK_SUCCESS;
+}
+
+/**
+  * @brief  Send one frame: the start bits, the data bits and the trail bits.
+  * @param  proto: protocol instance.
+  * @param  Data: data bits, in the order of SGPIO_ProtoMsbFirst.
+  * @param  Bits: data bit number.
+  * @retval RTK_SUCCESS, RTK_ERR_BUSY while a frame is sent, or RTK_ERR_BADARG.
+  */
+int SGPIO_ProtoSend(SGPIO_ProtoTypeDef *proto, const u8 *Data, u32 Bits)
+{
+	SGPIO_ProtoInitTypeDef *cfg = &proto->Cfg;
+	SGPIO_TypeDef *SGPIOx = proto->SGPIOx;
+	u32 total = cfg->SGPIO_ProtoStartBits + Bits + cfg->SGPIO_ProtoTrailBits;
+	u32 pos, i, n;
+
+	if (Bits == 0 || total > SGPIO_PROTO_BITS_MAX) {
+		return RTK_ERR_BADARG;
+	}
+
+	if (proto->TxBusy) {
+		return RTK_ERR_BUSY;
+	}
+
+	_memset((void *)proto->TxWord, 0, sizeof(proto->TxWord));
+	sgpio_proto_put(proto->TxWord, 0, cfg->SGPIO_ProtoStartVal & (BIT(cfg->SGPIO_ProtoStartBits) - 1),
+					cfg->SGPIO_ProtoStartBits);
+	pos = cfg->SGPIO_ProtoStartBits;
+
+	for (i = 0; i < Bits; i += 8) {
+		n = MIN(Bits - i, 8);
+		sgpio_proto_put(proto->TxWord, pos, sgpio_proto_line(proto, Data[i / 8]) & (BIT(n) - 1), n);
+		pos += n;
+	}
+
+	sgpio_proto_put(proto->TxWord, pos, cfg->SGPIO_ProtoTrailVal & (BIT(cfg->SGPIO_ProtoTrailBits) - 1),
+					cfg->SGPIO_ProtoTrailBits);
+
+	proto->TxWordNum = (total + 31) / 32;
+	proto->TxIdx = 2;
+	proto->TxBusy = TRUE;
+	proto->Stats.TxBits += total;
+
+	SGPIOx->SGPIO_MULDATA = proto->TxWord[0];
+	SGPIOx->SGPIO_MULDATA_DP = proto->TxWord[1];
+	SGPIOx->SGPIO_MULPOSR = ((32 - 1) << 8) | (32 - 1);
+	SGPIO_ClearRawINT(SGPIOx, BIT_SGPIO_MULLOAD_IS | BIT_SGPIO_MULMCNT_IS);
+
+	/* one MULMR0 match per bit, the timer stops on the last one */
+	SGPIO_MULMCNTConfig(SGPIOx, total, BIT_SGPIO_MUL_MCNT_IE | BIT_SGPIO_MUL_MCNTRST_EN | BIT_SGPIO_MUL_MCNTSTOP_EN);
+	SGPIO_MULMCNT_Cmd(SGPIOx, ENABLE);
+	SGPIO_MULTmr_Reset(SGPIOx);
+	SGPIO_MULTmr_Cmd(SGPIOx, ENABLE);
+
+	return RTK_SUCCESS;
+}
+
+/**
+  * @brief  Start or stop the receiver.
+  * @param  proto: protocol instance.
+  * @param  NewState: ENABLE or DISABLE.
+  * @retval None
+  * @note   Starting drops the frame being decoded and the captures not read yet.
+  */
+void SGPIO_ProtoRxCmd(SGPIO_ProtoTypeDef *proto, u32 NewState)
+{
+	SGPIO_ProtoInitTypeDef *cfg = &proto->Cfg;
+	SGPIO_TypeDef *SGPIOx = proto->SGPIOx;
+	SGPIO_RXInitTypeDef RxInit;
+	SGPIO_CAPInitTypeDef CapInit;
+	u32 PrevStatus;
+
+	if (cfg->SGPIO_ProtoRxMode == SGPIO_PROTO_RX_NONE) {
+		return;
+	}
+
+	if (NewState == DISABLE) {
+		SGPIO_Cap_Cmd(SGPIOx, DISABLE);
+		SGPIO_RXTmr_Cmd(SGPIOx, DISABLE);
+		proto->RxOn = FALSE;
+		return;
+	}
+
+	PrevStatus = __get_PRIMASK();
+	__disable_irq();
+	proto->Tail = proto->Head;
+	proto->RxDrop = FALSE;
+	proto->RxCount = 0;
+	proto->RxSkip = FALSE;
+	proto->RxCnt = 0;
+	proto->RxState = SGPIO_PROTO_STATE_START;
+	_memset((void *)proto->RxWord, 0, sizeof(proto->RxWord));
+	__set_PRIMASK(PrevStatus);
+
+	/* the RX timer starts on the edge into the level, the capture resets it on the next
+	 * edge into the level for an interval, out of the level for a width */
+	SGPIO_RX_StructInit(&RxInit);
+	RxInit.RxTimerEdge_Sel = cfg->SGPIO_ProtoRxLevel ? RX_TIMER_RISING_EDGE : RX_TIMER_FALLING_EDGE;
+	RxInit.RxPRVal = proto->RxPr;
+	SGPIO_RX_Init(SGPIOx, &RxInit);
+
+	SGPIO_CAP_StructInit(&CapInit);
+	if (cfg->SGPIO_ProtoRxMode == SGPIO_PROTO_RX_INTERVAL) {
+		CapInit.CapEdge_Sel = cfg->SGPIO_ProtoRxLevel ? CAP_RX_RISING_EDGE : CAP_RX_FALLING_EDGE;
+		CapInit.Cap_RxTCStop_Ctrl = CAP_RX_STOP_DISABLE;
+	} else {
+		CapInit.CapEdge_Sel = cfg->SGPIO_ProtoRxLevel ? CAP_RX_FALLING_EDGE : CAP_RX_RISING_EDGE;
+		CapInit.Cap_RxTCStop_Ctrl = CAP_RX_STOP_ENABLE;
+	}
+	SGPIO_CAP_Init(SGPIOx, &CapInit);
+
+	/* no edge for a gap: end of frame, the timer waits for the next one */
+	SGPIO_RXMR0Config(SGPIOx, proto->RxGap, BIT_SGPIO_RX_MR0_IE | BIT_SGPIO_RX_MR0RST_EN | BIT_SGPIO_RX_MR0STOP_EN);
+	SGPIO_ClearRawINT(SGPIOx, BIT_SGPIO_CAPI_IS | BIT_SGPIO_RX_MR0I_IS);
+	proto->RxOn = TRUE;
+	SGPIO_Cap_Cmd(SGPIOx, ENABLE);
+}
+
+static void sgpio_proto_push(SGPIO_ProtoTypeDef *proto, u32 Val)
+{
+	u32 head = proto->Head;
+
+	/* after an overflow the frame is broken, keep its gap only, marked */
+	if (proto->RxDrop) {
+		if (Val != SGPIO_PROTO_MARK_GAP) {
+			return;
+		}
+		Val = SGPIO_PROTO_MARK_ERR;
+	}
+
+	if (head - proto->Tail >= proto->Cfg.SGPIO_ProtoRxNum) {
+		proto->Stats.RxOverflow++;
+		proto->RxDrop = TRUE;
+		return;
+	}
+
+	proto->Cfg.SGPIO_ProtoRxBuf[head & (proto->Cfg.SGPIO_ProtoRxNum - 1)] = Val;
+	proto->RxDrop = FALSE;
+
+	/* the entry shall be visible before the new head */
+	__DMB();
+	proto->Head = head + 1;
+}
+
+/**
+  * @brief  Refill the multiple data, end the frame sent and queue the captures.
+  * @param  proto: protocol instance.
+  * @retval None
+  * @note   Called from the SGPIO interrupt handler.
+  */
+void SGPIO_ProtoIRQHandler(SGPIO_ProtoTypeDef *proto)
+{
+	SGPIO_TypeDef *SGPIOx = proto->SGPIOx;
+	u32 isr = SGPIO_GetRawINT(SGPIOx) & (BIT_SGPIO_MULLOAD_IS | BIT_SGPIO_MULMCNT_IS |
+									   BIT_SGPIO_CAPI_IS | BIT_SGPIO_RX_MR0I_IS);
+	u32 evt = 0;
+
+	SGPIO_ClearRawINT(SGPIOx, isr);
+
+	/* MULDATA_DP went to MULDATA, the next word has 32 bits of time to come */
+	if ((isr & BIT_SGPIO_MULLOAD_IS) && proto->TxIdx < proto->TxWordNum) {
+		SGPIOx->SGPIO_MULDATA_DP = proto->TxWord[proto->TxIdx++];
+	}
+
+	if ((isr & BIT_SGPIO_MULMCNT_IS) && proto->TxBusy) {
+		SGPIO_MULMCNT_Cmd(SGPIOx, DISABLE);
+		SGPIO_OutputConfig(SGPIOx, proto->Cfg.SGPIO_ProtoIdle);
+		proto->TxBusy = FALSE;
+		proto->Stats.TxFrames++;
+		evt |= SGPIO_PROTO_EVT_TX_DONE;
+	}
+
+	if (proto->RxOn) {
+		if (isr & BIT_SGPIO_CAPI_IS) {
+			proto->Stats.RxCaptures++;
+			sgpio_proto_push(proto, SGPIO_GetCapVal(SGPIOx) & BIT_SGPIO_CAPR);
+
+			if (proto->Cfg.SGPIO_ProtoRxMode == SGPIO_PROTO_RX_WIDTH &&
+				++proto->RxCount >= proto->Cfg.SGPIO_ProtoRxFrameBits) {
+				proto->RxCount = 0;
+				evt |= SGPIO_PROTO_EVT_RX;
+			}
+		}
+
+		if (isr & BIT_SGPIO_RX_MR0I_IS) {
+			sgpio_proto_push(proto, SGPIO_PROTO_MARK_GAP);
+			proto->RxCount = 0;
+			evt |= SGPIO_PROTO_EVT_RX;
+		}
+	}
+
+	if (evt && proto->Cfg.SGPIO_ProtoCb) {
+		proto->Cfg.SGPIO_ProtoCb(proto->Cfg.SGPIO_ProtoCbData, evt);
+	}
+}
+
+static void sgpio_proto_restart(SGPIO_ProtoTypeDef *proto)
+{
+	proto->RxCnt = 0;
+	_memset((void *)proto->RxWord, 0, sizeof(proto->RxWord));
+}
+
+static void sgpio_proto_drop(SGPIO_ProtoTypeDef *proto)
+{
+	proto->Stats.RxErrors++;
+	proto->RxSkip = TRUE;
+	sgpio_proto_restart(proto);
+}
+
+/* apply a rule, TRUE when it ends the frame */
+static bool sgpio_proto_rule(SGPIO_ProtoTypeDef *proto, SGPIO_ProtoRuleTypeDef *rule)
+{
+	if (rule->Act == SGPIO_PROTO_ACT_ERR || proto->RxCnt + rule->Bits > SGPIO_PROTO_BITS_MAX) {
+		sgpio_proto_drop(proto);
+		return FALSE;
+	}
+
+	if (rule->Act == SGPIO_PROTO_ACT_SYNC) {
+		sgpio_proto_restart(proto);
+	}
+
+	sgpio_proto_put(proto->RxWord, proto->RxCnt, rule->Value & (BIT(rule->Bits) - 1), rule->Bits);
+	proto->RxCnt += rule->Bits;
+	proto->RxState = rule->Next;
+
+	return rule->Act == SGPIO_PROTO_ACT_END;
+}
+
+/* decode one ring entry, TRUE when a frame is complete in RxWord */
+static bool sgpio_proto_decode(SGPIO_ProtoTypeDef *proto, u32 Val)
+{
+	SGPIO_ProtoInitTypeDef *cfg = &proto->Cfg;
+	bool interval = cfg->SGPIO_ProtoRxMode == SGPIO_PROTO_RX_INTERVAL;
+	u32 idx, cls;
+	bool end;
+
+	if (Val == SGPIO_PROTO_MARK_GAP || Val == SGPIO_PROTO_MARK_ERR) {
+		end = !proto->RxSkip && proto->RxCnt;
+		/* a fixed length frame cut by the gap is broken too */
+		if (Val == SGPIO_PROTO_MARK_ERR || (end && cfg->SGPIO_ProtoRxFrameBits)) {
+			proto->Stats.RxErrors++;
+			end = FALSE;
+		}
+		proto->RxSkip = FALSE;
+		proto->RxState = SGPIO_PROTO_STATE_START;
+		if (!end) {
+			sgpio_proto_restart(proto);
+		}
+		return end;
+	}
+
+	if (proto->RxSkip) {
+		return FALSE;
+	}
+
+	if (proto->RxState == SGPIO_PROTO_STATE_START) {
+		proto->RxState = 0;
+		if (interval) {
+			/* the first edge only starts the timer, a capture on it is close to 0 */
+			if (sgpio_proto_rule(proto, &cfg->SGPIO_ProtoRxFirst)) {
+				goto frame_end;
+			}
+			if (proto->RxSkip || Val < proto->RxMin) {
+				return FALSE;
+			}
+		}
+	}
+
+	idx = Val >> proto->RxShift;
+	cls = idx < SGPIO_PROTO_LUT_SIZE ? proto->RxLut[idx] : SGPIO_PROTO_CLASS_BAD;
+	if (cls == SGPIO_PROTO_CLASS_BAD) {
+		sgpio_proto_drop(proto);
+		return FALSE;
+	}
+
+	end = sgpio_proto_rule(proto, &cfg->SGPIO_ProtoRxRule[proto->RxState][cls]);
+	if (!end && (proto->RxSkip || cfg->SGPIO_ProtoRxFrameBits == 0 || proto->RxCnt < cfg->SGPIO_ProtoRxFrameBits)) {
+		return FALSE;
+	}
+
+frame_end:
+	/* the edges up to the gap belong to this frame */
+	proto->RxSkip = interval;
+	proto->RxState = SGPIO_PROTO_STATE_START;
+
+	return TRUE;
+}
+
+/**
+  * @brief  Decode the queued captures up to the end of one frame.
+  * @param  proto: protocol instance.
+  * @param  Buf: data bits, in the order of SGPIO_ProtoMsbFirst.
+  * @param  Len: Buf size in bytes, the data bits beyond are dropped.
+  * @retval Data bits of the frame, 0 if no frame is complete yet.
+  * @note   The start bits are checked and stripped, a frame with wrong start bits is
+  *         counted as an error.
+  */
+u32 SGPIO_ProtoReceive(SGPIO_ProtoTypeDef *proto, u8 *Buf, u32 Len)
+{
+	SGPIO_ProtoInitTypeDef *cfg = &proto->Cfg;
+	u32 start = cfg->SGPIO_ProtoStartBits;
+	u32 tail = proto->Tail;
+	u32 bits = 0;
+	u32 val, i, n;
+
+	while (tail != proto->Head) {
+		val = cfg->SGPIO_ProtoRxBuf[tail & (cfg->SGPIO_ProtoRxNum - 1)];
+
+		/* the entry shall be read before the slot is given back */
+		__DMB();
+		proto->Tail = ++tail;
+
+		if (!sgpio_proto_decode(proto, val)) {
+			continue;
+		}
+
+		if (proto->RxCnt < start + cfg->SGPIO_ProtoRxTrim ||
+			sgpio_proto_get(proto->RxWord, 0, start) != (cfg->SGPIO_ProtoStartVal & (BIT(start) - 1))) {
+			proto->Stats.RxErrors++;
+			sgpio_proto_restart(proto);
+			continue;
+		}
+
+		bits = MIN(proto->RxCnt - start - cfg->SGPIO_ProtoRxTrim, Len * 8);
+		for (i = 0; i < bits; i += 8) {
+			n = MIN(bits - i, 8);
+			val = sgpio_proto_get(proto->RxWord, start + i, n);
+			/* bits missing from a last partial byte read as 0 on the line */
+			Buf[i / 8] = sgpio_proto_line(proto, val) & (cfg->SGPIO_ProtoMsbFirst ? ((u32)0xFF00 >> n) : (BIT(n) - 1));
+		}
+
+		proto->Stats.RxFrames++;
+		sgpio_proto_restart(proto);
+		break;
+	}
+
+	return bits;
+}
+
+/**
+  * @brief  Get a snapshot of the protocol statistics.
+  * @param  proto: protocol instance.
+  * @param  Stats: pointer to the statistics copy.
+  * @retval None
+  */
+void SGPIO_ProtoGetStats(SGPIO_ProtoTypeDef *proto, SGPIO_ProtoStatsTypeDef *Stats)
+{
+	u32 PrevStatus = __get_PRIMASK();
+
+	__disable_irq();
+	*Stats = proto->Stats;
+	__set_PRIMASK(PrevStatus);
+}
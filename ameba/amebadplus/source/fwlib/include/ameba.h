@@ -65,6 +65,7 @@
 #include "ameba_delay.h"
 #include "ameba_ir.h"
 #include "ameba_ledc.h"
+#include "ameba_ledc_frame.h"
 #include "ameba_audio.h"
 #include "ameba_sport.h"
 #include "ameba_cache.h"
@@ -62,6 +62,18 @@
   *	-Internal 32K: 32K clock from internal 32K source: NCO32K
   *
   *****************************************************************************************
+  * OSC131K/OSC4M tracking
+  *****************************************************************************************
+  *	-OSC131K_Calibration() and OSC4M_Calibration() trim the OSC once at boot, OSC_CAL
+  *	 keeps the trim right while the temperature drifts
+  *	-the trim code is cached per temperature band, entering a band with a cached code
+  *	 applies it at once
+  *	-otherwise OSC_CAL_Process() moves the trim code one step per call towards the
+  *	 target, the OSC settles between two calls and the frequency counter is polled, not
+  *	 waited for, so it can run from an idle hook
+  *	-the frequency error of the last measurement is kept in ppm
+  *
+  *****************************************************************************************
   * @endverbatim
   */
 
@@ -126,6 +138,16 @@
   * @}
   */
 
+/** @defgroup OSC_CAL_definitions
+  * @{
+  */
+#define OSC_CAL_BAND_NUM		16
+#define OSC_CAL_CODE_NONE		0xFF	/*!< no cached trim code for the band */
+#define OSC_CAL_SAMPLE_MAX		16
+/**
+  * @}
+  */
+
 /** @defgroup XTAL_MODE_SEL_definitions
   * @{
   */
@@ -236,6 +258,69 @@ _LONG_CALL_ bool PLL_State(void);
 _LONG_CALL_ void PLL_ClkSet(u32 PllClk);
 _LONG_CALL_ void OSC131K_Reset(void);
 
+/** @defgroup OSC_CAL_Exported_Types OSC_CAL Exported Types
+  * @{
+  */
+
+/**
+  * @brief  OSC_CAL statistics
+  */
+typedef struct {
+	u32 Measures;				/*!< frequency counter results taken */
+	u32 Steps;					/*!< trim code changes by one step */
+	u32 CacheHits;				/*!< band entered with a cached trim code */
+	u32 CacheMisses;
+	u32 Saturated;				/*!< target out of the trim range */
+	s32 PpmMax;					/*!< largest error seen, signed */
+} OSC_CAL_StatsTypeDef;
+
+/**
+  * @brief  OSC_CAL init structure definition
+  */
+typedef struct {
+	u32 OSC_CalClk;				/*!< AON128K_CAL_CLK or OSC4M_CAL_CLK, @ref CAL_CLK_SEL_definitions */
+	u32 OSC_CalTolPpm;			/*!< error accepted without retrim */
+	u32 OSC_CalSamples;			/*!< counter results averaged per decision, 1 ~ OSC_CAL_SAMPLE_MAX */
+	s32 OSC_CalTempMin;			/*!< lower edge of band 0, in degree C */
+	u32 OSC_CalBandWidth;		/*!< degree C per band */
+} OSC_CAL_InitTypeDef;
+
+/**
+  * @brief  OSC_CAL instance
+  */
+typedef struct {
+	OSC_CAL_InitTypeDef Cfg;
+	u8 Code;					/*!< trim code in use */
+	u8 Band;
+	u8 Measuring;				/*!< a counter run was started by OSC_CAL */
+	s8 LastDir;					/*!< direction of the last step, 0 if none */
+	u8 Hold;					/*!< best code found, no retrim until the error grows */
+	u8 Samples;
+	u8 Tracking;				/*!< trim code is moving */
+	u8 Rsvd;
+	u32 CodeMax;
+	u32 Target;					/*!< counter result of the exact frequency */
+	u32 Sum;					/*!< counter results of the current decision */
+	u32 SettleUs;
+	u32 ChangeTime;				/*!< DTimestamp of the last trim code change */
+	s32 Ppm;					/*!< error of the last decision, > 0 if the OSC is fast */
+	s32 LastPpm;				/*!< error before the last step */
+	u8 Cache[OSC_CAL_BAND_NUM];	/*!< trim code per band, may be saved and restored by the user */
+	OSC_CAL_StatsTypeDef Stats;
+} OSC_CAL_TypeDef;
+
+/** @} */
+
+/** @defgroup OSC_CAL_Exported_Functions OSC_CAL Exported Functions
+  * @{
+  */
+void OSC_CAL_StructInit(OSC_CAL_InitTypeDef *OSC_CalInitStruct);
+int OSC_CAL_Init(OSC_CAL_TypeDef *cal, OSC_CAL_InitTypeDef *OSC_CalInitStruct);
+bool OSC_CAL_Process(OSC_CAL_TypeDef *cal, s32 Temp);
+s32 OSC_CAL_GetPpm(OSC_CAL_TypeDef *cal);
+void OSC_CAL_GetStats(OSC_CAL_TypeDef *cal, OSC_CAL_StatsTypeDef *Stats);
+/** @} */
+
 
 /* Registers Definitions --------------------------------------------------------*/
 /**************************************************************************//**
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _AMEBA_LEDC_FRAME_H_
+#define _AMEBA_LEDC_FRAME_H_
+
+/** @addtogroup Ameba_Periph_Driver
+  * @{
+  */
+
+/** @defgroup LEDC_FRAME
+  * @brief LEDC_FRAME driver modules
+  * @verbatim
+  *****************************************************************************************
+  * Introduction
+  *****************************************************************************************
+  * Frame engine on top of the LEDC and one GDMA channel:
+  *		- frames are RGB888 framebuffers, one pixel per LED
+  *		- each color goes through a 256 entry table that combines the gamma curve and the
+  *		  global brightness, the table entries are pre-shifted to their byte of the LEDC data
+  *		  word, so a pixel is encoded by three loads and two ORs
+  *		- words are packed as {G, R, B} and the LED wire order is done by the LEDC output
+  *		  mode (LEDC_SetOutputMode), no per pixel swapping in software
+  *		- two encode buffers: the next frame is encoded while the current one shifts out,
+  *		  the LEDC transfer finish interrupt starts the pending frame
+  *
+  * One frame is one LEDC transfer, so a chain is limited to LEDC_MAX_LED_NUM LEDs.
+  *
+  *****************************************************************************************
+  * How to use
+  *****************************************************************************************
+  *		1. Initialize the LEDC by LEDC_Init() in DMA mode.
+  *		2. Fill a LEDC_FRAME_InitTypeDef by LEDC_FRAME_StructInit(), set the LED number and
+  *		   the two encode buffers and call LEDC_FRAME_Init().
+  *		3. Register LEDC_IRQ and call LEDC_FRAME_IRQHandler() from it.
+  *		4. Call LEDC_FRAME_Submit() with each new framebuffer, it returns RTK_FAIL while a
+  *		   frame is still pending. LEDC_FRAME_SetBrightness() and LEDC_FRAME_SetGamma()
+  *		   apply from the next submitted frame.
+  *
+  *****************************************************************************************
+  * @endverbatim
+  * @{
+  */
+
+/* Exported constants --------------------------------------------------------*/
+/** @defgroup LEDC_FRAME_Exported_Constants LEDC_FRAME Exported Constants
+  * @{
+  */
+
+#define LEDC_FRAME_BUF_NUM			2
+#define LEDC_FRAME_IDLE				0xFF
+
+/** @} */
+
+/* Exported types ------------------------------------------------------------*/
+/** @defgroup LEDC_FRAME_Exported_Types LEDC_FRAME Exported Types
+  * @{
+  */
+
+/**
+  * @brief  LEDC_FRAME statistics
+  */
+typedef struct {
+	u32 Frames;					/*!< frames shifted out */
+	u32 Busy;					/*!< submits refused because a frame was pending */
+	u32 Errors;					/*!< FIFO overflow or wait data timeout, the frame is lost */
+	u32 EncodeUs;				/*!< last frame encode time */
+	u32 EncodeMaxUs;
+	u32 FrameUs;				/*!< last frame transfer time, start to transfer finish */
+	u32 FrameMaxUs;
+	u32 IntervalUs;				/*!< last time between two frame starts */
+} LEDC_FRAME_StatsTypeDef;
+
+/**
+  * @brief  LEDC_FRAME init structure definition
+  */
+typedef struct {
+	u32 LEDC_FrameLedNum;		/*!< 1 ~ LEDC_MAX_LED_NUM */
+	u32 *LEDC_FrameBuf[LEDC_FRAME_BUF_NUM];	/*!< LEDC_FrameLedNum words each, cache line aligned */
+	u32 LEDC_FrameOutput;		/*!< LED wire order, @ref LEDC_RGB_Mode */
+	const u8 *LEDC_FrameGamma;	/*!< 256 entry gamma table, NULL for the built-in gamma 2.2 */
+	u8 LEDC_FrameBrightness;	/*!< 0 ~ 255 */
+	void (*LEDC_FrameDoneCb)(void *Data);	/*!< optional, called in ISR after each frame */
+	void *LEDC_FrameCbData;
+} LEDC_FRAME_InitTypeDef;
+
+/**
+  * @brief  LEDC_FRAME instance
+  */
+typedef struct {
+	LEDC_FRAME_InitTypeDef Cfg;
+	LEDC_TypeDef *LEDCx;
+	u8 GdmaChnl;
+	volatile u8 Active;			/*!< buffer shifting out, LEDC_FRAME_IDLE if none */
+	volatile u8 Pending;		/*!< buffer waiting for the LEDC, LEDC_FRAME_IDLE if none */
+	u8 Rsvd;
+	u32 StartTime;
+	u32 Lut[3][256];			/*!< R, G and B tables, pre-shifted to the data word */
+	GDMA_InitTypeDef GdmaInit;
+	LEDC_FRAME_StatsTypeDef Stats;
+} LEDC_FRAME_TypeDef;
+
+/** @} */
+
+/* Exported functions --------------------------------------------------------*/
+/** @defgroup LEDC_FRAME_Exported_Functions LEDC_FRAME Exported Functions
+  * @{
+  */
+void LEDC_FRAME_StructInit(LEDC_FRAME_InitTypeDef *LEDC_FrameInitStruct);
+int LEDC_FRAME_Init(LEDC_FRAME_TypeDef *fe, LEDC_TypeDef *LEDCx, LEDC_FRAME_InitTypeDef *LEDC_FrameInitStruct);
+void LEDC_FRAME_DeInit(LEDC_FRAME_TypeDef *fe);
+void LEDC_FRAME_SetBrightness(LEDC_FRAME_TypeDef *fe, u8 Brightness);
+void LEDC_FRAME_SetGamma(LEDC_FRAME_TypeDef *fe, const u8 *Gamma);
+void LEDC_FRAME_Encode(LEDC_FRAME_TypeDef *fe, u32 *Dst, const u8 *Rgb, u32 Num);
+int LEDC_FRAME_Submit(LEDC_FRAME_TypeDef *fe, const u8 *Rgb);
+void LEDC_FRAME_IRQHandler(LEDC_FRAME_TypeDef *fe);
+void LEDC_FRAME_GetStats(LEDC_FRAME_TypeDef *fe, LEDC_FRAME_StatsTypeDef *Stats);
+/** @} */
+
+/** @} */
+
+/** @} */
+
+#endif
@@ -364,6 +364,269 @@ cal_end:
 	return TRUE;
 }
 
+#define OSC_CAL_RUN_NONE		0
+#define OSC_CAL_RUN_VALID		1
+#define OSC_CAL_RUN_STALE		2	/* started before the last trim code change */
+
+static u32 osc_cal_code_get(OSC_CAL_TypeDef *cal)
+{
+	LDO_TypeDef *regu = LDO_BASE;
+
+	if (cal->Cfg.OSC_CalClk == AON128K_CAL_CLK) {
+		return LDO_GET_RCAL(regu->LDO_32K_OSC_CTRL);
+	} else {
+		return LDO_GET_FREQ_R_SEL(regu->LDO_4M_OSC_CTRL1);
+	}
+}
+
+/* no settle delay here, OSC_CAL_Process() skips the counter until SettleUs has passed */
+static void osc_cal_code_set(OSC_CAL_TypeDef *cal, u32 code)
+{
+	LDO_TypeDef *regu = LDO_BASE;
+	u32 temp;
+
+	if (cal->Cfg.OSC_CalClk == AON128K_CAL_CLK) {
+		temp = regu->LDO_32K_OSC_CTRL;
+		temp &= ~LDO_MASK_RCAL;
+		temp |= LDO_RCAL(code);
+		regu->LDO_32K_OSC_CTRL = temp;
+	} else {
+		temp = regu->LDO_4M_OSC_CTRL1;
+		temp &= ~LDO_MASK_FREQ_R_SEL;
+		temp |= LDO_FREQ_R_SEL(code);
+		regu->LDO_4M_OSC_CTRL1 = temp;
+	}
+
+	cal->Code = (u8)code;
+	cal->ChangeTime = DTimestamp_Get();
+	cal->Samples = 0;
+	cal->Sum = 0;
+	if (cal->Measuring) {
+		cal->Measuring = OSC_CAL_RUN_STALE;
+	}
+}
+
+static u32 osc_cal_band(OSC_CAL_TypeDef *cal, s32 Temp)
+{
+	s32 width = (s32)cal->Cfg.OSC_CalBandWidth;
+	s32 offset = Temp - cal->Cfg.OSC_CalTempMin;
+	s32 band;
+
+	/* 1 degree hysteresis at the edges of the current band */
+	if (cal->Band != OSC_CAL_CODE_NONE) {
+		band = cal->Band;
+		if (offset >= band * width - 1 && offset <= (band + 1) * width) {
+			return cal->Band;
+		}
+	}
+
+	band = offset < 0 ? 0 : offset / width;
+
+	return MIN((u32)band, OSC_CAL_BAND_NUM - 1);
+}
+
+/**
+  * @brief  Fill each OSC_CAL_InitTypeDef member with its default value.
+  * @param  OSC_CalInitStruct: pointer to an OSC_CAL_InitTypeDef structure.
+  * @retval None
+  */
+void OSC_CAL_StructInit(OSC_CAL_InitTypeDef *OSC_CalInitStruct)
+{
+	OSC_CalInitStruct->OSC_CalClk = AON128K_CAL_CLK;
+	OSC_CalInitStruct->OSC_CalTolPpm = 500;
+	OSC_CalInitStruct->OSC_CalSamples = 4;
+	OSC_CalInitStruct->OSC_CalTempMin = -40;
+	OSC_CalInitStruct->OSC_CalBandWidth = 10;
+}
+
+/**
+  * @brief  Initialize the tracking of one OSC, starting from the trim code in use.
+  * @param  cal: tracking instance.
+  * @param  OSC_CalInitStruct: pointer to an OSC_CAL_InitTypeDef structure.
+  * @retval RTK_SUCCESS or RTK_ERR_BADARG.
+  * @note   OSC131K_Calibration() or OSC4M_Calibration() shall have run before. The cache
+  *         starts empty, restore a saved one by writing cal->Cache after this call.
+  */
+int OSC_CAL_Init(OSC_CAL_TypeDef *cal, OSC_CAL_InitTypeDef *OSC_CalInitStruct)
+{
+	if ((OSC_CalInitStruct->OSC_CalClk != AON128K_CAL_CLK && OSC_CalInitStruct->OSC_CalClk != OSC4M_CAL_CLK) ||
+		OSC_CalInitStruct->OSC_CalSamples == 0 || OSC_CalInitStruct->OSC_CalSamples > OSC_CAL_SAMPLE_MAX ||
+		OSC_CalInitStruct->OSC_CalBandWidth == 0) {
+		RTK_LOGE(TAG, "Invalid OSC cal config\n");
+		return RTK_ERR_BADARG;
+	}
+
+	_memset((void *)cal, 0, sizeof(OSC_CAL_TypeDef));
+	_memset((void *)cal->Cache, OSC_CAL_CODE_NONE, sizeof(cal->Cache));
+	cal->Cfg = *OSC_CalInitStruct;
+	cal->Band = OSC_CAL_CODE_NONE;
+
+	if (cal->Cfg.OSC_CalClk == AON128K_CAL_CLK) {
+		cal->Target = 2441;		/* cal_rpt=8*40Mhz/fclk_osc131k */
+		cal->CodeMax = LDO_GET_RCAL(LDO_MASK_RCAL);
+		cal->SettleUs = 1000;
+	} else {
+		cal->Target = 320;		/* cal_rpt=32*40Mhz/fclk_osc4m */
+		cal->CodeMax = LDO_GET_FREQ_R_SEL(LDO_MASK_FREQ_R_SEL);
+		cal->SettleUs = 2;
+	}
+
+	cal->Code = (u8)osc_cal_code_get(cal);
+	cal->ChangeTime = DTimestamp_Get();
+
+	return RTK_SUCCESS;
+}
+
+/**
+  * @brief  Run one step of the OSC tracking, never waits.
+  * @param  cal: tracking instance.
+  * @param  Temp: current temperature in degree C, e.g. from the thermal sensor.
+  * @retval TRUE while the trim code is moving, call again soon. FALSE when the error is
+  *         within OSC_CalTolPpm or the best code is held, a slow period is enough.
+  * @note   Called from one task or idle hook only. A frequency counter run started by
+  *         OSC_CalResult_Get() is left alone, the step is skipped.
+  *         Each decision averages OSC_CalSamples counter runs, one run per call.
+  */
+bool OSC_CAL_Process(OSC_CAL_TypeDef *cal, s32 Temp)
+{
+	u32 band = osc_cal_band(cal, Temp);
+	u32 temp, err, total;
+	s32 ppm, dir;
+
+	if (band != cal->Band) {
+		cal->Band = (u8)band;
+		cal->Hold = FALSE;
+		cal->LastDir = 0;
+		if (cal->Cache[band] != OSC_CAL_CODE_NONE) {
+			cal->Stats.CacheHits++;
+			cal->Tracking = FALSE;
+			if (cal->Cache[band] != cal->Code) {
+				osc_cal_code_set(cal, cal->Cache[band]);
+			}
+		} else {
+			cal->Stats.CacheMisses++;
+			cal->Tracking = TRUE;
+		}
+	}
+
+	temp = HAL_READ32(SYSTEM_CTRL_BASE, REG_LSYS_AIP_CTRL0);
+	if (temp & LSYS_BIT_CK_CAL_START) {
+		return cal->Tracking;
+	}
+
+	if (cal->Measuring) {
+		if (cal->Measuring == OSC_CAL_RUN_VALID && LSYS_GET_CK_CAL_SEL(temp) == cal->Cfg.OSC_CalClk) {
+			cal->Sum += LSYS_GET_CK_CAL_RPT(temp);
+			cal->Samples++;
+			cal->Stats.Measures++;
+		}
+		cal->Measuring = OSC_CAL_RUN_NONE;
+	}
+
+	if (DTimestamp_Get() - cal->ChangeTime < cal->SettleUs) {
+		return cal->Tracking;
+	}
+
+	if (cal->Samples < cal->Cfg.OSC_CalSamples) {
+		temp &= ~LSYS_MASK_CK_CAL_SEL;
+		temp |= (LSYS_CK_CAL_SEL(cal->Cfg.OSC_CalClk) | LSYS_BIT_CK_CAL_START);
+		HAL_WRITE32(SYSTEM_CTRL_BASE, REG_LSYS_AIP_CTRL0, temp);
+		cal->Measuring = OSC_CAL_RUN_VALID;
+		return cal->Tracking;
+	}
+
+	/* counter result is inversely proportional to the OSC frequency */
+	total = cal->Target * cal->Samples;
+	ppm = (s32)(((s64)total - cal->Sum) * 1000000 / (s32)total);
+	err = ppm < 0 ? -ppm : ppm;
+	cal->Samples = 0;
+	cal->Sum = 0;
+	cal->Ppm = ppm;
+
+	if (err > (u32)(cal->Stats.PpmMax < 0 ? -cal->Stats.PpmMax : cal->Stats.PpmMax)) {
+		cal->Stats.PpmMax = ppm;
+	}
+
+	if (cal->Hold) {
+		if (err <= (u32)(cal->LastPpm < 0 ? -cal->LastPpm : cal->LastPpm) + cal->Cfg.OSC_CalTolPpm) {
+			return FALSE;
+		}
+		cal->Hold = FALSE;
+		cal->LastDir = 0;
+	}
+
+	if (err <= cal->Cfg.OSC_CalTolPpm) {
+		cal->Cache[cal->Band] = cal->Code;
+		cal->LastDir = 0;
+		cal->Tracking = FALSE;
+		return FALSE;
+	}
+
+	/* RCAL larger is faster, FREQ_R_SEL larger is slower */
+	dir = ppm > 0 ? -1 : 1;
+	if (cal->Cfg.OSC_CalClk == OSC4M_CAL_CLK) {
+		dir = -dir;
+	}
+
+	/* stepped over the target, keep the better of the two codes around it */
+	if (cal->LastDir != 0 && dir != cal->LastDir) {
+		if ((u32)(cal->LastPpm < 0 ? -cal->LastPpm : cal->LastPpm) < err) {
+			osc_cal_code_set(cal, cal->Code - cal->LastDir);
+			cal->Ppm = cal->LastPpm;
+		} else {
+			cal->LastPpm = ppm;
+		}
+		goto hold;
+	}
+
+	if ((dir < 0 && cal->Code == 0) || (dir > 0 && cal->Code >= cal->CodeMax)) {
+		cal->Stats.Saturated++;
+		cal->LastPpm = ppm;
+		goto hold;
+	}
+
+	cal->LastPpm = ppm;
+	cal->LastDir = (s8)dir;
+	cal->Tracking = TRUE;
+	cal->Stats.Steps++;
+	osc_cal_code_set(cal, cal->Code + dir);
+
+	return TRUE;
+
+hold:
+	cal->Cache[cal->Band] = cal->Code;
+	cal->Hold = TRUE;
+	cal->LastDir = 0;
+	cal->Tracking = FALSE;
+
+	return FALSE;
+}
+
+/**
+  * @brief  Get the OSC frequency error of the last decision.
+  * @param  cal: tracking instance.
+  * @retval Error in ppm, > 0 if the OSC is faster than its nominal frequency.
+  */
+s32 OSC_CAL_GetPpm(OSC_CAL_TypeDef *cal)
+{
+	return cal->Ppm;
+}
+
+/**
+  * @brief  Get a snapshot of the tracking statistics.
+  * @param  cal: tracking instance.
+  * @param  Stats: pointer to the statistics copy.
+  * @retval None
+  */
+void OSC_CAL_GetStats(OSC_CAL_TypeDef *cal, OSC_CAL_StatsTypeDef *Stats)
+{
+	u32 PrevStatus = __get_PRIMASK();
+
+	__disable_irq();
+	*Stats = cal->Stats;
+	__set_PRIMASK(PrevStatus);
+}
+
 /**
   * @brief  OSC4M Init
   * @param  NA
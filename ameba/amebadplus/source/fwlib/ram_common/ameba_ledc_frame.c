@@ -0,0 +1,326 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ameba_soc.h"
+
+/** @addtogroup Ameba_Periph_Driver
+  * @{
+  */
+
+/** @defgroup LEDC_FRAME
+  * @brief LEDC_FRAME driver modules
+  * @{
+  */
+
+/* round(255 * (x / 255) ^ 2.2) */
+static const u8 ledc_frame_gamma22[256] = {
+	  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   1,
+	  1,   1,   1,   1,   1,   1,   1,   1,   1,   2,   2,   2,   2,   2,   2,   2,
+	  3,   3,   3,   3,   3,   4,   4,   4,   4,   5,   5,   5,   5,   6,   6,   6,
+	  6,   7,   7,   7,   8,   8,   8,   9,   9,   9,  10,  10,  11,  11,  11,  12,
+	 12,  13,  13,  13,  14,  14,  15,  15,  16,  16,  17,  17,  18,  18,  19,  19,
+	 20,  20,  21,  22,  22,  23,  23,  24,  25,  25,  26,  26,  27,  28,  28,  29,
+	 30,  30,  31,  32,  33,  33,  34,  35,  35,  36,  37,  38,  39,  39,  40,  41,
+	 42,  43,  43,  44,  45,  46,  47,  48,  49,  49,  50,  51,  52,  53,  54,  55,
+	 56,  57,  58,  59,  60,  61,  62,  63,  64,  65,  66,  67,  68,  69,  70,  71,
+	 73,  74,  75,  76,  77,  78,  79,  81,  82,  83,  84,  85,  87,  88,  89,  90,
+	 91,  93,  94,  95,  97,  98,  99, 100, 102, 103, 105, 106, 107, 109, 110, 111,
+	113, 114, 116, 117, 119, 120, 121, 123, 124, 126, 127, 129, 130, 132, 133, 135,
+	137, 138, 140, 141, 143, 145, 146, 148, 149, 151, 153, 154, 156, 158, 159, 161,
+	163, 165, 166, 168, 170, 172, 173, 175, 177, 179, 181, 182, 184, 186, 188, 190,
+	192, 194, 196, 197, 199, 201, 203, 205, 207, 209, 211, 213, 215, 217, 219, 221,
+	223, 225, 227, 229, 231, 234, 236, 238, 240, 242, 244, 246, 248, 251, 253, 255,
+};
+
+static void ledc_frame_lut(LEDC_FRAME_TypeDef *fe)
+{
+	const u8 *gamma = fe->Cfg.LEDC_FrameGamma ? fe->Cfg.LEDC_FrameGamma : ledc_frame_gamma22;
+	u32 bright = fe->Cfg.LEDC_FrameBrightness;
+	u32 v, val;
+
+	for (v = 0; v < 256; v++) {
+		val = (gamma[v] * bright + 127) / 255;
+		fe->Lut[0][v] = val << 8;
+		fe->Lut[1][v] = val << 16;
+		fe->Lut[2][v] = val;
+	}
+}
+
+/* called with interrupts disabled or from the LEDC ISR */
+static void ledc_frame_start(LEDC_FRAME_TypeDef *fe, u8 idx)
+{
+	u32 now = DTimestamp_Get();
+
+	if (fe->Stats.Frames || fe->Stats.Errors) {
+		fe->Stats.IntervalUs = now - fe->StartTime;
+	}
+	fe->StartTime = now;
+	fe->Active = idx;
+
+	/* LEDC_EN rising clears the LEDC FIFO, enable the LEDC before the DMA pushes data */
+	LEDC_Cmd(fe->LEDCx, ENABLE);
+
+	GDMA_ClearINT(0, fe->GdmaChnl);
+	GDMA_SetSrcAddr(0, fe->GdmaChnl, (u32)fe->Cfg.LEDC_FrameBuf[idx]);
+	GDMA_SetBlkSize(0, fe->GdmaChnl, fe->Cfg.LEDC_FrameLedNum);
+	GDMA_Cmd(0, fe->GdmaChnl, ENABLE);
+}
+
+/**
+  * @brief  Fill each LEDC_FRAME_InitTypeDef member with its default value.
+  * @param  LEDC_FrameInitStruct: pointer to a LEDC_FRAME_InitTypeDef structure.
+  * @retval None
+  */
+void LEDC_FRAME_StructInit(LEDC_FRAME_InitTypeDef *LEDC_FrameInitStruct)
+{
+	_memset((void *)LEDC_FrameInitStruct, 0, sizeof(LEDC_FRAME_InitTypeDef));
+
+	LEDC_FrameInitStruct->LEDC_FrameLedNum = LEDC_DEFAULT_LED_NUM;
+	LEDC_FrameInitStruct->LEDC_FrameOutput = LEDC_OUTPUT_GRB;
+	LEDC_FrameInitStruct->LEDC_FrameBrightness = 255;
+}
+
+/**
+  * @brief  Initialize the frame engine, set the LEDC frame length and allocate the GDMA channel.
+  * @param  fe: frame engine instance.
+  * @param  LEDCx: selected LEDC peripheral, initialized by LEDC_Init().
+  * @param  LEDC_FrameInitStruct: pointer to a LEDC_FRAME_InitTypeDef structure.
+  * @retval RTK_SUCCESS, RTK_ERR_BADARG, or RTK_FAIL if no GDMA channel is free.
+  */
+int LEDC_FRAME_Init(LEDC_FRAME_TypeDef *fe, LEDC_TypeDef *LEDCx, LEDC_FRAME_InitTypeDef *LEDC_FrameInitStruct)
+{
+	GDMA_InitTypeDef *GDMA_InitStruct = &fe->GdmaInit;
+	u32 num = LEDC_FrameInitStruct->LEDC_FrameLedNum;
+	u8 GdmaChnl;
+
+	if (!IS_LEDC_LED_NUM(num) || LEDC_FrameInitStruct->LEDC_FrameBuf[0] == NULL ||
+		LEDC_FrameInitStruct->LEDC_FrameBuf[1] == NULL || !IS_LEDC_OUTPUT_MODE(LEDC_FrameInitStruct->LEDC_FrameOutput)) {
+		return RTK_ERR_BADARG;
+	}
+
+	/* frame end is seen by the LEDC transfer finish interrupt, the channel needs no IRQ */
+	GdmaChnl = GDMA_ChnlAlloc(0, NULL, 0, 0);
+	if (GdmaChnl == 0xFF) {
+		return RTK_FAIL;
+	}
+
+	_memset((void *)fe, 0, sizeof(LEDC_FRAME_TypeDef));
+	fe->Cfg = *LEDC_FrameInitStruct;
+	fe->LEDCx = LEDCx;
+	fe->GdmaChnl = GdmaChnl;
+	fe->Active = LEDC_FRAME_IDLE;
+	fe->Pending = LEDC_FRAME_IDLE;
+	ledc_frame_lut(fe);
+
+	LEDC_SetTransferMode(LEDCx, LEDC_DMA_MODE);
+	LEDC_SetOutputMode(LEDCx, fe->Cfg.LEDC_FrameOutput);
+	LEDC_SetLEDNum(LEDCx, num);
+	LEDC_SetTotalLength(LEDCx, num);
+
+	GDMA_InitStruct->GDMA_Index = 0;
+	GDMA_InitStruct->GDMA_ChNum = GdmaChnl;
+	GDMA_InitStruct->GDMA_DIR = TTFCMemToPeri_PerCtrl;
+	GDMA_InitStruct->GDMA_DstHandshakeInterface = GDMA_HANDSHAKE_INTERFACE_LEDC_TX;
+	GDMA_InitStruct->GDMA_SrcAddr = (u32)fe->Cfg.LEDC_FrameBuf[0];
+	GDMA_InitStruct->GDMA_DstAddr = (u32) & (LEDCx->LEDC_DATA_REG);
+	GDMA_InitStruct->GDMA_DstInc = NoChange;
+	GDMA_InitStruct->GDMA_SrcInc = IncType;
+	GDMA_InitStruct->GDMA_DstDataWidth = TrWidthFourBytes;
+	GDMA_InitStruct->GDMA_SrcDataWidth = TrWidthFourBytes;
+	GDMA_InitStruct->GDMA_BlockSize = num;
+
+	if (LEDC_GetFIFOLevel(LEDCx) == 0x08) {
+		GDMA_InitStruct->GDMA_DstMsize = MsizeEight;
+		GDMA_InitStruct->GDMA_SrcMsize = MsizeEight;
+	} else {
+		GDMA_InitStruct->GDMA_DstMsize = MsizeSixteen;
+		GDMA_InitStruct->GDMA_SrcMsize = MsizeSixteen;
+	}
+
+	GDMA_Init(0, GdmaChnl, GDMA_InitStruct);
+
+	return RTK_SUCCESS;
+}
+
+/**
+  * @brief  Stop the LEDC and free the GDMA channel.
+  * @param  fe: frame engine instance.
+  * @retval None
+  */
+void LEDC_FRAME_DeInit(LEDC_FRAME_TypeDef *fe)
+{
+	u32 PrevStatus = __get_PRIMASK();
+
+	__disable_irq();
+	fe->Active = LEDC_FRAME_IDLE;
+	fe->Pending = LEDC_FRAME_IDLE;
+	GDMA_Cmd(0, fe->GdmaChnl, DISABLE);
+	LEDC_SoftReset(fe->LEDCx);
+	__set_PRIMASK(PrevStatus);
+
+	GDMA_ChnlFree(0, fe->GdmaChnl);
+}
+
+/**
+  * @brief  Set the global brightness.
+  * @param  fe: frame engine instance.
+  * @param  Brightness: 0 ~ 255.
+  * @retval None
+  * @note   Call from the context that submits frames, applies from the next submitted frame.
+  */
+void LEDC_FRAME_SetBrightness(LEDC_FRAME_TypeDef *fe, u8 Brightness)
+{
+	fe->Cfg.LEDC_FrameBrightness = Brightness;
+	ledc_frame_lut(fe);
+}
+
+/**
+  * @brief  Set the gamma table.
+  * @param  fe: frame engine instance.
+  * @param  Gamma: 256 entry table kept by the caller, NULL for the built-in gamma 2.2.
+  * @retval None
+  * @note   Call from the context that submits frames, applies from the next submitted frame.
+  */
+void LEDC_FRAME_SetGamma(LEDC_FRAME_TypeDef *fe, const u8 *Gamma)
+{
+	fe->Cfg.LEDC_FrameGamma = Gamma;
+	ledc_frame_lut(fe);
+}
+
+/**
+  * @brief  Encode RGB888 pixels to LEDC data words with the current gamma and brightness.
+  * @param  fe: frame engine instance.
+  * @param  Dst: LEDC data words, Num entries.
+  * @param  Rgb: pixels, 3 bytes each in order R, G, B.
+  * @param  Num: number of pixels.
+  * @retval None
+  */
+void LEDC_FRAME_Encode(LEDC_FRAME_TypeDef *fe, u32 *Dst, const u8 *Rgb, u32 Num)
+{
+	const u32 *lut_r = fe->Lut[0];
+	const u32 *lut_g = fe->Lut[1];
+	const u32 *lut_b = fe->Lut[2];
+
+	while (Num >= 4) {
+		Dst[0] = lut_r[Rgb[0]] | lut_g[Rgb[1]] | lut_b[Rgb[2]];
+		Dst[1] = lut_r[Rgb[3]] | lut_g[Rgb[4]] | lut_b[Rgb[5]];
+		Dst[2] = lut_r[Rgb[6]] | lut_g[Rgb[7]] | lut_b[Rgb[8]];
+		Dst[3] = lut_r[Rgb[9]] | lut_g[Rgb[10]] | lut_b[Rgb[11]];
+		Dst += 4;
+		Rgb += 12;
+		Num -= 4;
+	}
+
+	while (Num--) {
+		*Dst++ = lut_r[Rgb[0]] | lut_g[Rgb[1]] | lut_b[Rgb[2]];
+		Rgb += 3;
+	}
+}
+
+/**
+  * @brief  Encode a framebuffer into the free buffer and queue it.
+  * @param  fe: frame engine instance.
+  * @param  Rgb: LEDC_FrameLedNum RGB888 pixels, may be reused after return.
+  * @retval RTK_SUCCESS, or RTK_FAIL if a frame is already waiting for the LEDC.
+  * @note   Starts the frame at once when the LEDC is idle, else the frame follows the current one.
+  */
+int LEDC_FRAME_Submit(LEDC_FRAME_TypeDef *fe, const u8 *Rgb)
+{
+	u32 num = fe->Cfg.LEDC_FrameLedNum;
+	u32 PrevStatus, start;
+	u32 *buf;
+	u8 idx;
+
+	PrevStatus = __get_PRIMASK();
+	__disable_irq();
+	if (fe->Pending != LEDC_FRAME_IDLE) {
+		fe->Stats.Busy++;
+		__set_PRIMASK(PrevStatus);
+		return RTK_FAIL;
+	}
+	/* only Submit starts frames, the buffer not shifting out stays free until queued below */
+	idx = (fe->Active == 0) ? 1 : 0;
+	__set_PRIMASK(PrevStatus);
+
+	buf = fe->Cfg.LEDC_FrameBuf[idx];
+	start = DTimestamp_Get();
+	LEDC_FRAME_Encode(fe, buf, Rgb, num);
+	DCache_Clean((u32)buf, num * sizeof(u32));
+	fe->Stats.EncodeUs = DTimestamp_Get() - start;
+
+	__disable_irq();
+	fe->Stats.EncodeMaxUs = MAX(fe->Stats.EncodeMaxUs, fe->Stats.EncodeUs);
+	if (fe->Active == LEDC_FRAME_IDLE) {
+		ledc_frame_start(fe, idx);
+	} else {
+		fe->Pending = idx;
+	}
+	__set_PRIMASK(PrevStatus);
+
+	return RTK_SUCCESS;
+}
+
+/**
+  * @brief  Handle the LEDC interrupt, account the finished frame and start the pending one.
+  * @param  fe: frame engine instance.
+  * @retval None
+  */
+void LEDC_FRAME_IRQHandler(LEDC_FRAME_TypeDef *fe)
+{
+	u32 status = LEDC_GetINT(fe->LEDCx) & LEDC_INT_ALL;
+	u32 now = DTimestamp_Get();
+	u8 next;
+
+	LEDC_ClearINT(fe->LEDCx, status);
+
+	if (fe->Active == LEDC_FRAME_IDLE) {
+		return;
+	}
+
+	if (status & (LEDC_BIT_FIFO_OVERFLOW_INT | LEDC_BIT_WAITDATA_TIMEOUT_INT)) {
+		GDMA_Cmd(0, fe->GdmaChnl, DISABLE);
+		fe->Stats.Errors++;
+	} else if (status & LEDC_BIT_LED_TRANS_FINISH_INT) {
+		fe->Stats.Frames++;
+		fe->Stats.FrameUs = now - fe->StartTime;
+		fe->Stats.FrameMaxUs = MAX(fe->Stats.FrameMaxUs, fe->Stats.FrameUs);
+	} else {
+		return;
+	}
+
+	/* an enabled but idle LEDC would report wait data timeout */
+	LEDC_SoftReset(fe->LEDCx);
+	fe->Active = LEDC_FRAME_IDLE;
+
+	next = fe->Pending;
+	if (next != LEDC_FRAME_IDLE) {
+		fe->Pending = LEDC_FRAME_IDLE;
+		ledc_frame_start(fe, next);
+	}
+
+	if (fe->Cfg.LEDC_FrameDoneCb != NULL) {
+		fe->Cfg.LEDC_FrameDoneCb(fe->Cfg.LEDC_FrameCbData);
+	}
+}
+
+/**
+  * @brief  Get a snapshot of the frame engine statistics.
+  * @param  fe: frame engine instance.
+  * @param  Stats: pointer to the statistics copy.
+  * @retval None
+  */
+void LEDC_FRAME_GetStats(LEDC_FRAME_TypeDef *fe, LEDC_FRAME_StatsTypeDef *Stats)
+{
+	u32 PrevStatus = __get_PRIMASK();
+
+	__disable_irq();
+	*Stats = fe->Stats;
+	__set_PRIMASK(PrevStatus);
+}
+
+/** @} */
+
+/** @} */
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <math.h>
+#include <zephyr/ztest.h>
+#include "ameba_soc.h"
+
+#define FS			48000
+#define PI			3.14159265358979323846
+
+/* 29 bit 4.25 register value back to double */
+static double coef_val(u32 q)
+{
+	return (double)((s32)(q << 3) >> 3) / (1 << 25);
+}
+
+/* gain in dB of the band at f, read the way the codec biquad runs it */
+static double band_db(CODEC_EQFilterCoef *c, double f)
+{
+	double w = 2 * PI * f / FS;
+	double a1 = coef_val(c->A1_Q), a2 = coef_val(c->A2_Q);
+	double nr, ni, dr, di;
+
+#if defined(CONFIG_AMEBA_CODEC_EQ_FEEDBACK_ADD)
+	a1 = -a1;
+	a2 = -a2;
+#endif
+
+	nr = coef_val(c->H0_Q) + coef_val(c->B1_Q) * cos(w) + coef_val(c->B2_Q) * cos(2 * w);
+	ni = -coef_val(c->B1_Q) * sin(w) - coef_val(c->B2_Q) * sin(2 * w);
+	dr = 1 + a1 * cos(w) + a2 * cos(2 * w);
+	di = -a1 * sin(w) - a2 * sin(2 * w);
+
+	return 10 * log10((nr * nr + ni * ni) / (dr * dr + di * di));
+}
+
+static void check_band(u32 Type, u32 Fc, float Q, float GainDb, double f, double db)
+{
+	CODEC_EQBandParam p = {.Type = Type, .Fc = Fc, .Q = Q, .GainDb = GainDb};
+	CODEC_EQFilterCoef c;
+	double got;
+
+	zassert_equal(AUDIO_CODEC_EQDesign(&p, FS, &c), RTK_SUCCESS, "type %u not designed", Type);
+
+	got = band_db(&c, f);
+	zassert_true(fabs(got - db) < 0.05, "type %u at %u Hz: %d mdB, expected %d mdB", Type, (u32)f,
+				 (int)(got * 1000), (int)(db * 1000));
+}
+
+ZTEST(codec_eq, test_pass_types)
+{
+	check_band(CODEC_EQ_LOWPASS, 1000, 0.7071f, 0, 0, 0);
+	check_band(CODEC_EQ_LOWPASS, 1000, 0.7071f, 0, 1000, -3.01);
+	check_band(CODEC_EQ_HIGHPASS, 1000, 0.7071f, 0, FS / 2, 0);
+	check_band(CODEC_EQ_HIGHPASS, 1000, 0.7071f, 0, 1000, -3.01);
+	check_band(CODEC_EQ_BANDPASS, 2000, 1.0f, 0, 2000, 0);
+}
+
+ZTEST(codec_eq, test_gain_types)
+{
+	check_band(CODEC_EQ_PEAK, 3000, 1.0f, 6.0f, 3000, 6.0);
+	check_band(CODEC_EQ_PEAK, 3000, 1.0f, -9.0f, 3000, -9.0);
+	check_band(CODEC_EQ_LOWSHELF, 200, 0.7071f, 6.0f, 0, 6.0);
+	check_band(CODEC_EQ_HIGHSHELF, 8000, 0.7071f, -6.0f, FS / 2, -6.0);
+}
+
+ZTEST(codec_eq, test_notch)
+{
+	CODEC_EQBandParam p = {.Type = CODEC_EQ_NOTCH, .Fc = 1000, .Q = 2.0f};
+	CODEC_EQFilterCoef c;
+
+	zassert_equal(AUDIO_CODEC_EQDesign(&p, FS, &c), RTK_SUCCESS, NULL);
+	zassert_true(band_db(&c, 1000) < -40, "notch not deep enough");
+	zassert_true(fabs(band_db(&c, 0)) < 0.05, "notch changes DC");
+}
+
+ZTEST(codec_eq, test_invalid)
+{
+	CODEC_EQBandParam p = {.Type = CODEC_EQ_LOWPASS, .Fc = FS / 2, .Q = 0.7071f};
+	CODEC_EQFilterCoef c;
+
+	zassert_equal(AUDIO_CODEC_EQDesign(&p, FS, &c), RTK_ERR_BADARG, "fc at Nyquist accepted");
+	p.Fc = 1000;
+	p.Q = 0;
+	zassert_equal(AUDIO_CODEC_EQDesign(&p, FS, &c), RTK_ERR_BADARG, "Q 0 accepted");
+}
+
+ZTEST_SUITE(codec_eq, NULL, NULL, NULL, NULL, NULL);
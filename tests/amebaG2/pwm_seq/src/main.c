@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include "ameba_soc.h"
+
+#define FADE_LEN	5
+
+static u16 tbl[FADE_LEN * 2];
+
+static void check_fade(u16 From, u16 To, float Gamma)
+{
+	u32 i;
+
+	PWM_SEQ_TableFade(tbl, FADE_LEN, 2, From, To, Gamma);
+
+	zassert_equal(tbl[0], From, "first step %u, expected %u", tbl[0], From);
+	zassert_equal(tbl[(FADE_LEN - 1) * 2], To, "last step %u, expected %u", tbl[(FADE_LEN - 1) * 2], To);
+
+	for (i = 1; i < FADE_LEN; i++) {
+		if (From < To) {
+			zassert_true(tbl[i * 2] >= tbl[(i - 1) * 2], "step %u goes down", i);
+		} else {
+			zassert_true(tbl[i * 2] <= tbl[(i - 1) * 2], "step %u goes up", i);
+		}
+	}
+}
+
+ZTEST(pwm_seq_table, test_fade_rising)
+{
+	check_fade(0, 1000, 1.0f);
+	check_fade(10, 4000, 2.2f);
+}
+
+ZTEST(pwm_seq_table, test_fade_falling)
+{
+	check_fade(1000, 0, 1.0f);
+	check_fade(4000, 10, 2.2f);
+}
+
+/* exact steps of a linear fade shall not be rounded off by one */
+ZTEST(pwm_seq_table, test_fade_linear_steps)
+{
+	static const u16 up[FADE_LEN] = {0, 250, 500, 750, 1000};
+	u32 i;
+
+	PWM_SEQ_TableFade(tbl, FADE_LEN, 1, 0, 1000, 1.0f);
+	for (i = 0; i < FADE_LEN; i++) {
+		zassert_equal(tbl[i], up[i], "rising step %u is %u", i, tbl[i]);
+	}
+
+	PWM_SEQ_TableFade(tbl, FADE_LEN, 1, 1000, 0, 1.0f);
+	for (i = 0; i < FADE_LEN; i++) {
+		zassert_equal(tbl[i], up[FADE_LEN - 1 - i], "falling step %u is %u", i, tbl[i]);
+	}
+}
+
+ZTEST_SUITE(pwm_seq_table, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+#include "ameba_soc.h"
+
+#define FIFO_DEPTH			16
+#define KEY(r, c, press)		(((r) << 4) | (c) | ((press) ? BIT_KS_PRESS_EVENT : 0))
+
+static u32 tick;
+static u32 fifo[FIFO_DEPTH];
+static u32 fifo_num;
+
+u32 fake_tick_get(void)
+{
+	return tick;
+}
+
+u32 fake_get_int(KEYSCAN_TypeDef *KeyScan)
+{
+	UNUSED(KeyScan);
+	return fifo_num ? BIT_KS_SCAN_EVENT_INT_STATUS : 0;
+}
+
+void fake_clear_int(KEYSCAN_TypeDef *KeyScan, u32 KeyScan_IT)
+{
+	UNUSED(KeyScan);
+	UNUSED(KeyScan_IT);
+}
+
+void fake_int_config(KEYSCAN_TypeDef *KeyScan, uint32_t KeyScan_IT, u8 newState)
+{
+	UNUSED(KeyScan);
+	UNUSED(KeyScan_IT);
+	UNUSED(newState);
+}
+
+u8 fake_get_data_num(KEYSCAN_TypeDef *KeyScan)
+{
+	UNUSED(KeyScan);
+	return fifo_num;
+}
+
+void fake_clear_fifo(KEYSCAN_TypeDef *KeyScan)
+{
+	UNUSED(KeyScan);
+	fifo_num = 0;
+}
+
+void fake_read(KEYSCAN_TypeDef *KeyScan, u32 *outBuf, u8 count)
+{
+	UNUSED(KeyScan);
+	memcpy(outBuf, fifo, count * sizeof(u32));
+	memmove(fifo, fifo + count, (fifo_num - count) * sizeof(u32));
+	fifo_num -= count;
+}
+
+static KeyScan_EngTypeDef eng;
+static KeyScan_EventTypeDef evt_buf[16];
+
+static void eng_setup(u32 Mode)
+{
+	KeyScan_EngInitTypeDef init;
+
+	tick = 1000;
+	fifo_num = 0;
+
+	KeyScan_EngStructInit(&init);
+	init.KS_EngProf[0].Mode = Mode;
+	init.KS_EngEvtBuf = evt_buf;
+	init.KS_EngEvtNum = ARRAY_SIZE(evt_buf);
+	zassert_equal(KeyScan_EngInit(&eng, &init), RTK_SUCCESS, NULL);
+}
+
+/* one interrupt draining a press and a release of key (1, 2) */
+static void tap_in_one_batch(void)
+{
+	fifo[0] = KEY(1, 2, 1);
+	fifo[1] = KEY(1, 2, 0);
+	fifo_num = 2;
+	KeyScan_EngIRQHandler(&eng);
+}
+
+static void expect_event(u32 Press)
+{
+	KeyScan_EventTypeDef evt;
+
+	zassert_true(KeyScan_EngGetEvent(&eng, &evt), "no %s event", Press ? "press" : "release");
+	zassert_equal(evt.Row, 1, NULL);
+	zassert_equal(evt.Col, 2, NULL);
+	zassert_equal(evt.Press, Press, NULL);
+}
+
+static void expect_no_event(void)
+{
+	KeyScan_EventTypeDef evt;
+
+	zassert_false(KeyScan_EngGetEvent(&eng, &evt), "unexpected event");
+}
+
+ZTEST(keyscan_eng, test_tap_no_debounce)
+{
+	eng_setup(KS_ENG_DEB_NONE);
+	tap_in_one_batch();
+
+	expect_event(1);
+	expect_event(0);
+	expect_no_event();
+}
+
+ZTEST(keyscan_eng, test_tap_eager_release_after_lockout)
+{
+	eng_setup(KS_ENG_DEB_EAGER);
+	tap_in_one_batch();
+
+	/* the release is in the lockout of the press */
+	expect_event(1);
+	expect_no_event();
+	zassert_equal(eng.Stats.Bounces, 1, NULL);
+
+	tick += eng.DebTicks[0] - 1;
+	KeyScan_EngPoll(&eng);
+	expect_no_event();
+
+	tick++;
+	KeyScan_EngPoll(&eng);
+	expect_event(0);
+	expect_no_event();
+}
+
+ZTEST(keyscan_eng, test_release_eager_outside_lockout)
+{
+	eng_setup(KS_ENG_DEB_EAGER);
+
+	fifo[0] = KEY(1, 2, 1);
+	fifo_num = 1;
+	KeyScan_EngIRQHandler(&eng);
+	expect_event(1);
+
+	tick += eng.DebTicks[0];
+	fifo[0] = KEY(1, 2, 0);
+	fifo_num = 1;
+	KeyScan_EngIRQHandler(&eng);
+	expect_event(0);
+	expect_no_event();
+}
+
+ZTEST_SUITE(keyscan_eng, NULL, NULL, NULL, NULL, NULL);